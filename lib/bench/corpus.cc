@@ -0,0 +1,187 @@
+#include "corpus.hpp"
+
+#include <cctype>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hocon { namespace bench {
+
+    /** Each generator appends top-level entries until the text reaches the target size. */
+
+    static string flat_wide(size_t target_size) {
+        string text;
+        text.reserve(target_size + 128);
+        for (size_t i = 0; text.size() < target_size; ++i) {
+            auto n = to_string(i);
+            text += "key_" + n + " = \"value number " + n + "\"\n";
+            text += "flag_" + n + " = " + (i % 2 ? "true" : "false") + "\n";
+            text += "name_" + n + " = unquoted text " + n + "\n";
+        }
+        return text;
+    }
+
+    static string deep_nesting(size_t target_size) {
+        static const int depth = 64;
+        string text;
+        text.reserve(target_size + 4096);
+        for (size_t i = 0; text.size() < target_size; ++i) {
+            text += "tree_" + to_string(i) + " ";
+            for (int level = 0; level < depth; ++level) {
+                text += "{\n" + string(level * 2 + 2, ' ') + "level_" + to_string(level) + " ";
+            }
+            text += "{ leaf = " + to_string(i) + " }\n";
+            for (int level = depth; level > 0; --level) {
+                text += string(level * 2, ' ') + "}\n";
+            }
+        }
+        return text;
+    }
+
+    static string large_arrays(size_t target_size) {
+        string text;
+        text.reserve(target_size + 8192);
+        for (size_t i = 0; text.size() < target_size; ++i) {
+            text += "strings_" + to_string(i) + " = [";
+            for (int element = 0; element < 256; ++element) {
+                text += (element ? ", \"item " : "\"item ") + to_string(element) + "\"";
+            }
+            text += "]\nobjects_" + to_string(i) + " = [\n";
+            for (int element = 0; element < 32; ++element) {
+                text += "  { id = " + to_string(element) + ", enabled = true }\n";
+            }
+            text += "]\n";
+        }
+        return text;
+    }
+
+    static string numbers(size_t target_size) {
+        // Port maps and numeric arrays, where number parsing dominates
+        string text;
+        text.reserve(target_size + 8192);
+        for (size_t i = 0; text.size() < target_size; ++i) {
+            auto n = to_string(i);
+            text += "ports_" + n + " {\n";
+            for (int port = 0; port < 32; ++port) {
+                text += "  service_" + to_string(port) + " = " + to_string(8000 + port + i % 1000) + "\n";
+            }
+            text += "}\nsamples_" + n + " = [";
+            for (int sample = 0; sample < 128; ++sample) {
+                text += (sample ? ", " : "") + to_string(sample) + "." + to_string((sample * 37 + i) % 1000);
+            }
+            text += "]\nlimits_" + n + " = [-1, 0, 1e3, 2.5E-4, 9223372036854775807, 12345678901234567890]\n";
+        }
+        return text;
+    }
+
+    static string heavy_comments(size_t target_size) {
+        string text;
+        text.reserve(target_size + 512);
+        for (size_t i = 0; text.size() < target_size; ++i) {
+            auto n = to_string(i);
+            text += "# Setting " + n + " controls something important.\n";
+            text += "# It has a long explanation that spans several lines, like real\n";
+            text += "# hand-maintained configuration files tend to have.\n";
+            text += "// Slash comments are allowed too.\n";
+            text += "setting_" + n + " = " + n + "  # trailing comment\n\n";
+        }
+        return text;
+    }
+
+    static string dotted_keys(size_t target_size) {
+        string text;
+        text.reserve(target_size + 256);
+        for (size_t i = 0; text.size() < target_size; ++i) {
+            auto n = to_string(i);
+            auto group = to_string(i % 64);
+            text += "app.service_" + group + ".instance_" + n + ".host = \"host-" + n + ".example.com\"\n";
+            text += "app.service_" + group + ".instance_" + n + ".port = " + to_string(1024 + i % 60000) + "\n";
+            text += "app.service_" + group + ".instance_" + n + ".tags = [a, b, c]\n";
+        }
+        return text;
+    }
+
+    static string triple_quoted(size_t target_size) {
+        static const string paragraph =
+            "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor\n"
+            "incididunt ut labore et dolore magna aliqua. \"Quotes\" and \\backslashes\\ are\n"
+            "kept as they are inside triple-quoted strings.\n";
+        string text;
+        text.reserve(target_size + 64 * paragraph.size());
+        for (size_t i = 0; text.size() < target_size; ++i) {
+            text += "text_" + to_string(i) + " = \"\"\"";
+            for (int line = 0; line < 64; ++line) {
+                text += paragraph;
+            }
+            text += "\"\"\"\n";
+        }
+        return text;
+    }
+
+    static string json_records(size_t target_size) {
+        // Machine-generated inventory style JSON
+        string text;
+        text.reserve(target_size + 512);
+        text += "{\n  \"records\": [\n";
+        for (size_t i = 0; text.size() < target_size; ++i) {
+            auto n = to_string(i);
+            text += i ? ",\n" : "";
+            text += "    {\"id\": " + n + ", \"name\": \"node-" + n + "\", \"active\": " +
+                    (i % 3 ? "true" : "false") + ", \"load\": " + to_string(i % 100) + ".25, " +
+                    "\"tags\": [\"rack-" + to_string(i % 40) + "\", \"zone-" + to_string(i % 4) + "\"], " +
+                    "\"owner\": null}";
+        }
+        text += "\n  ]\n}\n";
+        return text;
+    }
+
+    vector<corpus> const& corpora() {
+        static const vector<corpus> all {
+            { "flat_wide", "one object with many short fields", config_syntax::CONF, flat_wide },
+            { "deep_nesting", "objects nested 64 levels deep", config_syntax::CONF, deep_nesting },
+            { "large_arrays", "arrays of strings and small objects", config_syntax::CONF, large_arrays },
+            { "numbers", "port maps and numeric arrays", config_syntax::CONF, numbers },
+            { "heavy_comments", "mostly comment lines", config_syntax::CONF, heavy_comments },
+            { "dotted_keys", "fields set through long dotted paths", config_syntax::CONF, dotted_keys },
+            { "triple_quoted", "large multi-line triple-quoted strings", config_syntax::CONF, triple_quoted },
+            { "json_records", "a large strict JSON array of records", config_syntax::JSON, json_records },
+        };
+        return all;
+    }
+
+    size_t parse_size(string const& text) {
+        size_t digits = 0;
+        while (digits < text.size() && isdigit(static_cast<unsigned char>(text[digits]))) {
+            ++digits;
+        }
+        if (digits == 0) {
+            throw invalid_argument("invalid size: " + text);
+        }
+
+        size_t value = stoull(text.substr(0, digits));
+        string unit = text.substr(digits);
+        for (auto& c : unit) {
+            c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+        }
+        if (unit.empty() || unit == "B") {
+            return value;
+        } else if (unit == "K" || unit == "KB") {
+            return value * 1024;
+        } else if (unit == "M" || unit == "MB") {
+            return value * 1024 * 1024;
+        } else if (unit == "G" || unit == "GB") {
+            return value * 1024 * 1024 * 1024;
+        }
+        throw invalid_argument("invalid size: " + text);
+    }
+
+    string format_size(size_t bytes) {
+        if (bytes >= 1024 * 1024 && bytes % (1024 * 1024) == 0) {
+            return to_string(bytes / (1024 * 1024)) + "M";
+        } else if (bytes >= 1024 && bytes % 1024 == 0) {
+            return to_string(bytes / 1024) + "K";
+        }
+        return to_string(bytes);
+    }
+
+}}  // namespace hocon::bench
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <hocon/config_syntax.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace hocon { namespace bench {
+
+    /** A synthetic input shape, generated deterministically at any size. */
+    struct corpus {
+        std::string name;
+        std::string description;
+        config_syntax syntax;
+
+        /** Generates at least target_size bytes, stopping at the end of a top-level entry. */
+        std::string (*generate)(size_t target_size);
+    };
+
+    /** All corpora, in the order they are reported. */
+    std::vector<corpus> const& corpora();
+
+    /** Parses sizes such as "512", "64K", "1M" or "100MB"; throws std::invalid_argument otherwise. */
+    size_t parse_size(std::string const& text);
+
+    /** Formats a byte count with the largest whole unit, e.g. "64K" or "100M". */
+    std::string format_size(size_t bytes);
+
+}}  // namespace hocon::bench
@@ -0,0 +1,453 @@
+#include "corpus.hpp"
+
+#include <hocon/config.hpp>
+#include <hocon/parser/config_document_factory.hpp>
+#include <internal/config_util.hpp>
+#include <internal/simple_config_origin.hpp>
+#include <internal/tokenizer.hpp>
+#include <internal/tokens.hpp>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+using namespace std;
+using namespace hocon;
+using namespace hocon::bench;
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+/**
+ * Resets the peak resident set size, where the platform allows it, so each
+ * measurement reports its own peak rather than the process's. Memory freed by
+ * earlier measurements is first given back, so it doesn't hide what the next
+ * one uses.
+ */
+static void reset_peak_rss() {
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+#ifdef __linux__
+    ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+#endif
+}
+
+/** Peak resident set size in KiB, or 0 where it can't be read. */
+static size_t peak_rss_kb() {
+#ifdef __linux__
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (boost::starts_with(line, "VmHWM:")) {
+            return stoull(line.substr(6));
+        }
+    }
+#endif
+#if defined(__APPLE__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024;  // bytes on macOS
+#elif defined(__unix__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+#else
+    return 0;
+#endif
+}
+
+static size_t count_tokens(string const& text, config_syntax syntax) {
+    auto origin = make_shared<simple_config_origin>("bench");
+    token_iterator tokens(origin, make_shared<input_buffer>(text.data(), text.data() + text.size()), syntax);
+    size_t count = 0;
+    while (tokens.has_next()) {
+        tokens.next();
+        ++count;
+    }
+    return count;
+}
+
+struct measurement {
+    size_t iterations;
+    double seconds;
+
+    /**
+     * How far the peak resident set size rose above what was resident when the
+     * measurement started, so the corpus text held for the run isn't counted.
+     */
+    size_t parse_peak_kb;
+};
+
+/** Runs parse until min_seconds have passed, at least once. */
+static measurement measure(function<void()> const& parse, double min_seconds) {
+    using clock = chrono::steady_clock;
+
+    reset_peak_rss();
+    size_t baseline_kb = peak_rss_kb();
+    measurement result { 0, 0.0, 0 };
+    auto start = clock::now();
+    do {
+        parse();
+        ++result.iterations;
+        result.seconds = chrono::duration<double>(clock::now() - start).count();
+    } while (result.seconds < min_seconds);
+    size_t peak_kb = peak_rss_kb();
+    result.parse_peak_kb = peak_kb > baseline_kb ? peak_kb - baseline_kb : 0;
+    return result;
+}
+
+/** A scratch directory, removed with everything in it however the run ends. */
+struct scratch_directory {
+    scratch_directory() : path(fs::temp_directory_path() / fs::unique_path("cpp-hocon-bench-%%%%-%%%%")) {
+        fs::create_directories(path);
+    }
+
+    ~scratch_directory() {
+        boost::system::error_code ignored;
+        fs::remove_all(path, ignored);
+    }
+
+    scratch_directory(scratch_directory const&) = delete;
+    scratch_directory& operator=(scratch_directory const&) = delete;
+
+    fs::path const path;
+};
+
+/**
+ * Times the getters over every leaf path of one parsed input: walking the tree from
+ * a path expression or a compiled path, the same through config::freeze's index, and
+ * building the index itself. Reports time per lookup, or per freeze.
+ */
+static bool run_lookups(corpus const& c, size_t size, string const& text, config_parse_options const& parse_options,
+                        function<bool(string const&)> const& want_api, double min_seconds, bool csv) {
+    shared_config conf;
+    try {
+        conf = config::parse_string(text, parse_options)->resolve();
+    } catch (exception const& e) {
+        cerr << c.name << " " << format_size(size) << " failed to load: " << e.what() << endl;
+        return false;
+    }
+
+    vector<string> expressions;
+    vector<compiled_path> compiled;
+    for (auto const& entry : conf->entry_set()) {
+        expressions.push_back(entry.first);
+        compiled.push_back(config::compile_path(entry.first));
+    }
+    auto frozen = conf->freeze();
+
+    vector<pair<string, function<size_t()>>> apis {
+        { "tree", [&]() { for (auto const& e : expressions) conf->get_value(e); return expressions.size(); } },
+        { "tree_compiled", [&]() { for (auto const& p : compiled) conf->get_value(p); return compiled.size(); } },
+        { "frozen", [&]() { for (auto const& e : expressions) frozen->get_value(e); return expressions.size(); } },
+        { "frozen_compiled", [&]() { for (auto const& p : compiled) frozen->get_value(p); return compiled.size(); } },
+        { "freeze", [&]() { conf->freeze(); return size_t(1); } },
+    };
+
+    bool ok = true;
+    for (auto const& api : apis) {
+        if (!want_api(api.first)) {
+            continue;
+        }
+
+        size_t operations = 0;
+        measurement m;
+        try {
+            m = measure([&]() { operations += api.second(); }, min_seconds);
+        } catch (exception const& e) {
+            cerr << c.name << " " << format_size(size) << " " << api.first << " failed: " << e.what() << endl;
+            ok = false;
+            continue;
+        }
+
+        double ns_per_op = operations ? m.seconds * 1e9 / operations : 0.0;
+        double ops_per_s = m.seconds > 0 ? operations / m.seconds : 0.0;
+        if (csv) {
+            cout << c.name << "," << text.size() << "," << api.first << "," << m.iterations << ","
+                 << m.seconds << "," << expressions.size() << "," << ns_per_op << "," << ops_per_s << endl;
+        } else {
+            printf("%-16s %8s %-15s %6zu %8zu %10.1f %14.0f\n",
+                   c.name.c_str(), format_size(size).c_str(), api.first.c_str(), m.iterations,
+                   expressions.size(), ns_per_op, ops_per_s);
+            fflush(stdout);
+        }
+    }
+    return ok;
+}
+
+/**
+ * Times the number conversions the tokenizer uses, parse_int64 and parse_double,
+ * against the boost::lexical_cast calls they replaced, over the text of every number
+ * in one input. Whole numbers go to the integer conversions and the rest to the
+ * double ones, as in the tokenizer. Reports time per number.
+ */
+static bool run_numbers(corpus const& c, size_t size, string const& text,
+                        function<bool(string const&)> const& want_api, double min_seconds, bool csv) {
+    vector<string> integers, decimals;
+    auto origin = make_shared<simple_config_origin>("bench");
+    token_iterator tokens(origin, make_shared<input_buffer>(text.data(), text.data() + text.size()), c.syntax);
+    while (tokens.has_next()) {
+        auto t = tokens.next();
+        if (t->get_token_type() != token_type::VALUE ||
+            tokens::get_value(t)->value_type() != config_value::type::NUMBER) {
+            continue;
+        }
+        auto number_text = t->token_text();
+        if (number_text.find_first_of(".eE") == string::npos) {
+            integers.push_back(move(number_text));
+        } else {
+            decimals.push_back(move(number_text));
+        }
+    }
+
+    // Results are summed into a volatile so the conversions can't be optimized away
+    volatile double sink = 0;
+    vector<tuple<string, vector<string> const*, function<void(string const&)>>> apis {
+        make_tuple("parse_int64", &integers, [&](string const& s) {
+            int64_t n = 0;
+            parse_int64(s, n);
+            sink = sink + n;
+        }),
+        make_tuple("lexical_int64", &integers, [&](string const& s) {
+            try {
+                sink = sink + boost::lexical_cast<int64_t>(s);
+            } catch (boost::bad_lexical_cast const&) {
+            }
+        }),
+        make_tuple("parse_double", &decimals, [&](string const& s) {
+            double d = 0;
+            parse_double(s, d);
+            sink = sink + d;
+        }),
+        make_tuple("lexical_double", &decimals, [&](string const& s) {
+            try {
+                sink = sink + boost::lexical_cast<double>(s);
+            } catch (boost::bad_lexical_cast const&) {
+            }
+        }),
+    };
+
+    bool ok = true;
+    for (auto const& api : apis) {
+        auto const& name = get<0>(api);
+        auto const& numbers = *get<1>(api);
+        auto const& convert = get<2>(api);
+        if (!want_api(name) || numbers.empty()) {
+            continue;
+        }
+
+        measurement m;
+        try {
+            m = measure([&]() { for (auto const& s : numbers) convert(s); }, min_seconds);
+        } catch (exception const& e) {
+            cerr << c.name << " " << format_size(size) << " " << name << " failed: " << e.what() << endl;
+            ok = false;
+            continue;
+        }
+
+        size_t operations = numbers.size() * m.iterations;
+        double ns_per_op = m.seconds * 1e9 / operations;
+        double ops_per_s = m.seconds > 0 ? operations / m.seconds : 0.0;
+        if (csv) {
+            cout << c.name << "," << text.size() << "," << name << "," << m.iterations << ","
+                 << m.seconds << "," << numbers.size() << "," << ns_per_op << "," << ops_per_s << endl;
+        } else {
+            printf("%-16s %8s %-15s %6zu %8zu %10.1f %14.0f\n",
+                   c.name.c_str(), format_size(size).c_str(), name.c_str(), m.iterations,
+                   numbers.size(), ns_per_op, ops_per_s);
+            fflush(stdout);
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    vector<string> corpus_names;
+    vector<string> api_names;
+    string sizes_text;
+    double min_seconds;
+    bool csv = false;
+    bool lookups = false;
+    bool numbers = false;
+
+    po::options_description options("Parse benchmarks for cpp-hocon over generated inputs.\n\nOptions");
+    options.add_options()
+        ("help,h", "show this help")
+        ("list", "list the available corpora and exit")
+        ("corpus,c", po::value<vector<string>>(&corpus_names)->composing(),
+            "corpus to run, may be repeated (default: all)")
+        ("api,a", po::value<vector<string>>(&api_names)->composing(),
+            "API to measure, may be repeated: parse_string, parse_file or document; with --lookups, "
+            "tree, tree_compiled, frozen, frozen_compiled or freeze; with --numbers, parse_int64, "
+            "lexical_int64, parse_double or lexical_double (default: all)")
+        ("sizes,s", po::value<string>(&sizes_text)->default_value("1K,1M,10M"),
+            "comma-separated input sizes, from 1K up to 100M")
+        ("min-time,t", po::value<double>(&min_seconds)->default_value(1.0),
+            "minimum seconds to spend on each measurement")
+        ("lookups", po::bool_switch(&lookups),
+            "measure getters on each resolved input, walking the tree and through config::freeze, instead of parsing")
+        ("numbers", po::bool_switch(&numbers),
+            "measure converting each input's numbers, against boost::lexical_cast, instead of parsing")
+        ("csv", po::bool_switch(&csv), "print comma-separated values");
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, options), vm);
+        po::notify(vm);
+    } catch (po::error const& e) {
+        cerr << "error: " << e.what() << "\n\n" << options << endl;
+        return EXIT_FAILURE;
+    }
+
+    if (vm.count("help")) {
+        cout << options << endl;
+        return EXIT_SUCCESS;
+    }
+    if (vm.count("list")) {
+        for (auto const& c : corpora()) {
+            cout << c.name << ": " << c.description << endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    vector<size_t> sizes;
+    try {
+        vector<string> parts;
+        boost::split(parts, sizes_text, boost::is_any_of(","), boost::token_compress_on);
+        for (auto const& part : parts) {
+            sizes.push_back(parse_size(boost::trim_copy(part)));
+        }
+    } catch (invalid_argument const& e) {
+        cerr << "error: " << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    vector<corpus> selected;
+    for (auto const& c : corpora()) {
+        if (corpus_names.empty() || find(corpus_names.begin(), corpus_names.end(), c.name) != corpus_names.end()) {
+            selected.push_back(c);
+        }
+    }
+    if (selected.empty()) {
+        cerr << "error: no corpus matched; use --list to see them" << endl;
+        return EXIT_FAILURE;
+    }
+
+    auto want_api = [&](string const& name) {
+        return api_names.empty() || find(api_names.begin(), api_names.end(), name) != api_names.end();
+    };
+
+    // parse_file reads the corpus back from a scratch directory
+    scratch_directory scratch;
+
+    if (lookups && numbers) {
+        cerr << "error: --lookups and --numbers can't be combined" << endl;
+        return EXIT_FAILURE;
+    }
+
+    if (lookups || numbers) {
+        char const* counted = lookups ? "paths" : "numbers";
+        if (csv) {
+            cout << "corpus,size_bytes,api,iterations,seconds," << counted << ",ns_per_op,ops_per_s" << endl;
+        } else {
+            printf("%-16s %8s %-15s %6s %8s %10s %14s\n", "corpus", "size", "api", "iters", counted, "ns/op", "ops/s");
+        }
+    } else if (csv) {
+        cout << "corpus,size_bytes,api,iterations,seconds,mb_per_s,tokens_per_s,parse_peak_kb" << endl;
+    } else {
+        printf("%-16s %8s %-13s %6s %10s %14s %14s\n",
+               "corpus", "size", "api", "iters", "MB/s", "tokens/s", "parse peak MB");
+    }
+
+    int status = EXIT_SUCCESS;
+    // Errors end the run here, so the scratch directory is still removed
+    try {
+        for (auto const& c : selected) {
+            for (size_t size : sizes) {
+                string text = c.generate(size);
+                if (lookups) {
+                    auto parse_options = config_parse_options().set_syntax(c.syntax);
+                    if (!run_lookups(c, size, text, parse_options, want_api, min_seconds, csv)) {
+                        status = EXIT_FAILURE;
+                    }
+                    continue;
+                }
+                if (numbers) {
+                    if (!run_numbers(c, size, text, want_api, min_seconds, csv)) {
+                        status = EXIT_FAILURE;
+                    }
+                    continue;
+                }
+
+                size_t tokens = count_tokens(text, c.syntax);
+                auto parse_options = config_parse_options().set_syntax(c.syntax);
+
+                fs::path basename = scratch.path / c.name;
+                {
+                    string file_name = basename.string() + (c.syntax == config_syntax::JSON ? ".json" : ".conf");
+                    boost::nowide::ofstream out(file_name.c_str(), ios::binary);
+                    out << text;
+                }
+
+                vector<pair<string, function<void()>>> apis {
+                    { "parse_string", [&]() { config::parse_string(text, parse_options); } },
+                    { "parse_file", [&]() { config::parse_file_any_syntax(basename.string()); } },
+                    { "document", [&]() { config_document_factory::parse_string(text, parse_options); } },
+                };
+
+                for (auto const& api : apis) {
+                    if (!want_api(api.first)) {
+                        continue;
+                    }
+
+                    measurement m;
+                    try {
+                        m = measure(api.second, min_seconds);
+                    } catch (exception const& e) {
+                        cerr << c.name << " " << format_size(size) << " " << api.first << " failed: " << e.what()
+                             << endl;
+                        status = EXIT_FAILURE;
+                        continue;
+                    }
+
+                    double mb_per_s = text.size() * m.iterations / m.seconds / (1024.0 * 1024.0);
+                    double tokens_per_s = tokens * m.iterations / m.seconds;
+                    if (csv) {
+                        cout << c.name << "," << text.size() << "," << api.first << "," << m.iterations << ","
+                             << m.seconds << "," << mb_per_s << "," << tokens_per_s << "," << m.parse_peak_kb << endl;
+                    } else {
+                        printf("%-16s %8s %-13s %6zu %10.2f %14.0f %14.1f\n",
+                               c.name.c_str(), format_size(size).c_str(), api.first.c_str(), m.iterations,
+                               mb_per_s, tokens_per_s, m.parse_peak_kb / 1024.0);
+                        fflush(stdout);
+                    }
+                }
+            }
+        }
+    } catch (exception const& e) {
+        cerr << "error: " << e.what() << endl;
+        status = EXIT_FAILURE;
+    }
+
+    return status;
+}
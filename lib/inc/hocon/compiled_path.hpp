@@ -0,0 +1,49 @@
+#pragma once
+
+#include "path.hpp"
+#include <string>
+#include "export.h"
+
+namespace hocon {
+
+    /**
+     * A path expression parsed ahead of time, for code that reads the same setting
+     * over and over. The getters on {@link config} that take a compiled_path skip
+     * parsing the expression and go straight to looking up each key in turn, using
+     * the hash each key was given when the path was compiled.
+     * <p>
+     * Create one with {@link config#compile_path}. Like a config, a compiled_path is
+     * immutable, so it can be kept for the life of the program, shared between
+     * threads and used with any config.
+     *
+     * <pre>
+     *     static const compiled_path timeout = config::compile_path("server.timeout");
+     *     int seconds = conf->get_int(timeout);
+     * </pre>
+     */
+    class LIBCPP_HOCON_EXPORT compiled_path {
+    public:
+        /**
+         * Parses a path expression, throwing a config_exception if it is invalid.
+         * @param expression the path expression
+         */
+        explicit compiled_path(std::string expression);
+
+        /**
+         * Wraps a path that is already parsed; its expression is the rendered path.
+         * @param parsed the path
+         */
+        explicit compiled_path(path parsed);
+
+        /** The expression this path was compiled from. */
+        std::string const& expression() const { return _expression; }
+
+        /** The parsed path. */
+        path const& get_path() const { return _path; }
+
+    private:
+        std::string _expression;
+        path _path;
+    };
+
+}  // namespace hocon
@@ -9,6 +9,7 @@
 #include "config_list.hpp"
 #include "config_exception.hpp"
 #include "path.hpp"
+#include "compiled_path.hpp"
 #include <vector>
 #include <string>
 #include <set>
@@ -19,6 +20,10 @@ namespace hocon {
 
     enum class time_unit { NANOSECONDS, MICROSECONDS, MILLISECONDS, SECONDS, MINUTES, HOURS, DAYS };
 
+    class frozen_index;
+    class resolve_record;
+    class lazy_resolver;
+
     /**
      * An immutable map from config paths to config values. Paths are dot-separated
      * expressions such as <code>foo.bar.baz</code>. Values are as in JSON
@@ -238,6 +243,18 @@ namespace hocon {
          */
         static shared_config parse_string(std::string s);
 
+        /**
+         * Parses a path expression once, for use with the getters that take a
+         * {@link compiled_path}. Getting a value through a compiled path does the
+         * same lookup as getting it through the expression, without parsing the
+         * expression again on every call.
+         *
+         * @param path
+         *            the path expression
+         * @return the compiled path
+         */
+        static compiled_path compile_path(std::string const& path);
+
         /**
          * Gets the {@code config} as a tree of {@link config_object}. This is a
          * constant-time operation (it is not proportional to the number of values
@@ -332,6 +349,11 @@ namespace hocon {
          * resolved depending on whether there were substitutions present in the
          * file.
          *
+         * <p>
+         * A lazily resolved config (see config_resolve_options#set_lazy) counts as
+         * resolved only once something has resolved the whole of it, like
+         * {@link #root}. Checking doesn't resolve anything, so it never throws.
+         *
          * @return true if there are no unresolved substitutions remaining in this
          *         configuration.
          */
@@ -372,6 +394,69 @@ namespace hocon {
          */
         virtual shared_config resolve_with(shared_config source, config_resolve_options options) const;
 
+        /**
+         * Resolves this config, reusing the work of the incremental resolve that
+         * returned previous (see {@link config_resolve_options#set_incremental}).
+         * This config would usually be the config previous was resolved from, edited
+         * with {@link #with_value}, {@link #with_fallback}, {@link #without_path} and
+         * the like. Only the substitutions those edits could affect, directly or
+         * through other substitutions, are resolved again, so applying a small
+         * override to a large config is cheap. The result is the same as a full
+         * resolve with previous's options, and is itself incremental, so it can be
+         * the previous config of the next edit.
+         *
+         * <p>
+         * If previous wasn't returned by an incremental resolve, this config is
+         * resolved in full with default options, keeping the record for next time.
+         *
+         * @param previous
+         *            the result of an earlier incremental resolve
+         * @return the resolved <code>config</code>
+         */
+        virtual shared_config resolve_incrementally(shared_config previous) const;
+
+        /**
+         * Returns a copy of this resolved config with an index from every path in it
+         * to its value, for configs that are read many times after they are loaded.
+         * The getters, {@link #has_path} and {@link #get_is_null} on the frozen copy
+         * look the full path up in one step instead of walking one object per path
+         * element, and don't parse path expressions that are already indexed.
+         * Results and exceptions are the same as before freezing.
+         *
+         * <p>
+         * Building the index visits every value once, and the index holds every
+         * path and its rendered expression. Configs derived from a frozen config,
+         * for example by {@link #with_value} or {@link #get_config}, are not frozen.
+         *
+         * @return the frozen config
+         * @throws config_exception if the config is not resolved
+         */
+        virtual shared_config freeze() const;
+
+        /**
+         * Returns whether this config was returned by {@link #freeze}.
+         *
+         * @return true if lookups use the frozen index
+         */
+        virtual bool is_frozen() const;
+
+        /**
+         * Returns a copy of this resolved config in which values that compare equal,
+         * like a block of defaults repeated under several keys, are one shared value.
+         * That saves the memory of the repeats, and comparing shared parts with
+         * operator== takes no time.
+         *
+         * <p>
+         * A shared value keeps the origin of one of the places it appears, so
+         * messages about it may name any of them. Values are only shared when
+         * they're written alike, so numbers like 1 and 1.0 stay apart and every
+         * getter returns what it did before. The copy is not frozen.
+         *
+         * @return the deduplicated config
+         * @throws config_exception if the config is not resolved
+         */
+        virtual shared_config deduplicated() const;
+
         /**
          * Validates this config against a reference config, throwing an exception
          * if it is invalid. The purpose of this method is to "fail early" with a
@@ -464,12 +549,21 @@ namespace hocon {
          * Note that path expressions have a syntax and sometimes require quoting
          * (see {@link config_util#join_path} and {@link config_util#split_path}).
          *
+         * <p>
+         * On a lazily resolved config (see config_resolve_options#set_lazy), the
+         * value at the path is resolved first, like the getters do, so this throws
+         * what resolving it throws, for example for a substitution that can't be
+         * resolved.
+         *
          * @param path
          *            the path expression
          * @return true if a non-null value is present at the path
          */
         virtual bool has_path(std::string const& path) const;
 
+        /** Like {@link #has_path(string)}, with a path parsed ahead of time. */
+        virtual bool has_path(compiled_path const& path) const;
+
         /**
          * Checks whether a value is present at the given path, even
          * if the value is null. Most of the getters on
@@ -509,6 +603,9 @@ namespace hocon {
          */
         virtual bool has_path_or_null(std::string const& path) const;
 
+        /** Like {@link #has_path_or_null(string)}, with a path parsed ahead of time. */
+        virtual bool has_path_or_null(compiled_path const& path) const;
+
         /**
          * Returns true if the {@code config}'s root object contains no key-value
          * pairs.
@@ -574,18 +671,30 @@ namespace hocon {
         virtual unwrapped_value get_any_ref(std::string const& path) const;
         virtual std::shared_ptr<const config_value> get_value(std::string const& path) const;
 
+        /*
+         * Each getter also takes a compiled_path in place of the path expression;
+         * the result, and any exception thrown, is the same as for the expression
+         * it was compiled from.
+         */
+        virtual bool get_is_null(compiled_path const& path) const;
+        virtual bool get_bool(compiled_path const& path) const;
+        virtual int get_int(compiled_path const& path) const;
+        virtual int64_t get_long(compiled_path const& path) const;
+        virtual double get_double(compiled_path const& path) const;
+        virtual std::string get_string(compiled_path const& path) const;
+        virtual std::shared_ptr<const config_object> get_object(compiled_path const& path) const;
+        virtual shared_config get_config(compiled_path const& path) const;
+        virtual unwrapped_value get_any_ref(compiled_path const& path) const;
+        virtual std::shared_ptr<const config_value> get_value(compiled_path const& path) const;
+
         template<typename T>
         std::vector<T> get_homogeneous_unwrapped_list(std::string const& path) const {
-            auto list = boost::get<std::vector<unwrapped_value>>(get_list(path)->unwrapped());
-            std::vector<T> T_list;
-            for (auto item : list) {
-                try {
-                    T_list.push_back(boost::get<T>(item));
-                } catch (boost::bad_get &ex) {
-                    throw config_exception(leatherman::locale::format("The list did not contain only the desired type."));
-                }
-            }
-            return T_list;
+            return get_homogeneous_unwrapped_list<T>(compiled(path));
+        }
+
+        template<typename T>
+        std::vector<T> get_homogeneous_unwrapped_list(compiled_path const& path) const {
+            return unwrapped_list<T>(get_list(path));
         }
 
         virtual shared_list get_list(std::string const& path) const;
@@ -597,6 +706,15 @@ namespace hocon {
         virtual std::vector<shared_object> get_object_list(std::string const& path) const;
         virtual std::vector<shared_config> get_config_list(std::string const& path) const;
 
+        virtual shared_list get_list(compiled_path const& path) const;
+        virtual std::vector<bool> get_bool_list(compiled_path const& path) const;
+        virtual std::vector<int> get_int_list(compiled_path const& path) const;
+        virtual std::vector<int64_t> get_long_list(compiled_path const& path) const;
+        virtual std::vector<double> get_double_list(compiled_path const& path) const;
+        virtual std::vector<std::string> get_string_list(compiled_path const& path) const;
+        virtual std::vector<shared_object> get_object_list(compiled_path const& path) const;
+        virtual std::vector<shared_config> get_config_list(compiled_path const& path) const;
+
         // TODO: memory parsing
 
         /**
@@ -609,6 +727,9 @@ namespace hocon {
          */
         virtual int64_t get_duration(std::string const& path, time_unit unit) const;
 
+        /** Like {@link #get_duration(string, time_unit)}, with a path parsed ahead of time. */
+        virtual int64_t get_duration(compiled_path const& path, time_unit unit) const;
+
         /**
          * Clone the config with only the given path (and its children) retained;
          * all sibling paths are removed.
@@ -676,6 +797,11 @@ namespace hocon {
          */
         virtual shared_config with_value(std::string const& path, std::shared_ptr<const config_value> value) const;
 
+        /**
+         * Whether the two configs hold equal values, ignoring origins. Values compare
+         * their hashes first (see config_value#hash_code), so configs that differ are
+         * usually told apart without walking them.
+         */
         bool operator==(config const& other) const;
 
         config(shared_object object);
@@ -684,7 +810,7 @@ namespace hocon {
 
     protected:
         shared_value find(std::string const& path_expression, config_value::type expected) const;
-        shared_value find(path path_expression, config_value::type expected, path original_path) const;
+        shared_value find(path const& path_expression, config_value::type expected, path const& original_path) const;
         shared_value find(path path_expression, config_value::type expected) const;
         shared_config at_key(shared_origin origin, std::string const& key) const;
 
@@ -693,6 +819,13 @@ namespace hocon {
         // TODO: memory and duration parsing
 
     private:
+        config(shared_object object, std::shared_ptr<const frozen_index> index);
+        config(shared_object object, std::shared_ptr<const resolve_record> record);
+        config(shared_object object, std::shared_ptr<const lazy_resolver> lazy);
+
+        /** Compiles a path expression, skipping the parse if the frozen index has it. */
+        compiled_path compiled(std::string const& path_expression) const;
+
         /**
          * Parses a duration string. If no units are specified in the string, it is assumed to be in
          * milliseconds.
@@ -708,27 +841,51 @@ namespace hocon {
         static duration convert(int64_t number, time_unit units);
         static duration convert(double number, time_unit units);
         static time_unit get_units(std::string const& unit_string);
-        duration get_duration(std::string const& path) const;
+        duration get_duration(compiled_path const& path) const;
+
+        shared_value has_path_peek(compiled_path const& path) const;
 
-        shared_value has_path_peek(std::string const& path_expression) const;
+        /** The unwrapped elements of a list, which must all be of type T. */
+        template<typename T>
+        static std::vector<T> unwrapped_list(shared_list const& list) {
+            auto values = boost::get<std::vector<unwrapped_value>>(list->unwrapped());
+            std::vector<T> T_list;
+            for (auto item : values) {
+                try {
+                    T_list.push_back(boost::get<T>(item));
+                } catch (boost::bad_get &ex) {
+                    throw config_exception(leatherman::locale::format("The list did not contain only the desired type."));
+                }
+            }
+            return T_list;
+        }
         shared_value peek_path(path desired_path) const;
 
         static void find_paths(std::set<std::pair<std::string, std::shared_ptr<const config_value>>>& entries,
                                path parent, shared_object obj);
-        static shared_value throw_if_null(shared_value v, config_value::type expected, path original_path);
-        static shared_value find_key(shared_object self, std::string const& key,
-                                     config_value::type expected, path original_path);
-        static shared_value find_key_or_null(shared_object self, std::string const& key,
-                                             config_value::type expected, path original_path);
-        static shared_value find_or_null(shared_object self, path desired_path,
-                                         config_value::type expected, path original_path);
+        static shared_value throw_if_null(shared_value v, config_value::type expected, path const& original_path);
+        static shared_value convert_value(shared_value v, config_value::type expected, path const& original_path);
+        static shared_value find_key(shared_object const& self, symbol const& key,
+                                     config_value::type expected, path const& original_path);
+        static shared_value find_key_or_null(shared_object const& self, symbol const& key,
+                                             config_value::type expected, path const& original_path);
+        static shared_value find_or_null(shared_object const& self, path const& desired_path,
+                                         config_value::type expected, path const& original_path);
         shared_value find_or_null(std::string const& path_expression, config_value::type expected) const;
-        shared_value find_or_null(path path_expression, config_value::type expected, path original_path) const;
+        shared_value find_or_null(path const& path_expression, config_value::type expected,
+                                  path const& original_path) const;
 
         shared_object _object;
+        std::shared_ptr<const frozen_index> _index;
+        std::shared_ptr<const resolve_record> _record;
+        // For a lazily resolved config, _object is the unresolved root
+        std::shared_ptr<const lazy_resolver> _lazy;
     };
 
     template<>
-    std::vector<int64_t> config::get_homogeneous_unwrapped_list(std::string const& path) const;
+    std::vector<int64_t> config::get_homogeneous_unwrapped_list(compiled_path const& path) const;
+
+    template<>
+    std::vector<int64_t> config::unwrapped_list(shared_list const& list);
 
 }  // namespace hocon
@@ -3,6 +3,7 @@
 #include "config_value.hpp"
 #include "config_mergeable.hpp"
 #include "path.hpp"
+#include "persistent_map.hpp"
 #include <unordered_map>
 #include "export.h"
 
@@ -45,6 +46,12 @@ namespace hocon {
          */
         virtual shared_value attempt_peek_with_partial_resolve(std::string const& key) const = 0;
 
+        /**
+         * Looks up a key by its symbol, such as a path element, which carries the key's
+         * hash. By default this looks the key up by its text.
+         */
+        virtual shared_value attempt_peek_with_partial_resolve(symbol const& key) const;
+
         /**
          * Construct a list of keys in the _value map.
          * Use a vector rather than set, because most of the time we just want to iterate over them.
@@ -52,7 +59,7 @@ namespace hocon {
         virtual std::vector<std::string> key_set() const = 0;
 
         // map interface
-        using iterator = std::unordered_map<std::string, shared_value>::const_iterator;
+        using iterator = persistent_map::const_iterator;
         virtual bool is_empty() const = 0;
         virtual size_t size() const = 0;
         virtual shared_value operator[](std::string const& key) const = 0;
@@ -62,14 +69,14 @@ namespace hocon {
 
     protected:
         shared_value peek_path(path desired_path) const;
-        shared_value peek_assuming_resolved(std::string const& key, path original_path) const;
+        shared_value peek_assuming_resolved(symbol const& key, path const& original_path) const;
 
         virtual shared_object new_copy(resolve_status const& status, shared_origin origin) const = 0;
         shared_value new_copy(shared_origin origin) const override;
 
         shared_value construct_delayed_merge(shared_origin origin, std::vector<shared_value> stack) const override;
 
-        virtual std::unordered_map<std::string, shared_value> const& entry_set() const = 0;
+        virtual persistent_map const& entry_set() const = 0;
         virtual shared_object without_path(path raw_path) const = 0;
         virtual shared_object with_only_path(path raw_path) const = 0;
         virtual shared_object with_only_path_or_null(path raw_path) const = 0;
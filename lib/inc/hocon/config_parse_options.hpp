@@ -125,15 +125,35 @@ namespace hocon {
          */
         shared_includer const& get_includer() const;
 
+        /**
+         * Set to false to skip tracking where each value came from. Comments are
+         * not collected and every parsed value shares one origin for the whole
+         * input, so {@link config_origin#line_number} returns -1 and error
+         * messages name the file but not the line. This makes parsing faster and
+         * parsed configs smaller when origins are never inspected.
+         *
+         * @param track_origins false to skip per-value origins and comments
+         * @return options with the "track origins" flag set
+         */
+        config_parse_options set_track_origins(bool track_origins) const;
+
+        /**
+         * Gets the current "track origins" flag.
+         * @return whether values get per-line origins and comments
+         */
+        bool get_track_origins() const;
+
     private:
         config_parse_options(shared_string origin_desc,
                              bool allow_missing, shared_includer includer,
-                             config_syntax syntax = config_syntax::UNSPECIFIED);
+                             config_syntax syntax = config_syntax::UNSPECIFIED,
+                             bool track_origins = true);
         config_parse_options with_fallback_origin_description(shared_string origin_description) const;
 
         config_syntax _syntax;
         shared_string _origin_description;
         bool _allow_missing;
         shared_includer _includer;
+        bool _track_origins;
     };
 }  // namespace hocon
@@ -37,6 +37,77 @@ namespace hocon {
          */
         config_resolve_options(bool use_system_environment = true, bool allow_unresolved = false);
 
+        /**
+         * Returns resolve options with the given number of threads for resolving.
+         * By default resolving runs on the calling thread. With more than one thread,
+         * substitutions that don't depend on each other are resolved in parallel;
+         * the result, and any exception, are the same as resolving on one thread.
+         * Only configs with many substitutions are worth the threads, so small
+         * configs still resolve on the calling thread.
+         *
+         * @param value
+         *            the most threads to use, or 0 for one per hardware thread
+         * @return options with the requested number of threads
+         */
+        config_resolve_options set_threads(unsigned value) const;
+
+        /**
+         * Returns the most threads resolving may use, as passed to
+         * {@link config_resolve_options#set_threads}.
+         *
+         * @return the number of threads, or 0 for one per hardware thread
+         */
+        unsigned get_threads() const;
+
+        /**
+         * Returns resolve options with incremental resolving turned on or off. An
+         * incremental resolve remembers, in the config it returns, which paths each
+         * substitution depended on. A config edited from the same source, for example
+         * by {@link config#with_value}, can then be resolved with
+         * {@link config#resolve_incrementally}, which re-resolves only the
+         * substitutions the edits could affect. Off by default, since the record
+         * takes memory for every substitution.
+         *
+         * @param value
+         *            true to keep the record for incremental resolves
+         * @return options with the requested setting for incremental resolving
+         */
+        config_resolve_options set_incremental(bool value) const;
+
+        /**
+         * Returns whether resolves keep the record for incremental resolves.
+         *
+         * @return true if resolving is incremental
+         */
+        bool get_incremental() const;
+
+        /**
+         * Returns resolve options with lazy resolving turned on or off. A lazy
+         * {@link config#resolve(config_resolve_options)} returns at once, and each
+         * getter then resolves only the value it reads and what that value's
+         * substitutions need, memoizing the work for later reads on any thread. Values
+         * nobody reads are never resolved, so an unresolvable substitution among them
+         * is not an error, unless something reads it; {@link config#has_path} reads
+         * the value it checks. Methods that need the whole tree, like
+         * {@link config#root}, {@link config#with_value} or {@link config#freeze},
+         * resolve all of it the first time, throwing what a full resolve would.
+         * {@link config#is_resolved} is false until then. Resolving a lazy config
+         * again resolves its source with the new options. Off by default, and
+         * ignored for incremental resolves.
+         *
+         * @param value
+         *            true to resolve values as they are read
+         * @return options with the requested setting for lazy resolving
+         */
+        config_resolve_options set_lazy(bool value) const;
+
+        /**
+         * Returns whether resolves wait until values are read.
+         *
+         * @return true if resolving is lazy
+         */
+        bool get_lazy() const;
+
         /**
          * Returns resolve options that disable any reference to "system" data
          * (currently, this means environment variables).
@@ -78,6 +149,9 @@ namespace hocon {
     private:
         bool _use_system_environment;
         bool _allow_unresovled;
+        unsigned _threads;
+        bool _incremental;
+        bool _lazy;
     };
 
 }  // namespace hocon
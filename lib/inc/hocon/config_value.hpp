@@ -4,7 +4,10 @@
 #include "config_origin.hpp"
 #include "config_render_options.hpp"
 #include "config_mergeable.hpp"
+#include "config_value_visitor.hpp"
 #include "path.hpp"
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "export.h"
@@ -93,7 +96,23 @@ namespace hocon {
             return type_name(value_type());
         }
 
-        virtual unwrapped_value unwrapped() const = 0;
+        /**
+         * Converts the value to plain C++ values: a std::unordered_map for an object, a
+         * std::vector for a list, and the matching scalar type otherwise. This copies
+         * the whole tree; to read it without copying, use {@link #accept}.
+         *
+         * @return the value's contents
+         */
+        virtual unwrapped_value unwrapped() const;
+
+        /**
+         * Walks the value and everything in it, reporting each part to the visitor; see
+         * {@link config_value_visitor}. Like unwrapped(), it throws if the value hasn't
+         * been resolved.
+         *
+         * @param visitor receives the value's contents
+         */
+        virtual void accept(config_value_visitor& visitor) const = 0;
 
         /**
          * Renders the config value as a HOCON string. This method is primarily
@@ -188,6 +207,16 @@ namespace hocon {
 
         virtual bool operator==(config_value const& other) const = 0;
 
+        /**
+         * A hash of the value's contents that agrees with operator==: equal values hash
+         * the same, and origins play no part. It's computed on first use and kept, so
+         * objects and lists compare their hashes before their contents, and once two
+         * trees have been hashed, differing subtrees are told apart without walking them.
+         *
+         * @return the value's hash
+         */
+        uint64_t hash_code() const;
+
         virtual std::string transform_to_string() const;
 
     protected:
@@ -202,6 +231,9 @@ namespace hocon {
 
         virtual shared_value new_copy(shared_origin origin) const = 0;
 
+        /** Hashes the value's contents for hash_code(), using internal/value_hash.hpp. */
+        virtual uint64_t compute_hash() const = 0;
+
         virtual resolve_result<shared_value>
             resolve_substitutions(resolve_context const& context, resolve_source const& source) const;
 
@@ -263,5 +295,8 @@ namespace hocon {
         shared_value delay_merge(std::vector<shared_value> stack, shared_value fallback) const;
 
         shared_origin _origin;
+
+        // 0 until hash_code() is first called
+        mutable std::atomic<uint64_t> _hash;
     };
 }  // namespace hocon
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "export.h"
+
+namespace hocon {
+
+    /**
+     * Receives the contents of a resolved {@link config_value} as
+     * {@link config_value#accept} walks it, one callback per event, without
+     * copying the tree the way {@link config_value#unwrapped} does.
+     * <p>
+     * An object is reported as begin_object, then key and the key's value for each
+     * entry in unspecified order, then end_object; a list as begin_list, each element
+     * in order, then end_list. Numbers are reported with the type they were parsed
+     * as, just as unwrapped() would hold them. Strings passed to callbacks are only
+     * valid for the duration of the call.
+     * <p>
+     * Every callback does nothing by default, so a visitor only overrides the events
+     * it needs.
+     *
+     * <pre>
+     *     struct port_collector : config_value_visitor {
+     *         void int_value(int value) override { ports.push_back(value); }
+     *         std::vector<int> ports;
+     *     };
+     * </pre>
+     */
+    class LIBCPP_HOCON_EXPORT config_value_visitor {
+    public:
+        virtual ~config_value_visitor() = default;
+
+        /** @param size the number of entries the object has */
+        virtual void begin_object(size_t size) {}
+        /** @param name the key whose value is visited next */
+        virtual void key(std::string const& name) {}
+        virtual void end_object() {}
+
+        /** @param size the number of elements the list has */
+        virtual void begin_list(size_t size) {}
+        virtual void end_list() {}
+
+        virtual void null_value() {}
+        virtual void bool_value(bool value) {}
+        virtual void int_value(int value) {}
+        virtual void long_value(int64_t value) {}
+        virtual void double_value(double value) {}
+        virtual void string_value(std::string const& value) {}
+    };
+
+}  // namespace hocon
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <hocon/functional_list.hpp>
 #include <hocon/types.hpp>
 
 #include <string>
@@ -10,6 +9,13 @@
 
 namespace hocon {
 
+    struct symbol;
+
+    /**
+     * A sequence of keys. The elements live in a shared immutable array and a path is a
+     * slice of it, so length, first, last, remainder, parent, sub_path and hash are
+     * constant time and don't allocate.
+     */
     class LIBCPP_HOCON_EXPORT path {
     public:
         path();
@@ -28,15 +34,18 @@ namespace hocon {
         bool has_remainder() const;
         bool empty() const;
         shared_string last() const;
-        path prepend(path prefix);
+        path prepend(path prefix) const;
         int length() const;
-        path sub_path(int remove_from_front);
-        path sub_path(int start_index, int end_index);
+        path sub_path(int remove_from_front) const;
+        path sub_path(int start_index, int end_index) const;
         bool starts_with(path other) const;
 
         bool operator==(path const& other) const;
         bool operator!=(path const& other) const;
 
+        /** Hash of the elements; equal paths have equal hashes wherever they were built. */
+        size_t hash() const;
+
         /** Signals whether quotes and other noise need to be removed/ignored. */
         static bool has_funky_chars(std::string const& s);
 
@@ -52,9 +61,22 @@ namespace hocon {
         static path new_path(std::string path);
 
     private:
-        path(List<shared_string> other_path);
+        friend class path_builder;
+        friend class config;
+        friend class config_object;
+
+        struct elements;
+
+        path(std::shared_ptr<const elements> elements, size_t begin, size_t end);
+
+        /** Builds a path over the given elements. */
+        static path from_symbols(std::vector<std::shared_ptr<const symbol>> symbols);
+
+        std::shared_ptr<const symbol> const& element(size_t index) const;
 
-        List<shared_string> _path;
+        std::shared_ptr<const elements> _elements;
+        size_t _begin;
+        size_t _end;
     };
 
 }  // namespace hocon
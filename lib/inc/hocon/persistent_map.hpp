@@ -0,0 +1,150 @@
+#pragma once
+
+#include "types.hpp"
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "export.h"
+
+namespace hocon {
+
+    struct symbol;
+
+    /**
+     * An immutable map from keys to config values, stored as a hash array mapped trie.
+     *
+     * Binding or removing a key copies only the nodes on the path down to it, which is
+     * O(log N), and the returned map shares every other node and entry with this one.
+     * Config objects are built and edited one key at a time, so this avoids copying all
+     * of an object's entries for each change.
+     *
+     * Keys are interned, so each distinct key's text is stored once however many maps
+     * and paths use it, and its hash is computed once. The key in each entry refers to
+     * that shared text, and keeps it alive as long as the entry. Lookups by symbol
+     * use the hash it carries, and compare addresses before comparing text.
+     *
+     * Iteration order is unspecified, as with std::unordered_map. Iterators stay valid
+     * as long as the map they came from, or any map sharing its nodes, is alive.
+     */
+    class LIBCPP_HOCON_EXPORT persistent_map {
+        struct node;
+        friend struct persistent_map_ops;
+
+        /** Each trie level consumes this many bits of the key's hash. */
+        static const unsigned bits_per_level = 5;
+        static const unsigned hash_bits = sizeof(size_t) * CHAR_BIT;
+
+        /** Levels that branch on the hash, plus one for keys whose hashes collide. */
+        static const unsigned max_depth = (hash_bits + bits_per_level - 1) / bits_per_level + 1;
+
+    public:
+        using key_type = std::string;
+        using mapped_type = shared_value;
+        using value_type = std::pair<std::string const&, shared_value>;
+        using size_type = size_t;
+
+        class LIBCPP_HOCON_EXPORT const_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = persistent_map::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = value_type const*;
+            using reference = value_type const&;
+
+            /** Constructs an end iterator. */
+            const_iterator() : _depth(0), _current(nullptr) {}
+
+            reference operator*() const { return *_current; }
+            pointer operator->() const { return _current; }
+
+            const_iterator& operator++();
+            const_iterator operator++(int);
+
+            bool operator==(const_iterator const& other) const { return _current == other._current; }
+            bool operator!=(const_iterator const& other) const { return _current != other._current; }
+
+        private:
+            friend class persistent_map;
+            friend struct persistent_map_ops;
+
+            /**
+             * A node being visited: the entry currently pointed at, once the node's own
+             * entries are exhausted the next child node to descend into.
+             */
+            struct frame {
+                node const* trie_node;
+                uint32_t entry;
+                uint32_t child;
+            };
+
+            /** Moves forward from the top frame to the next entry, or to the end. */
+            void settle();
+
+            std::array<frame, max_depth> _stack;
+            size_t _depth;
+            value_type const* _current;
+        };
+        using iterator = const_iterator;
+
+        persistent_map();
+
+        /**
+         * Copies the entries of an unordered_map, for callers that build one up front.
+         * The trie is built in one pass rather than by adding keys one at a time.
+         */
+        persistent_map(std::unordered_map<std::string, shared_value> const& values);
+
+        /** Builds the trie in one pass from entries whose keys are interned, and all different. */
+        explicit persistent_map(std::vector<std::pair<std::shared_ptr<const symbol>, shared_value>> const& entries);
+
+        bool empty() const { return _size == 0; }
+        size_type size() const { return _size; }
+
+        const_iterator begin() const;
+        const_iterator end() const { return const_iterator(); }
+
+        const_iterator find(std::string const& key) const;
+
+        /** Finds a key by its symbol, such as a path element, without hashing its text again. */
+        const_iterator find(symbol const& key) const;
+        size_type count(std::string const& key) const;
+
+        /** Throws std::out_of_range if the key isn't present, like std::unordered_map::at. */
+        shared_value const& at(std::string const& key) const;
+
+        /** Returns the value bound to key, or nullptr if there isn't one. */
+        shared_value get(std::string const& key) const;
+
+        /** Returns a map with key bound to value, replacing any existing binding. */
+        persistent_map set(std::string const& key, shared_value value) const;
+
+        /** Returns a map without key; if key isn't present the result shares this map's root. */
+        persistent_map erase(std::string const& key) const;
+
+        /** Called with a key and its value in each of two maps, or nullptr where a map lacks it. */
+        using difference_visitor = std::function<void(std::string const& key, shared_value const& mine,
+                                                      shared_value const& theirs)>;
+
+        /**
+         * Calls visit for each key that this map and other bind to different values,
+         * compared by address. Subtrees the two maps share are skipped, so comparing a
+         * map with one derived from it by a few sets and erases takes time in proportion
+         * to those edits rather than to the size of the maps.
+         */
+        void for_each_difference(persistent_map const& other, difference_visitor const& visit) const;
+
+    private:
+        persistent_map(std::shared_ptr<const node> root, size_type size);
+
+        std::shared_ptr<const node> _root;
+        size_type _size;
+    };
+
+}  // namespace hocon
@@ -21,7 +21,7 @@ namespace hocon { namespace config_document_parser {
 
     class parse_context {
     public:
-        parse_context(config_syntax flavor, shared_origin origin, token_iterator tokens);
+        parse_context(config_syntax flavor, shared_origin origin, token_iterator tokens, bool track_lines = true);
 
         std::shared_ptr<config_node_root> parse();
 
@@ -30,6 +30,16 @@ namespace hocon { namespace config_document_parser {
          */
         shared_node_value parse_single_value();
 
+        /**
+         * Grammar helpers shared with the config_token_parser, which parses
+         * the same syntax straight into values.
+         */
+        static std::string add_quote_suggestion(std::string bad_token, std::string message,
+                                                bool inside_equals, path* last_path);
+        static bool is_include_keyword(shared_token t);
+        static bool is_unquoted_whitespace(shared_token t);
+        static bool is_valid_array_element(shared_token t);
+
     private:
         parse_exception parse_error(std::string message);
 
@@ -51,9 +61,6 @@ namespace hocon { namespace config_document_parser {
         /** Parse a concatenation. If there is no concatenation, return the next value. */
         shared_node_value consolidate_values(shared_node_list& nodes);
 
-        std::string add_quote_suggestion(std::string bad_token, std::string message,
-                                         bool inside_equals, path* last_path);
-
         std::string add_quote_suggestion(std::string bad_token, std::string message);
 
         shared_node_value parse_value(shared_token t);
@@ -63,14 +70,11 @@ namespace hocon { namespace config_document_parser {
         std::shared_ptr<config_node_complex_value> parse_object(bool had_open_curly);
         std::shared_ptr<config_node_complex_value> parse_array();
 
-        static bool is_include_keyword(shared_token t);
-        static bool is_unquoted_whitespace(shared_token t);
-        static bool is_valid_array_element(shared_token t);
-
         int _line_number;
         std::stack<shared_token> _buffer;
         token_iterator _tokens;
         config_syntax _flavor;
+        bool _track_lines;
         shared_origin _base_origin;
 
         // this is the number of "equals" we are inside,
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <hocon/config_value.hpp>
+#include <hocon/config_syntax.hpp>
+#include <hocon/config_include_context.hpp>
+#include <hocon/config_parse_options.hpp>
+#include <hocon/path.hpp>
+#include <internal/nodes/config_node_path.hpp>
+#include <internal/full_includer.hpp>
+#include <internal/tokenizer.hpp>
+#include <memory>
+#include <stack>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hocon { namespace config_token_parser {
+
+    /**
+     * Parse a token stream straight into a config value, without building the
+     * lossless config_node tree first. This is the only parser that builds values;
+     * it accepts what the config_document_parser accepts, and gives the values
+     * that tree describes, including origins, comments, includes, += and
+     * concatenations.
+     */
+    shared_value parse(token_iterator tokens,
+            shared_origin origin,
+            config_parse_options options,
+            shared_include_context include_context);
+
+    class parse_context {
+    public:
+        parse_context(config_syntax flavor, shared_origin origin, token_iterator tokens,
+                std::shared_ptr<const full_includer> includer, shared_include_context include_context,
+                bool track_origins = true);
+
+        shared_value parse();
+
+        int array_count;
+
+        /** For path foo.bar, creates { "foo" : { "bar" : value } }. */
+        static shared_object create_value_under_path(path p, shared_value value);
+
+    private:
+        /**
+         * Lines are counted and comments attached per object, array and root, as
+         * the children of each node of the document tree would be walked. This
+         * tracks that state for the node the document parser would be appending
+         * to, so whitespace and comments can be applied as they are read instead
+         * of stored.
+         */
+        struct container {
+            enum class kind { ROOT, OBJECT, ARRAY, FIELD, INCLUDE, DEFERRED };
+
+            explicit container(kind k);
+
+            kind type;
+            std::vector<std::string> comments;
+            bool last_was_newline;
+            bool done;
+
+            // The root result, the last array element, or the last object
+            // field, while it may still pick up trailing comments.
+            shared_value pending;
+            path pending_path;
+
+            std::vector<shared_value> elements;
+            std::unordered_map<std::string, shared_value> fields;
+
+            // Leading whitespace read before the root knows what it contains.
+            token_list deferred;
+        };
+
+        parse_exception parse_error(std::string message);
+        shared_origin line_origin() const;
+        path full_current_path() const;
+
+        shared_token pop_token();
+        shared_token next_token();
+        shared_token next_token_collecting_whitespace(container& c);
+        void put_back(shared_token token);
+        bool check_element_separator(container& c);
+
+        void add_trivia(container& c, shared_token const& t);
+        void add_element(container& c, shared_value v);
+        void settle_field(container& c);
+        void store_field(container& c, path const& p, shared_value v);
+        shared_value with_comments(shared_value v, std::vector<std::string>& comments);
+
+        shared_value consolidate_values(container& c);
+        shared_value parse_value(shared_token t);
+        config_node_path parse_key(shared_token t);
+        bool is_key_value_separator(shared_token t) const;
+        void parse_include(container& c);
+        shared_value parse_object(bool had_open_curly, token_list const& leading = token_list());
+        shared_value parse_array();
+
+        int _doc_line_number;
+        int _line_number;
+        std::stack<shared_token> _buffer;
+        token_iterator _tokens;
+        std::shared_ptr<const full_includer> _includer;
+        shared_include_context _include_context;
+        config_syntax _flavor;
+        bool _track_origins;
+        shared_origin _base_origin;
+        std::vector<path> _path_stack;
+
+        // this is the number of "equals" we are inside,
+        // used to modify the error message to reflect that
+        // someone may think this is .properties format.
+        int _equals_count;
+    };
+
+}}  // namespace hocon::config_token_parser
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace hocon {
@@ -14,4 +15,18 @@ namespace hocon {
 
     std::string render_string_unquoted_if_possible(std::string const& s);
 
+    /**
+     * Parses the whole of s as a decimal integer with an optional sign. Unlike
+     * boost::lexical_cast this never throws, so callers can cheaply try a conversion.
+     * @return false if s isn't an integer or doesn't fit in 64 bits
+     */
+    bool parse_int64(std::string const& s, int64_t& result);
+
+    /**
+     * Parses the whole of s as a floating point number, independent of the global locale.
+     * Accepts the same forms as boost::lexical_cast<double>, including nan and inf.
+     * @return false if s isn't a number or is out of range for a double
+     */
+    bool parse_double(std::string const& s, double& result);
+
 }  // namespace hocon
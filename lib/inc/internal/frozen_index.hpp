@@ -0,0 +1,51 @@
+#pragma once
+
+#include <hocon/compiled_path.hpp>
+#include <hocon/types.hpp>
+#include <internal/perfect_hash.hpp>
+#include <string>
+#include <vector>
+
+namespace hocon {
+
+    /**
+     * The lookup table behind a frozen config: every full path in a resolved object
+     * tree, including paths to objects and nulls, mapped to its value through a
+     * perfect hash on the path's hash. A second perfect hash maps each path's
+     * rendered expression to the same entries, so looking up a path expression
+     * written the usual way doesn't need to parse it.
+     *
+     * The index is immutable once built and safe to share between threads.
+     */
+    class frozen_index {
+    public:
+        /** Indexes every value under root, which should be resolved. */
+        explicit frozen_index(shared_object const& root);
+
+        /** The value at desired_path, or nullptr if the path isn't indexed. */
+        shared_value find(path const& desired_path) const;
+
+        /**
+         * The indexed path whose rendered form is expression, or nullptr if there
+         * isn't one; expressions in any other form have to be parsed.
+         */
+        compiled_path const* find_expression(std::string const& expression) const;
+
+        /** The number of paths indexed. */
+        size_t size() const { return _entries.size(); }
+
+    private:
+        struct entry {
+            compiled_path full_path;
+            shared_value value;
+        };
+
+        void add_entries(shared_object const& object, path const& parent);
+
+        std::vector<entry> _entries;
+        perfect_hash _by_path;
+        perfect_hash _by_expression;
+        std::vector<uint32_t> _expression_entries;
+    };
+
+}  // namespace hocon
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <hocon/config_value.hpp>
+#include <internal/tokenizer.hpp>
+#include <string>
+
+namespace hocon { namespace json_parser {
+
+    /**
+     * Parse strict JSON straight from a buffer into config values, without
+     * going through the HOCON tokenizer. Returns nullptr for anything outside
+     * the plain JSON subset it handles (errors, comments, duplicate keys, ...);
+     * the caller then parses the input the regular way, which either accepts it
+     * or reports the error. UTF-8 text in strings is kept as it is, as the
+     * tokenizer keeps it.
+     */
+    shared_value parse(input_buffer const& input, shared_origin origin, bool track_origins = true);
+
+    class parse_context {
+    public:
+        parse_context(input_buffer const& input, shared_origin origin, bool track_origins);
+
+        shared_value parse();
+
+    private:
+        /**
+         * Skips JSON whitespace and returns the next character, or 0 at the end
+         * of input. Newlines between a key and its value are left out of the
+         * container line count, as in the config_token_parser.
+         */
+        char skip_whitespace(bool count_container_lines = true);
+
+        shared_origin const& value_origin();
+        shared_origin container_origin() const;
+
+        bool pull_string(std::string& result);
+        shared_value parse_value(char c);
+        shared_value parse_number();
+        bool pull_literal(char const* text, size_t length);
+        bool at_delimiter() const;
+        shared_value parse_object();
+        shared_value parse_array();
+
+        char const* _pos;
+        char const* _end;
+        shared_origin _base_origin;
+        bool _track_origins;
+
+        int _line_number;
+        int _container_line_number;
+        int _value_origin_line;
+        shared_origin _value_origin;
+    };
+
+}}  // namespace hocon::json_parser
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <hocon/config_resolve_options.hpp>
+#include <hocon/path.hpp>
+#include <hocon/types.hpp>
+#include <internal/resolve_context.hpp>
+
+#include <mutex>
+
+namespace hocon {
+
+    /**
+     * Resolves a root object a path at a time, for a config whose values are
+     * resolved as they're read (see config_resolve_options#set_lazy).
+     *
+     * Every lookup shares one resolve's memos, so a value resolved for one path,
+     * or for a substitution another path needed, isn't resolved again; the memos
+     * are locked, and each lookup has its own cycle markers, so lookups may run
+     * on any number of threads at once.
+     */
+    class lazy_resolver {
+    public:
+        lazy_resolver(shared_object root, config_resolve_options options);
+
+        /**
+         * The root with the objects on the way to the path resolved, and the value
+         * at the path too, so looking the path up in it gives what looking it up in
+         * the fully resolved root would. Throws what resolving that value throws.
+         */
+        shared_object resolve_path(path const& the_path) const;
+
+        /** The fully resolved root, resolved on first use. */
+        shared_object resolved() const;
+
+        /**
+         * Whether the root has been resolved in full, leaving no unresolved
+         * substitutions. It doesn't resolve anything itself.
+         */
+        bool is_resolved() const;
+
+    private:
+        shared_object _root;
+        resolve_context _context;
+
+        mutable std::mutex _lock;
+        mutable shared_object _resolved;
+    };
+
+}  // namespace hocon
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <hocon/types.hpp>
+#include <internal/resolve_source.hpp>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hocon {
+
+    class resolve_context;
+    class simple_config_object;
+
+    /**
+     * Resolves the substitutions in a root object on several threads, in place of
+     * the usual recursive resolve.
+     *
+     * The work is split into units: the unresolved values in the tree that aren't
+     * plain objects, like references, concatenations and delayed merges, each with
+     * the parents the recursive resolve would pass it. A unit depends on the units
+     * its substitutions could read, which are those at the path substituted, above
+     * it or under it. Units that depend on each other, directly or not, form one
+     * task, resolved in order on one thread; that includes self-references like
+     * <code>path = ${path}":/bin"</code>, and cycles that resolving reports as
+     * errors. A task runs once the tasks it depends on have finished.
+     *
+     * Once every task has finished, the resolved root is put together from the
+     * units' results, which is what the recursive resolve would build from them.
+     * A task that throws stops the rest, and the first exception thrown is rethrown.
+     */
+    class parallel_resolver {
+    public:
+        /** Finds the units of root and the order they can be resolved in. */
+        explicit parallel_resolver(shared_object root);
+
+        /** The number of units to resolve. */
+        size_t size() const { return _units.size(); }
+
+        /**
+         * Resolves every unit on up to the given number of threads, including the
+         * calling one, memoizing the results in context's memos, and returns the
+         * resolved root. Throws the first exception resolving a unit threw.
+         */
+        shared_value run(resolve_context const& context, unsigned threads) const;
+
+    private:
+        struct unit {
+            shared_value value;
+            resolve_source::node parents;
+        };
+
+        // The paths to the units, so a substitution can find the units it may read
+        struct trie_node {
+            std::unordered_map<std::string, size_t> children;
+            int unit;
+            // The graph node that depends on every unit under this one, or -1 until needed
+            int group;
+        };
+
+        size_t add_trie_node();
+        void find_units(std::shared_ptr<const simple_config_object> const& object, size_t trie,
+                        resolve_source::node const& parents);
+        void add_dependency(size_t node, path const& target);
+        size_t group_of(size_t trie);
+        void schedule();
+
+        /** The object with each unit under it replaced by its result. */
+        shared_value assemble(std::shared_ptr<const simple_config_object> const& object,
+                              std::vector<shared_value> const& results) const;
+
+        shared_object _root;
+        std::vector<unit> _units;
+        // The unit for each unresolved value; a value shared between paths is one unit
+        std::unordered_map<config_value const*, size_t> _unit_of;
+        std::vector<trie_node> _trie;
+
+        // For each graph node, the nodes it depends on; units come first, then groups
+        std::vector<std::vector<size_t>> _graph;
+
+        // For each task, its units in the order the recursive resolve would reach them,
+        // the tasks waiting for it, and how many tasks it waits for
+        std::vector<std::vector<size_t>> _tasks;
+        std::vector<std::vector<size_t>> _dependents;
+        std::vector<size_t> _dependencies;
+    };
+
+}  // namespace hocon
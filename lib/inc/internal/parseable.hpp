@@ -9,6 +9,8 @@
 namespace hocon {
 
     class config_document;
+    class input_buffer;
+    class token_iterator;
 
     class parseable : public config_parseable, public std::enable_shared_from_this<parseable> {
     public:
@@ -32,6 +34,12 @@ namespace hocon {
 
         virtual std::unique_ptr<std::istream> reader(config_parse_options const& options) const;
         virtual std::unique_ptr<std::istream> reader() const = 0;
+
+        /**
+         * Returns the whole input as a contiguous buffer the tokenizer can scan in place,
+         * or nullptr if this parseable can only be read through reader().
+         */
+        virtual std::shared_ptr<const input_buffer> buffer() const;
         virtual shared_origin create_origin() const = 0;
 
         virtual config_syntax guess_syntax() const;
@@ -53,20 +61,26 @@ namespace hocon {
         std::shared_ptr<config_document> parse_document(config_parse_options const& base_options) const;
         std::shared_ptr<config_document> parse_document(shared_origin origin,
                                                         config_parse_options const& final_options) const;
-        std::shared_ptr<config_document> raw_parse_document(std::unique_ptr<std::istream> stream, shared_origin origin,
+        std::shared_ptr<config_document> raw_parse_document(token_iterator tokens, shared_origin origin,
                                                             config_parse_options const& options) const;
         std::shared_ptr<config_document> raw_parse_document(shared_origin origin,
                                                             config_parse_options const& options) const;
 
         shared_value parse_value(config_parse_options const& base_options) const;
         shared_value parse_value(shared_origin origin, config_parse_options const& options) const;
-        shared_value raw_parse_value(std::unique_ptr<std::istream> stream,
+        shared_value raw_parse_value(token_iterator tokens,
                                      shared_origin origin,
                                      config_parse_options const& options) const;
         shared_value raw_parse_value(shared_origin origin, config_parse_options const& options) const;
 
         config_parse_options fixup_options(config_parse_options const& base_options) const;
 
+        /** The options with the syntax set to the content type, once it is known. */
+        config_parse_options with_content_type(config_parse_options const& options) const;
+        token_iterator tokenize(shared_origin origin, std::shared_ptr<const input_buffer> input,
+                                config_parse_options const& options,
+                                config_parse_options& options_with_content_type) const;
+
         std::vector<parseable> _parse_stack;
 
         shared_origin _initial_origin;
@@ -80,6 +94,7 @@ namespace hocon {
     public:
         parseable_file(std::string input_file_path, config_parse_options options);
         std::unique_ptr<std::istream> reader() const override;
+        std::shared_ptr<const input_buffer> buffer() const override;
         shared_origin create_origin() const override;
         config_syntax guess_syntax() const override;
 
@@ -91,6 +106,7 @@ namespace hocon {
     public:
         parseable_string(std::string s, config_parse_options options);
         std::unique_ptr<std::istream> reader() const override;
+        std::shared_ptr<const input_buffer> buffer() const override;
         shared_origin create_origin() const override;
 
     private:
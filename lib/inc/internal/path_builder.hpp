@@ -1,20 +1,22 @@
 #pragma once
 
 #include <hocon/path.hpp>
-#include <stack>
+#include <internal/symbol_table.hpp>
+#include <vector>
 
 namespace hocon {
 
     class path_builder {
     public:
-        void append_key(std::string key);
+        void append_key(std::string const& key);
+
         void append_path(path path_to_append);
 
         /** Returns null if keys is empty. */
         path result();
 
     private:
-        std::stack<std::string> _keys;
+        std::vector<symbol_ref> _keys;
     };
 
 }  // namespace hocon
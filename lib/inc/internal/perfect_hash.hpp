@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hocon {
+
+    /**
+     * A minimal perfect hash over a fixed set of distinct hash values: each of the N
+     * values it was built from maps to its own slot in [0, N), at the cost of about
+     * two bytes per value.
+     *
+     * Built with hash-and-displace: values are grouped into buckets, and each bucket,
+     * largest first, gets the first seed that sends all of its values to free slots.
+     * Buckets holding a single value record their slot directly. A lookup is one
+     * bucket read and one mix; values that weren't in the set map to some slot, so
+     * callers check the entry they find there.
+     */
+    class perfect_hash {
+    public:
+        perfect_hash() : _size(0) {}
+
+        /**
+         * Builds the hash over the given values. Returns false, leaving the hash
+         * empty, if two of them are equal.
+         */
+        bool build(std::vector<size_t> const& hashes);
+
+        /** The number of values, and slots. */
+        size_t size() const { return _size; }
+
+        /** The slot for a value; only meaningful if size() isn't 0. */
+        size_t slot(size_t hash) const;
+
+    private:
+        std::vector<uint32_t> _displacements;
+        size_t _size;
+    };
+
+}  // namespace hocon
@@ -4,7 +4,12 @@
 #include <hocon/config_resolve_options.hpp>
 #include <hocon/path.hpp>
 
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace hocon {
 
@@ -15,20 +20,50 @@ namespace hocon {
 
     class resolve_context {
     public:
-        resolve_context(config_resolve_options options, path restrict_to_child, std::vector<shared_value> cycle_markers);
+        /**
+         * Looks up what an unresolved value resolved to in an earlier resolve, returning
+         * nullptr if that result can't be reused.
+         */
+        using earlier_results = std::function<shared_value(shared_value const&)>;
+
+        /** Creates the context for a new resolve, with nothing memoized yet. */
         resolve_context(config_resolve_options options, path restrict_to_child);
+
+        /**
+         * Creates the context for a new resolve that reuses earlier results where it can.
+         * If environment isn't null, substitutions fall back to it rather than to a
+         * snapshot of the environment taken when first needed.
+         */
+        resolve_context(config_resolve_options options, path restrict_to_child, earlier_results earlier,
+                        shared_object environment = nullptr);
         bool is_restricted_to_child() const;
         config_resolve_options options() const;
 
         resolve_result<shared_value> resolve(shared_value original, resolve_source const& source) const;
         path restrict_to_child() const;
 
-        resolve_context add_cycle_marker(shared_value value) const;
-        resolve_context remove_cycle_marker(shared_value value);
         resolve_context restrict(path restrict_to) const;
         resolve_context unrestricted() const;
 
-        static shared_value resolve(shared_value value, shared_object root, config_resolve_options options);
+        /**
+         * Returns an unrestricted context that shares this resolve's memos but has no
+         * cycle markers, for resolving a value on another thread while this one goes on.
+         */
+        resolve_context fork() const;
+
+        /**
+         * The environment variables as an object, for substitutions that aren't found
+         * in the root. It's read when first needed and kept for the rest of the resolve,
+         * so every substitution sees the same environment.
+         */
+        shared_object environment() const;
+
+        /**
+         * Resolves value, whose substitutions are looked up in root. If environment isn't
+         * null, substitutions not found in root fall back to it.
+         */
+        static shared_value resolve(shared_value value, shared_object root, config_resolve_options options,
+                                    shared_object environment = nullptr);
 
     private:
         struct memo_key {
@@ -43,11 +78,61 @@ namespace hocon {
             std::size_t operator()(const memo_key&) const;
         };
         using resolve_memos = std::unordered_map<memo_key, shared_value, memo_key_hash>;
+
+        /**
+         * The memos of one resolve, shared by all its contexts and updated in place
+         * rather than copied into each new context. A memo is what its value resolves
+         * to within this resolve, whichever context recorded it, so sharing them
+         * doesn't change any result. They're split into locked shards so contexts on
+         * different threads rarely wait for each other.
+         */
+        struct memo_table {
+            struct shard {
+                std::mutex lock;
+                resolve_memos memos;
+            };
+            std::array<shard, 16> shards;
+            earlier_results earlier;
+            std::once_flag environment_read;
+            shared_object environment;
+
+            shard& shard_for(memo_key const& key);
+        };
+
+        /**
+         * The values being resolved on one thread of a resolve. They come and go in
+         * nested order, so contexts on that thread share them.
+         */
+        using cycle_markers = std::unordered_set<config_value const*>;
+
+        resolve_context(config_resolve_options options, path restrict_to_child,
+                        std::shared_ptr<memo_table> memos, std::shared_ptr<cycle_markers> markers);
+
         config_resolve_options _options;
         path _restrict_to_child;
-        resolve_memos _memos;
-        std::vector<shared_value> _cycle_markers;
+        std::shared_ptr<memo_table> _memos;
+        std::shared_ptr<cycle_markers> _cycle_markers;
 
-        resolve_context memoize(const memo_key& key, const shared_value& value) const;
+        shared_value find_memo(const memo_key& key) const;
+        void memoize(const memo_key& key, const shared_value& value) const;
+
+    public:
+        /**
+         * Marks a value as being resolved for as long as the marker lives, so that
+         * resolving it again from within, through a cycle of substitutions, throws
+         * not_possible_to_resolve_exception instead of recursing forever.
+         */
+        class cycle_marker {
+        public:
+            cycle_marker(resolve_context const& context, shared_value const& value);
+            ~cycle_marker();
+
+            cycle_marker(cycle_marker const&) = delete;
+            cycle_marker& operator=(cycle_marker const&) = delete;
+
+        private:
+            std::shared_ptr<cycle_markers> _markers;
+            config_value const* _value;
+        };
     };
 }  // namespace hocon
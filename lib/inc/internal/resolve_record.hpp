@@ -0,0 +1,123 @@
+#pragma once
+
+#include <hocon/config_resolve_options.hpp>
+#include <hocon/path.hpp>
+#include <hocon/types.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace hocon {
+
+    class simple_config_object;
+
+    /**
+     * What an incremental resolve keeps so that an edited copy of its source can be
+     * resolved again cheaply: the source, the result, and for each unresolved value
+     * that isn't a plain object, where it is and which paths its substitutions look up.
+     *
+     * Updating for an edited source compares it with the recorded one, skipping the
+     * subtrees they share, to find the paths whose values changed. A recorded value is
+     * affected if it's at or under one of those paths, or looks up a path at, under or
+     * above one, or looks up an affected value; the search continues from each affected
+     * value's path. Only those paths are resolved again, reusing the recorded results
+     * of everything else, and only they are replaced in a copy of the recorded result.
+     *
+     * Each resolve takes its own snapshot of the environment variables, which the
+     * record keeps. A variable that changed between snapshots counts as a changed path
+     * of the same name, so values that may have fallen back to it are resolved again
+     * and no result mixes values from two snapshots.
+     *
+     * The values are recorded in layers. An update adds a layer for the paths it
+     * resolved again, which hides the older layers' values at and under those paths,
+     * so it doesn't copy the rest of the record. Every few updates the layers after
+     * the first are merged into one by recording their paths again, and once that
+     * holds as many values as the first, the whole source is recorded again.
+     */
+    class resolve_record : public std::enable_shared_from_this<resolve_record> {
+    public:
+        /** Resolves source with the given options, recording the resolve. */
+        static std::shared_ptr<const resolve_record> record(config_resolve_options options, shared_object source);
+
+        /**
+         * Resolves source, usually an edited copy of the recorded source, returning
+         * the record of that resolve. Throws what a full resolve of source would throw.
+         */
+        std::shared_ptr<const resolve_record> update(shared_object source) const;
+
+        /** The resolved root object. */
+        shared_object const& result() const { return _result; }
+
+    private:
+        struct unit {
+            path at;
+            shared_value value;
+        };
+
+        /**
+         * The values one resolve recorded, in a trie of path elements. A node notes the
+         * value at its path, if it's recorded, and the values that look its path up.
+         */
+        struct layer {
+            struct node {
+                std::unordered_map<std::string, size_t> children;
+                int unit;
+                std::vector<size_t> readers;
+                // Whether this layer resolved everything at and under this path again
+                bool replaced;
+            };
+
+            layer();
+
+            size_t child(size_t parent, std::string const& key);
+            void add_units(shared_value const& value, path const& at);
+            void add_units(shared_value const& value, std::vector<std::string>& at);
+            void add_unit(shared_value const& value, std::vector<std::string> const& at);
+
+            /**
+             * Notes that this layer resolved everything at and under a path again,
+             * returning false if it already had, through the path or one holding it.
+             */
+            bool replace(path const& at);
+
+            std::vector<node> trie;
+            std::vector<unit> units;
+            std::unordered_map<config_value const*, size_t> by_value;
+            std::vector<path> regions;
+        };
+        using shared_layer = std::shared_ptr<const layer>;
+
+        resolve_record(config_resolve_options options, shared_object source, shared_object result,
+                       shared_object environment, std::vector<shared_layer> layers);
+
+        /** A snapshot of the environment for a resolve with options, or nullptr if it doesn't use one. */
+        static shared_object environment_for(config_resolve_options const& options);
+        static void find_environment_changes(shared_object const& mine, shared_object const& theirs,
+                                             std::shared_ptr<const simple_config_object> const& source,
+                                             std::vector<path>& changed);
+
+        bool is_live(size_t layer_index, size_t unit_index) const;
+        shared_value earlier_result(shared_value const& value,
+                                    std::unordered_set<config_value const*> const& affected) const;
+
+        template<typename Visit>
+        void for_each_affected(size_t layer_index, path const& changed, Visit const& visit) const;
+
+        static std::vector<shared_layer> compacted(std::vector<shared_layer> const& layers,
+                                                   std::shared_ptr<const simple_config_object> const& source);
+        static void find_changes(std::shared_ptr<const simple_config_object> const& mine,
+                                 std::shared_ptr<const simple_config_object> const& theirs,
+                                 std::vector<std::string>& at, std::vector<path>& changed);
+
+        config_resolve_options _options;
+        shared_object _source;
+        shared_object _result;
+        shared_object _environment;
+        std::vector<shared_layer> _layers;
+    };
+
+}  // namespace hocon
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <list>
 #include <hocon/types.hpp>
@@ -28,6 +29,20 @@ namespace hocon {
         resolve_source push_parent(std::shared_ptr<const container> parent) const;
         result_with_path lookup_subst(resolve_context context, std::shared_ptr<substitution_expression> subst, int prefix_length) const;
 
+        /**
+         * Calls visit with each path that resolving value's substitutions may look up,
+         * including the substitutions inside its concatenations, merges, objects and lists.
+         */
+        static void for_each_lookup(shared_value const& value, std::function<void(path const&)> const& visit);
+
+        /**
+         * Resolves the value at a path in the root, along with the objects on the way to
+         * it and whatever its substitutions look up, but nothing else. The result's value
+         * is nullptr if there's no value at the path; path_from_root ends with the root
+         * as resolved along the path.
+         */
+        result_with_path resolve_path(resolve_context context, path const& the_path) const;
+
         resolve_source replace_current_parent(std::shared_ptr<const container> old, std::shared_ptr<const container> replacement) const;
         resolve_source replace_within_current_parent(shared_value old, shared_value replacement) const;
         resolve_source reset_parents() const;
@@ -10,6 +10,20 @@ namespace hocon {
 
     enum class origin_type { GENERIC, FILE, RESOURCE };
 
+    /**
+     * The parts of an origin that are the same for every line of a file or resource.
+     * Origins derived from one another share a single descriptor, so the per-line origins
+     * created while parsing only carry line numbers and comments.
+     */
+    struct origin_descriptor {
+        std::string description;
+        origin_type type;
+        std::string resource_or_null;
+    };
+
+    using shared_origin_descriptor = std::shared_ptr<const origin_descriptor>;
+    using shared_comments = std::shared_ptr<const std::vector<std::string>>;
+
     class simple_config_origin : public config_origin, public std::enable_shared_from_this<simple_config_origin> {
     public:
         simple_config_origin(std::string description, int line_number, int end_line_number,
@@ -19,6 +33,10 @@ namespace hocon {
         simple_config_origin(std::string description, int line_number = -1, int end_line_number = -1,
                              origin_type org_type = origin_type::GENERIC);
 
+        /** Creates an origin sharing an existing descriptor; comments may be null if there are none. */
+        simple_config_origin(shared_origin_descriptor descriptor, int line_number, int end_line_number,
+                             shared_comments comments_or_null);
+
         int line_number() const override;
 
         std::string const& description() const override;
@@ -56,12 +74,12 @@ namespace hocon {
         static int similarity(std::shared_ptr<const simple_config_origin> a,
                               std::shared_ptr<const simple_config_origin> b);
 
-        std::string _description;
+        static shared_comments make_comments(std::vector<std::string> comments);
+
+        shared_origin_descriptor _descriptor;
         int _line_number;
         int _end_line_number;
-        origin_type _origin_type;
-        std::string _resource_or_null;
-        std::vector<std::string> _comments_or_null;
+        shared_comments _comments_or_null;
     };
 
 }  // namespace hocon
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <hocon/types.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace hocon {
+
+    /**
+     * An interned object key or path element. While a symbol is alive there is one
+     * interned symbol per distinct text, so two object keys are the same key exactly
+     * when they are the same object.
+     */
+    struct symbol {
+        symbol(std::string text, size_t hash) : text(std::move(text)), hash(hash) {}
+
+        std::string const text;
+
+        /** The text's std::hash, so maps keyed by symbol can also be searched by string. */
+        size_t const hash;
+    };
+
+    using symbol_ref = std::shared_ptr<const symbol>;
+
+    /**
+     * The process-wide table of symbols. The table only refers to its symbols weakly:
+     * a symbol is removed once the last object key or path using it is gone, so the
+     * keys of a config that has been released don't stay in memory.
+     *
+     * Safe to use from multiple threads. The table is split into shards by hash, each
+     * with its own lock, so threads interning different keys rarely wait on each other.
+     */
+    class symbol_table {
+    public:
+        /** Returns the symbol for text, adding it on first use. */
+        static symbol_ref intern(std::string const& text);
+
+        /**
+         * Returns a symbol for text that isn't in the table, without taking any lock.
+         * For path elements, which are compared with keys by hash and then text, so
+         * building a path for a getter neither grows the table nor waits on it.
+         */
+        static symbol_ref unlisted(std::string const& text);
+
+        /** Whether two symbols have the same text, comparing their identity first. */
+        static bool same(symbol const& a, symbol const& b) {
+            return &a == &b || (a.hash == b.hash && a.text == b.text);
+        }
+
+        /** Returns a shared_string for the symbol's text, which keeps the symbol alive. */
+        static shared_string shared_text(symbol_ref const& s);
+
+        /** The number of symbols in the table. */
+        static size_t size();
+    };
+
+}  // namespace hocon
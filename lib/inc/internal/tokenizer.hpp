@@ -5,8 +5,8 @@
 #include <hocon/config_syntax.hpp>
 
 #include <boost/nowide/fstream.hpp>
+#include <array>
 #include <vector>
-#include <queue>
 #include <string>
 
 namespace hocon {
@@ -46,10 +46,50 @@ namespace hocon {
         iter _end;
     };
 
+    /**
+     * A contiguous, read-only range of input that the tokenizer can scan in place
+     * with raw pointers, rather than pulling every character through std::istream.
+     * The range must stay valid for the lifetime of the buffer; subclasses that own
+     * their storage keep it alive through the shared_ptr held by the tokenizer.
+     */
+    class input_buffer {
+    public:
+        input_buffer(char const* begin, char const* end);
+        virtual ~input_buffer() = default;
+
+        char const* begin() const;
+        char const* end() const;
+
+    protected:
+        char const* _begin;
+        char const* _end;
+    };
+
+    /** An input_buffer that owns its contents. */
+    class string_input_buffer : public input_buffer {
+    public:
+        explicit string_input_buffer(std::string contents);
+
+    private:
+        std::string _contents;
+    };
+
+    using shared_input_buffer = std::shared_ptr<const input_buffer>;
+
     class token_iterator : public iterator {
     public:
-        token_iterator(shared_origin origin, std::unique_ptr<std::istream> input, bool allow_comments);
-        token_iterator(shared_origin origin, std::unique_ptr<std::istream> input, config_syntax flavor);
+        /**
+         * When track_lines is false every token shares the given origin rather than
+         * getting one for its line; see config_parse_options::set_track_origins.
+         */
+        token_iterator(shared_origin origin, std::unique_ptr<std::istream> input, bool allow_comments,
+                       bool track_lines = true);
+        token_iterator(shared_origin origin, std::unique_ptr<std::istream> input, config_syntax flavor,
+                       bool track_lines = true);
+        token_iterator(shared_origin origin, shared_input_buffer input, bool allow_comments,
+                       bool track_lines = true);
+        token_iterator(shared_origin origin, shared_input_buffer input, config_syntax flavor,
+                       bool track_lines = true);
 
         bool has_next() override;
         shared_token next() override;
@@ -61,12 +101,13 @@ namespace hocon {
         public:
             whitespace_saver();
             void add(char c);
-            shared_token check(token_type type, shared_origin base_origin, int line_number);
+            void add(char const* begin, char const* end);
+            shared_token check(token_type type, shared_origin const& line_origin);
 
         private:
-            shared_token next_is_not_simple_value(shared_origin base_origin, int line_number);
-            shared_token next_is_simple_value(shared_origin origin, int line_number);
-            shared_token create_whitespace_token(shared_origin base_origin, int line_number);
+            shared_token next_is_not_simple_value(shared_origin const& line_origin);
+            shared_token next_is_simple_value(shared_origin const& line_origin);
+            shared_token create_whitespace_token(shared_origin const& line_origin);
 
             std::string _whitespace;
             bool _last_token_was_simple_value;
@@ -86,6 +127,9 @@ namespace hocon {
          */
         shared_token pull_unquoted_text();
 
+        /** Appends the rest of an unquoted text token to result, scanning it a run at a time. */
+        void pull_unquoted_run(std::string& result);
+
         shared_token pull_number(char first_char);
 
         /**
@@ -103,16 +147,43 @@ namespace hocon {
         shared_token pull_next_token(whitespace_saver& saver);
         void queue_next_token();
 
+        /**
+         * Character input. These mirror the std::istream get/peek/putback calls the
+         * tokenizer was written against, including the sticky end-of-input state, but
+         * read straight from [_pos, _end). In stream mode the range is a chunk that
+         * fill() refills from _input; in buffer mode it is the caller's whole buffer.
+         */
+        bool good() const;
+        char get();
+        int peek();
+        void unget();
+        bool fill();
+
+        /** Moves on to the next line of input, updating the origin given to new tokens. */
+        void next_line();
+
         static bool is_simple_value(token_type type);
         static std::string as_string(char c);
-        static shared_origin line_origin(shared_origin base_origin, int line_number);
 
         shared_origin _origin;
         std::unique_ptr<std::istream> _input;
+        shared_input_buffer _buffer;
+        std::vector<char> _chunk;
+        char const* _pos;
+        char const* _end;
+        bool _eof;
         bool _allow_comments;
+        bool _track_lines;
         int _line_number;
         shared_origin _line_origin;
-        std::queue<shared_token> _tokens;
+
+        /**
+         * Tokens waiting to be returned. Tokens are only pulled once these have all been
+         * handed out, and each pull queues at most a token and the whitespace before it.
+         */
+        std::array<shared_token, 2> _tokens;
+        std::size_t _tokens_head;
+        std::size_t _tokens_size;
         whitespace_saver _whitespace_saver;
     };
 
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+
+namespace hocon {
+
+    /**
+     * Building blocks for config_value::hash_code. Each kind of value starts from its
+     * own seed, so values that are never equal, like the string "1" and the number 1,
+     * rarely share a hash.
+     */
+    namespace value_hash {
+
+        enum seed : uint64_t {
+            NULL_VALUE = 1,
+            BOOLEAN,
+            NUMBER,
+            STRING,
+            OBJECT,
+            LIST,
+            REFERENCE,
+            CONCATENATION,
+            DELAYED_MERGE,
+            DELAYED_MERGE_OBJECT
+        };
+
+        /** Spreads the bits of x over the whole word (the splitmix64 finalizer). */
+        inline uint64_t mix(uint64_t x) {
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9ull;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111ebull;
+            x ^= x >> 31;
+            return x;
+        }
+
+        /** Folds the next hash of a sequence into the hash so far; the order matters. */
+        inline uint64_t combine(uint64_t hash, uint64_t next) {
+            return mix(hash * 0x9e3779b97f4a7c15ull + next);
+        }
+
+        inline uint64_t of_string(std::string const& s) {
+            return combine(STRING, std::hash<std::string>()(s));
+        }
+
+        inline uint64_t of_bool(bool b) {
+            return combine(BOOLEAN, b ? 1 : 0);
+        }
+
+        /** Hashes a whole number, whether it's held as an int, an int64_t or a double. */
+        inline uint64_t of_number(int64_t whole) {
+            return combine(NUMBER, static_cast<uint64_t>(whole));
+        }
+
+        /** Hashes a number that isn't whole; whole ones go through of_number(int64_t). */
+        inline uint64_t of_number(double fraction) {
+            uint64_t bits;
+            std::memcpy(&bits, &fraction, sizeof(bits));
+            return combine(NUMBER, mix(bits));
+        }
+
+    }  // namespace value_hash
+
+}  // namespace hocon
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <hocon/types.hpp>
+#include <cstdint>
+#include <unordered_map>
+
+namespace hocon {
+
+    /**
+     * Hash-conses resolved values for config::deduplicated. Interning a value first
+     * interns the values inside it, then returns the first value interned that is
+     * interchangeable with the result, so identical subtrees come out as one shared
+     * value. Interchangeable is stricter than operator==: numbers must also have the
+     * same type and text, and strings the same quoting, so that sharing a value never
+     * changes what a getter returns or how the config renders. Since the children of
+     * candidates are already shared, comparing two of them only compares pointers
+     * one level down.
+     */
+    class value_interner {
+    public:
+        /** The shared value equal to value, which may be value itself. */
+        shared_value intern(shared_value const& value);
+
+        /** The number of distinct values interned. */
+        size_t size() const { return _values.size(); }
+
+    private:
+        static uint64_t hash(config_value const& value);
+        static bool interchangeable(config_value const& a, config_value const& b);
+
+        std::unordered_multimap<uint64_t, shared_value> _values;
+    };
+
+}  // namespace hocon
@@ -27,6 +27,7 @@ namespace hocon {
 
         config_value::type value_type() const override;
         std::vector<shared_value> unmerged_values() const override;
+        std::vector<shared_value> const& pieces() const { return _pieces; }
 
         resolve_status get_resolve_status() const override;
 
@@ -38,11 +39,12 @@ namespace hocon {
         static shared_value concatenate(std::vector<shared_value> pieces);
         shared_value relativized(std::string prefix) const override;
 
-        unwrapped_value unwrapped() const override;
+        void accept(config_value_visitor& visitor) const override;
 
         bool operator==(config_value const& other) const override;
 
     protected:
+        uint64_t compute_hash() const override;
         shared_value new_copy(shared_origin origin) const override;
         bool ignores_fallbacks() const override;
         void render(std::string& result, int indent, bool at_root, config_render_options options) const override;
@@ -23,7 +23,7 @@ namespace hocon {
 
         std::vector<shared_value> unmerged_values() const override;
 
-        unwrapped_value unwrapped() const override;
+        void accept(config_value_visitor& visitor) const override;
 
         resolve_result<shared_value> resolve_substitutions(resolve_context const& context, resolve_source const& source) const override;
         static resolve_result<shared_value> resolve_substitutions(std::shared_ptr<const replaceable_merge_stack> replaceable, const std::vector<shared_value>& _stack, resolve_context const& context, resolve_source const& source);
@@ -38,6 +38,7 @@ namespace hocon {
 
 
     protected:
+        uint64_t compute_hash() const override;
         shared_value new_copy(shared_origin) const override;
 
         bool ignores_fallbacks() const override;
@@ -29,7 +29,7 @@ namespace hocon {
         shared_value get(std::string const& key) const override { throw not_resolved(); }
         iterator begin() const override { throw not_resolved(); }
         iterator end() const override { throw not_resolved(); }
-        unwrapped_value unwrapped() const override;
+        void accept(config_value_visitor& visitor) const override;
 
         bool operator==(config_value const& other) const override;
 
@@ -39,8 +39,10 @@ namespace hocon {
 
 
     protected:
+        uint64_t compute_hash() const override;
+        using config_object::attempt_peek_with_partial_resolve;
         shared_value attempt_peek_with_partial_resolve(std::string const& key) const override;
-        std::unordered_map<std::string, shared_value> const& entry_set() const override;
+        persistent_map const& entry_set() const override;
         shared_object without_path(path raw_path) const override;
         shared_object with_only_path(path raw_path) const override;
         shared_object with_only_path_or_null(path raw_path) const override;
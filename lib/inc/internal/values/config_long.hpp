@@ -13,13 +13,14 @@ namespace hocon {
 
         std::string transform_to_string() const override;
 
-        unwrapped_value unwrapped() const override;
+        void accept(config_value_visitor& visitor) const override;
 
         int64_t long_value() const override;
         double double_value() const override;
 
     protected:
         shared_value new_copy(shared_origin) const override;
+        std::string canonical_text() const override;
 
     private:
         int64_t _value;
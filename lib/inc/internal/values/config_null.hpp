@@ -21,11 +21,12 @@ namespace hocon {
         config_value::type value_type() const override;
         std::string transform_to_string() const override;
 
-        unwrapped_value unwrapped() const override;
+        void accept(config_value_visitor& visitor) const override;
 
         bool operator==(config_value const& other) const override;
 
     protected:
+        uint64_t compute_hash() const override;
         shared_value new_copy(shared_origin) const override;
         void render(std::string& result, int indent, bool at_root, config_render_options options) const override;
     };
@@ -3,14 +3,15 @@
 #include <hocon/config_value.hpp>
 #include <internal/simple_config_origin.hpp>
 
+#include <cstdint>
+#include <memory>
 #include <string>
 
 namespace hocon {
 
     class config_number : public config_value {
     public:
-        config_number(shared_origin origin,
-                      std::string original_text);
+        config_number(shared_origin origin);
 
         std::string transform_to_string() const override;
         config_value::type value_type() const override;
@@ -25,14 +26,46 @@ namespace hocon {
 
         int int_value_range_checked(std::string const& path) const;
 
+        /** Whether the number was parsed from text that reads the same as its canonical rendering. */
+        bool has_canonical_text() const;
+
+        /** The text the number was parsed from, or empty if it wasn't parsed. */
+        std::string original_text() const;
+
         static std::shared_ptr<config_number> new_number(
                 shared_origin origin, int64_t value, std::string original_text);
 
         static std::shared_ptr<config_number> new_number(
                 shared_origin origin, double value, std::string original_text);
 
+        /**
+         * Creates a number as if parsed from its canonical text, for values whose text
+         * wasn't kept because has_canonical_text() was true.
+         */
+        static std::shared_ptr<config_number> new_canonical_number(shared_origin origin, int64_t value);
+        static std::shared_ptr<config_number> new_canonical_number(shared_origin origin, double value);
+
     protected:
-        std::string _original_text;
+        uint64_t compute_hash() const override;
+        /**
+         * Records the text the number was parsed from, for transform_to_string. Most
+         * parsed text reads the same as canonical_text() and isn't kept, since it can
+         * be rebuilt from the value; only other spellings, like "1e3" or "007", are.
+         * Call it from the concrete class's constructor, once the value is set.
+         */
+        void set_original_text(std::string text);
+
+        /** The value in the form parsed text usually takes. */
+        virtual std::string canonical_text() const = 0;
+
+        /** Whether text reads the same as canonical_text(). */
+        virtual bool is_canonical(std::string const& text) const;
+
+    private:
+        enum class text_form : uint8_t { NONE, CANONICAL, STORED };
+
+        std::unique_ptr<const std::string> _stored_text;
+        text_form _text_form;
     };
 
 }  // namespace hocon
@@ -19,13 +19,17 @@ namespace hocon {
         type value_type() const override;
         std::vector<shared_value> unmerged_values() const override;
         resolve_status get_resolve_status() const override;
-        unwrapped_value unwrapped() const override;
+        void accept(config_value_visitor& visitor) const override;
 
         std::shared_ptr<substitution_expression> expression() const;
 
+        /** How many elements of the expression's path were prepended when it was relativized. */
+        int prefix_length() const { return _prefix_length; }
+
         bool operator==(config_value const& other) const override;
 
     protected:
+        uint64_t compute_hash() const override;
         shared_value new_copy(shared_origin origin) const override;
         resolve_result<shared_value> resolve_substitutions(resolve_context const& context, resolve_source const& source) const override;
         bool ignores_fallbacks() const override { return false; }
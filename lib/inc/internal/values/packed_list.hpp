@@ -0,0 +1,94 @@
+#pragma once
+
+#include <hocon/config_value.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hocon {
+
+    /** How packed containers hold a scalar value. */
+    enum class packed_scalar : uint8_t { BOOLEAN, INT, LONG, DOUBLE, UNPACKABLE };
+
+    /**
+     * Classifies a value for packing. Numbers are packable when their class is the one
+     * parsing gives their value, since unpacking picks the class the same way, and when
+     * their text is known. Anything but a boolean or such a number is UNPACKABLE.
+     */
+    packed_scalar classify_scalar(shared_value const& value);
+
+    /**
+     * The elements of a parsed list that holds only numbers, or only booleans, stored
+     * as plain values rather than as one config_value each.
+     *
+     * The values can be unpacked back into config_values that render and compare as
+     * the parsed ones did. Origins are kept as runs, since the elements of a list
+     * usually share a line or a few, and the text of a number is kept only when it
+     * differs from the value's canonical rendering.
+     */
+    class packed_list {
+    public:
+        enum class kind : uint8_t {
+            /** Every element is an int, held in longs(). */
+            INT,
+            /** Every element is an int or, when out of int's range, an int64_t, held in longs(). */
+            LONG,
+            /** Every element is a double, held in doubles(). */
+            DOUBLE,
+            /** Elements are ints or doubles, held in doubles(); whole values are ints or int64_ts. */
+            NUMBER,
+            /** Every element is a bool, held in booleans(). */
+            BOOLEAN
+        };
+
+        /**
+         * Packs values if they are all numbers or all booleans and can be unpacked as
+         * they are; otherwise returns nullptr.
+         */
+        static std::shared_ptr<const packed_list> pack(std::vector<shared_value> const& values);
+
+        kind element_kind() const { return _kind; }
+        size_t size() const { return _size; }
+
+        std::vector<int64_t> const& longs() const { return _longs; }
+        std::vector<double> const& doubles() const { return _doubles; }
+        std::vector<bool> const& booleans() const { return _booleans; }
+
+        /** Creates a config_value for each element. */
+        std::vector<shared_value> unpack() const;
+
+        /** Visits the list as its elements would be visited, without creating them. */
+        void accept(config_value_visitor& visitor) const;
+
+        /** Folds the hash_code() each element would have into hash, in order. */
+        uint64_t hash_elements(uint64_t hash) const;
+
+        /** Whether other holds the same kind of values with the same values, whatever their text. */
+        bool same_values(packed_list const& other) const;
+
+        /** Whether other holds the same values written the same way, so its elements render alike. */
+        bool same_text(packed_list const& other) const;
+
+    private:
+        struct origin_run {
+            size_t first;
+            shared_origin origin;
+        };
+
+        packed_list(kind k, size_t size);
+
+        kind _kind;
+        size_t _size;
+        std::vector<int64_t> _longs;
+        std::vector<double> _doubles;
+        std::vector<bool> _booleans;
+        std::vector<origin_run> _origins;
+
+        /** The parsed text of the numbers that don't read as their canonical text, by index. */
+        std::vector<std::pair<size_t, std::string>> _texts;
+    };
+
+}  // namespace hocon
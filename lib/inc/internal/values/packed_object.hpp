@@ -0,0 +1,70 @@
+#pragma once
+
+#include <hocon/config_value.hpp>
+#include <hocon/persistent_map.hpp>
+#include <internal/symbol_table.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hocon {
+
+    /**
+     * The fields of a parsed object, with each boolean, number, null and string held
+     * inline in its field's slot as a tagged value rather than as a config_value of
+     * its own. Other values, such as nested objects and lists, are held as they are.
+     *
+     * The fields can be unpacked into a map of config_values that render and compare
+     * as the parsed ones did. As in packed_list, the text of a number is kept only when
+     * it differs from the value's canonical rendering.
+     */
+    class packed_object {
+    public:
+        /**
+         * Packs fields if at least one of them is a scalar that can be held inline;
+         * otherwise returns nullptr.
+         */
+        static std::shared_ptr<const packed_object> pack(std::unordered_map<std::string, shared_value> const& fields);
+
+        size_t size() const { return _slots.size(); }
+
+        /** Whether any field is unresolved; scalars never are. */
+        resolve_status get_resolve_status() const { return _resolved; }
+
+        /** Creates a config_value for each scalar field and returns the fields as a map. */
+        persistent_map unpack() const;
+
+    private:
+        enum class tag : uint8_t { VALUE, NULL_VALUE, BOOLEAN, WHOLE, DOUBLE, QUOTED_STRING, UNQUOTED_STRING };
+
+        /** A field. The origin is only set for scalars; other values carry their own. */
+        struct slot {
+            symbol_ref key;
+            shared_origin origin;
+            union {
+                int64_t whole;
+                double real;
+                bool boolean;
+                /** Where the value is in _values, or a string in _strings. */
+                uint32_t index;
+            };
+            tag kind;
+        };
+
+        packed_object() = default;
+
+        std::vector<slot> _slots;
+        std::vector<shared_value> _values;
+        std::vector<std::string> _strings;
+
+        /** The parsed text of the numbers that don't read as their canonical text, by slot. */
+        std::vector<std::pair<size_t, std::string>> _texts;
+
+        resolve_status _resolved = resolve_status::RESOLVED;
+    };
+
+}  // namespace hocon
@@ -5,8 +5,10 @@
 #include <hocon/config_render_options.hpp>
 #include <hocon/config_exception.hpp>
 #include <internal/container.hpp>
+#include <internal/values/packed_list.hpp>
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <boost/optional.hpp>
 
@@ -16,6 +18,22 @@ namespace hocon {
     public:
         simple_config_list(shared_origin origin, std::vector<shared_value> value);
         simple_config_list(shared_origin origin, std::vector<shared_value> value, resolve_status status);
+        simple_config_list(shared_origin origin, std::shared_ptr<const packed_list> packed);
+
+        /** Creates the list of head's elements followed by tail's, without copying either yet. */
+        simple_config_list(shared_origin origin, std::shared_ptr<const simple_config_list> head,
+                           std::shared_ptr<const simple_config_list> tail);
+
+        /** Creates a list of other's elements with a different origin, sharing them with other. */
+        simple_config_list(shared_origin origin, simple_config_list const& other);
+
+        /**
+         * Creates a list for values the parser read from a list literal. When they are all
+         * numbers of one kind or all booleans, it holds them packed, and only creates a
+         * config_value for each element when something asks for the elements.
+         */
+        static std::shared_ptr<const simple_config_list> new_literal(shared_origin origin,
+                                                                     std::vector<shared_value> values);
 
         config_value::type value_type() const override { return config_value::type::LIST; }
         resolve_status get_resolve_status() const override { return _resolved; }
@@ -25,33 +43,40 @@ namespace hocon {
 
         shared_value relativized(const std::string prefix) const override;
 
-        bool contains(shared_value v) const { return std::find(_value.begin(), _value.end(), v) != _value.end(); }
+        bool contains(shared_value v) const { return std::find(begin(), end(), v) != end(); }
         bool contains_all(std::vector<shared_value>) const;
 
         int index_of(shared_value v) {
-            auto pos = find(_value.begin(), _value.end(), v);
-            if (pos == _value.end()) {
+            auto pos = find(begin(), end(), v);
+            if (pos == end()) {
                 return -1;
             } else {
-                return pos - _value.begin();
+                return pos - begin();
             }
         }
 
         // list interface
-        bool is_empty() const override { return _value.empty(); }
-        size_t size() const override { return _value.size(); }
-        shared_value operator[](size_t index) const override { return _value.at(index); }
-        shared_value get(size_t index) const override { return _value.at(index); }
-        iterator begin() const override { return _value.begin(); }
-        iterator end() const override { return _value.end(); }
+        bool is_empty() const override { return size() == 0; }
+        size_t size() const override { return _size; }
+        shared_value operator[](size_t index) const override { return elements().at(index); }
+        shared_value get(size_t index) const override { return elements().at(index); }
+        iterator begin() const override { return elements().begin(); }
+        iterator end() const override { return elements().end(); }
+
+        /**
+         * The packed elements, or nullptr if the list holds config_values. A packed list
+         * lets go of them once something has asked for its elements.
+         */
+        std::shared_ptr<const packed_list> packed() const { return std::atomic_load(&_packed); }
 
         std::shared_ptr<const simple_config_list> concatenate(std::shared_ptr<const simple_config_list> other) const;
 
-        unwrapped_value unwrapped() const override;
+        void accept(config_value_visitor& visitor) const override;
 
         bool operator==(config_value const& other) const override;
 
     protected:
+        uint64_t compute_hash() const override;
         resolve_result<shared_value>
             resolve_substitutions(resolve_context const& context, resolve_source const& source) const override;
         shared_value new_copy(shared_origin origin) const override;
@@ -60,7 +85,31 @@ namespace hocon {
 
     private:
         static const long _serial_version_UID = 2L;
-        const std::vector<shared_value> _value;
+
+        using shared_elements = std::shared_ptr<const std::vector<shared_value>>;
+
+        /**
+         * The elements, built on first use when the list was created from packed values
+         * or as a concatenation.
+         */
+        std::vector<shared_value> const& elements() const;
+
+        /** Copies the elements of a concatenation, walking nested ones without building theirs. */
+        std::vector<shared_value> flatten() const;
+
+        // Lists are immutable, so copies with another origin share the elements. Until they
+        // are built, a list holds whichever of packed values or the two concatenated lists
+        // it was created from, and lets go of them once the elements are built. They may
+        // change while other threads read them, so they're read and written atomically,
+        // the elements being set before the others are cleared.
+        mutable std::shared_ptr<const packed_list> _packed;
+        mutable std::shared_ptr<const simple_config_list> _head;
+        mutable std::shared_ptr<const simple_config_list> _tail;
+        mutable shared_elements _value;
+        const size_t _size;
+        // Whether the elements are built on first use, rather than given when created
+        const bool _built_on_use;
+        mutable std::once_flag _built;
         const resolve_status _resolved;
 
         std::shared_ptr<const simple_config_list>
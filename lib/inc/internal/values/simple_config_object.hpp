@@ -1,38 +1,50 @@
 #pragma once
 
 #include <internal/container.hpp>
+#include <internal/values/packed_object.hpp>
 #include <hocon/config_object.hpp>
 #include <hocon/config_value.hpp>
 #include <hocon/config.hpp>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace hocon {
 
     class simple_config_object : public config_object, public container {
     public:
-        simple_config_object(shared_origin origin, std::unordered_map<std::string, shared_value> value,
+        simple_config_object(shared_origin origin, persistent_map value,
                              resolve_status status, bool ignores_fallbacks);
 
-        simple_config_object(shared_origin origin, std::unordered_map<std::string, shared_value> value);
+        simple_config_object(shared_origin origin, persistent_map value);
+
+        /** An object whose fields are built from packed on first use. */
+        simple_config_object(shared_origin origin, std::shared_ptr<const packed_object> packed);
+
+        /**
+         * Creates a parsed object. Its scalar fields are held packed, and their values
+         * are only created once the object's fields are read.
+         */
+        static std::shared_ptr<const simple_config_object> new_literal(
+                shared_origin origin, std::unordered_map<std::string, shared_value> const& fields);
+
+        /** The packed fields, until the object's fields are built from them. */
+        std::shared_ptr<const packed_object> packed() const { return std::atomic_load(&_packed); }
 
         shared_value attempt_peek_with_partial_resolve(std::string const& key) const override;
+        shared_value attempt_peek_with_partial_resolve(symbol const& key) const override;
 
         // map interface
-        bool is_empty() const override { return _value.empty(); }
-        size_t size() const override { return _value.size(); }
-        shared_value operator[](std::string const& key) const override { return _value.at(key); }
-        iterator begin() const override { return _value.begin(); }
-        iterator end() const override { return _value.end(); }
-        unwrapped_value unwrapped() const override;
-
-        shared_value get(std::string const& key) const override {
-            if (_value.find(key) == _value.end()) {
-                return nullptr;
-            }
-            return _value.at(key);
-        }
-
-        std::unordered_map<std::string, shared_value> const& entry_set() const override;
+        bool is_empty() const override { return _size == 0; }
+        size_t size() const override { return _size; }
+        shared_value operator[](std::string const& key) const override { return entries().at(key); }
+        iterator begin() const override { return entries().begin(); }
+        iterator end() const override { return entries().end(); }
+        void accept(config_value_visitor& visitor) const override;
+
+        shared_value get(std::string const& key) const override { return entries().get(key); }
+
+        persistent_map const& entry_set() const override;
 
         resolve_status get_resolve_status() const override { return _resolved; }
         bool ignores_fallbacks() const override { return _ignores_fallbacks; }
@@ -76,7 +88,7 @@ namespace hocon {
          * Construct a list of the values from the provided map.
          * Equivalent to Java's Collection.values() method.
          */
-        std::vector<shared_value> value_set(std::unordered_map<std::string, shared_value> m) const;
+        std::vector<shared_value> value_set(persistent_map const& m) const;
 
         bool operator==(config_value const& other) const override;
 
@@ -85,13 +97,21 @@ namespace hocon {
         static std::shared_ptr<simple_config_object> empty_instance();
 
     protected:
+        uint64_t compute_hash() const override;
         resolve_result<shared_value>
             resolve_substitutions(resolve_context const& context, resolve_source const& source) const override;
         shared_value new_copy(shared_origin) const override;
         void render(std::string& s, int indent, bool at_root, config_render_options options) const override;
 
     private:
-        std::unordered_map<std::string, shared_value> _value;
+        /** The fields, which a packed object builds from _packed on first use. */
+        persistent_map const& entries() const;
+
+        mutable persistent_map _value;
+        mutable std::shared_ptr<const packed_object> _packed;
+        size_t _size;
+        bool const _built_on_use;
+        mutable std::once_flag _built;
         resolve_status _resolved;
         bool _ignores_fallbacks;
 
@@ -99,7 +119,14 @@ namespace hocon {
         std::shared_ptr<simple_config_object> modify(no_exceptions_modifier& modifier) const;
         std::shared_ptr<simple_config_object> modify_may_throw(modifier& modifier) const;
 
-        static resolve_status resolve_status_from_value(const std::unordered_map<std::string, shared_value>& value);
+        static resolve_status resolve_status_from_value(persistent_map const& value);
+
+        /**
+         * The status of a map made by binding values into one whose status was base_status.
+         * Only when a replaced value was the unresolved one do the rest need checking.
+         */
+        static resolve_status updated_resolve_status(resolve_status base_status, bool added_unresolved,
+                                                     bool replaced_unresolved, persistent_map const& updated);
 
         struct resolve_modifier;
     };
@@ -0,0 +1,13 @@
+#include <hocon/compiled_path.hpp>
+
+using namespace std;
+
+namespace hocon {
+
+    compiled_path::compiled_path(string expression) :
+            _expression(move(expression)), _path(path::new_path(_expression)) { }
+
+    compiled_path::compiled_path(path parsed) :
+            _expression(parsed.render()), _path(move(parsed)) { }
+
+}  // namespace hocon
@@ -3,7 +3,11 @@
 #include <hocon/config_list.hpp>
 #include <hocon/config_exception.hpp>
 #include <internal/default_transformer.hpp>
+#include <internal/frozen_index.hpp>
+#include <internal/lazy_resolver.hpp>
 #include <internal/resolve_context.hpp>
+#include <internal/resolve_record.hpp>
+#include <internal/value_interner.hpp>
 #include <internal/values/config_boolean.hpp>
 #include <internal/values/config_null.hpp>
 #include <internal/values/config_number.hpp>
@@ -11,16 +15,18 @@
 #include <internal/values/config_long.hpp>
 #include <internal/values/config_int.hpp>
 #include <internal/values/config_string.hpp>
+#include <internal/values/simple_config_list.hpp>
 #include <internal/values/simple_config_object.hpp>
 #include <internal/parseable.hpp>
 #include <internal/simple_includer.hpp>
+#include <internal/config_util.hpp>
 
-#include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string/trim.hpp>
 #include <leatherman/util/environment.hpp>
 #include <leatherman/locale/locale.hpp>
 
 #include <cfenv>
+#include <cmath>
 
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
@@ -50,7 +56,19 @@ namespace hocon {
 
     config::config(shared_object object) : _object(move(object)) { }
 
+    config::config(shared_object object, shared_ptr<const frozen_index> index) :
+            _object(move(object)), _index(move(index)) { }
+
+    config::config(shared_object object, shared_ptr<const resolve_record> record) :
+            _object(move(object)), _record(move(record)) { }
+
+    config::config(shared_object object, shared_ptr<const lazy_resolver> lazy) :
+            _object(move(object)), _lazy(move(lazy)) { }
+
     shared_object config::root() const {
+        if (_lazy) {
+            return _lazy->resolved();
+        }
         return _object;
     }
 
@@ -63,25 +81,92 @@ namespace hocon {
     }
 
     shared_config config::resolve(config_resolve_options options) const {
+        if (_lazy) {
+            // The options may differ from the lazy config's, so its memos can't be
+            // reused; resolve its source as if this config had never been resolved
+            return make_shared<config>(_object)->resolve(move(options));
+        }
+        if (options.get_incremental()) {
+            auto record = resolve_record::record(move(options), _object);
+            return shared_config(new config(record->result(), record));
+        }
+        if (options.get_lazy() && _object->get_resolve_status() != resolve_status::RESOLVED) {
+            return shared_config(new config(_object, make_shared<lazy_resolver>(_object, move(options))));
+        }
         return resolve_with(shared_from_this(), move(options));
     }
 
+    shared_config config::resolve_incrementally(shared_config previous) const {
+        if (!previous->_record) {
+            return resolve(config_resolve_options().set_incremental(true));
+        }
+        auto record = previous->_record->update(_object);
+        return shared_config(new config(record->result(), record));
+    }
+
     shared_config config::resolve_with(shared_config source) const {
         return resolve_with(source, config_resolve_options());
     }
 
     shared_config config::resolve_with(shared_config source, config_resolve_options options) const {
-        auto resolved = resolve_context::resolve(_object, source->_object, move(options));
+        auto object = root();
+        auto resolved = resolve_context::resolve(object, source->root(), move(options));
 
-        if (resolved == _object) {
+        if (resolved == object) {
             return shared_from_this();
         } else {
             return make_shared<config>(dynamic_pointer_cast<const config_object>(resolved));
         }
     }
 
-    shared_value config::has_path_peek(string const& path_expression) const {
-        path raw_path = path::new_path(path_expression);
+    compiled_path config::compile_path(string const& path) {
+        return compiled_path(path);
+    }
+
+    compiled_path config::compiled(string const& path_expression) const {
+        if (_index) {
+            if (auto indexed = _index->find_expression(path_expression)) {
+                return *indexed;
+            }
+        }
+        return compiled_path(path_expression);
+    }
+
+    shared_config config::freeze() const {
+        if (_index) {
+            return shared_config(new config(_object, _index));
+        }
+        // A lazy config is resolved in full here, throwing what that throws
+        auto object = root();
+        if (object->get_resolve_status() != resolve_status::RESOLVED) {
+            throw config_exception(_("config has not been resolved, you need to call config::resolve() before config::freeze()"));
+        }
+        return shared_config(new config(object, make_shared<frozen_index>(object)));
+    }
+
+    bool config::is_frozen() const {
+        return _index != nullptr;
+    }
+
+    shared_config config::deduplicated() const {
+        auto object = root();
+        if (object->get_resolve_status() != resolve_status::RESOLVED) {
+            throw config_exception(_("config has not been resolved, you need to call config::resolve() before config::deduplicated()"));
+        }
+        value_interner interner;
+        return make_shared<config>(dynamic_pointer_cast<const config_object>(interner.intern(object)));
+    }
+
+    shared_value config::has_path_peek(compiled_path const& compiled) const {
+        path const& raw_path = compiled.get_path();
+        if (_index) {
+            if (auto indexed = _index->find(raw_path)) {
+                return indexed;
+            }
+        }
+        if (_lazy) {
+            return _lazy->resolve_path(raw_path)->peek_path(raw_path);
+        }
         shared_value peeked;
         try {
             peeked = _object->peek_path(raw_path);
@@ -95,17 +180,25 @@ namespace hocon {
     }
 
     bool config::has_path(string const& path_expression) const {
-        shared_value peeked = has_path_peek(path_expression);
+        return has_path(compiled(path_expression));
+    }
+
+    bool config::has_path(compiled_path const& path) const {
+        shared_value peeked = has_path_peek(path);
         return peeked && peeked->value_type() != config_value::type::CONFIG_NULL;
     }
 
     bool config::has_path_or_null(string const& path) const {
+        return has_path_or_null(compiled(path));
+    }
+
+    bool config::has_path_or_null(compiled_path const& path) const {
         shared_value peeked = has_path_peek(path);
         return peeked != nullptr;
     }
 
     bool config::is_empty() const {
-        return _object->is_empty();
+        return root()->is_empty();
     }
 
     void config::find_paths(set<pair<string, shared_ptr<const config_value>>>& entries, path parent,
@@ -129,11 +222,11 @@ namespace hocon {
 
     set<pair<string, shared_ptr<const config_value>>> config::entry_set() const {
         set<pair<string, shared_ptr<const config_value>>> entries;
-        find_paths(entries, path(), _object);
+        find_paths(entries, path(), root());
         return entries;
     }
 
-    shared_value config::throw_if_null(shared_value v, config_value::type expected, path original_path) {
+    shared_value config::throw_if_null(shared_value v, config_value::type expected, path const& original_path) {
         if (v->value_type() == config_value::type::CONFIG_NULL) {
             // TODO Once we decide on a way of converting the type enum to a string, pass expected type string
             throw null_exception(*(v->origin()), original_path.render());
@@ -142,18 +235,21 @@ namespace hocon {
         }
     }
 
-    shared_value config::find_key(shared_object self, string const& key, config_value::type expected,
-                                         path original_path) {
+    shared_value config::find_key(shared_object const& self, symbol const& key, config_value::type expected,
+                                         path const& original_path) {
         return throw_if_null(find_key_or_null(self, key, expected, original_path), expected, original_path);
     }
 
-    shared_value config::find_key_or_null(shared_object self, string const& key, config_value::type expected,
-                                                 path original_path) {
+    shared_value config::find_key_or_null(shared_object const& self, symbol const& key, config_value::type expected,
+                                                 path const& original_path) {
         shared_value v = self->peek_assuming_resolved(key, original_path);
         if (!v) {
             throw missing_exception(original_path.render());
         }
+        return convert_value(v, expected, original_path);
+    }
 
+    shared_value config::convert_value(shared_value v, config_value::type expected, path const& original_path) {
         if (expected != config_value::type::UNSPECIFIED) {
             v = default_transformer::transform(v, expected);
         }
@@ -167,10 +263,10 @@ namespace hocon {
         }
     }
 
-    shared_value config::find_or_null(shared_object self, path desired_path,
-                                             config_value::type expected, path original_path) {
+    shared_value config::find_or_null(shared_object const& self, path const& desired_path,
+                                             config_value::type expected, path const& original_path) {
         try {
-            string key = *desired_path.first();
+            symbol const& key = *desired_path.element(0);
             path next = desired_path.remainder();
             if (next.empty()) {
                 return find_key_or_null(self, key, expected, original_path);
@@ -199,76 +295,177 @@ namespace hocon {
     }
 
     bool config::get_is_null(string const& path_expression) const {
-        shared_value v = find_or_null(path_expression, config_value::type::UNSPECIFIED);
-        return v->value_type() == config_value::type::CONFIG_NULL;
+        return get_is_null(compiled(path_expression));
     }
 
     shared_value config::get_value(string const& path_expression) const {
-        return find(path_expression, config_value::type::UNSPECIFIED);
+        return get_value(compiled(path_expression));
     }
 
     bool config::get_bool(string const& path_expression) const {
-        shared_value v = find(path_expression, config_value::type::BOOLEAN);
-        return dynamic_pointer_cast<const config_boolean>(v)->bool_value();
+        return get_bool(compiled(path_expression));
     }
 
     int config::get_int(string const& path_expression) const {
-        shared_value v = find(path_expression, config_value::type::NUMBER);
-        return dynamic_pointer_cast<const config_number>(v)->int_value_range_checked(path_expression);
+        return get_int(compiled(path_expression));
     }
 
     int64_t config::get_long(string const& path_expression) const {
-        shared_value v = find(path_expression, config_value::type::NUMBER);
-        return dynamic_pointer_cast<const config_number>(v)->long_value();
+        return get_long(compiled(path_expression));
     }
 
     double config::get_double(string const& path_expression) const {
-        shared_value v = find(path_expression, config_value::type::NUMBER);
-        return dynamic_pointer_cast<const config_number>(v)->double_value();
+        return get_double(compiled(path_expression));
     }
 
     string config::get_string(string const& path_expression) const {
-        shared_value v = find(path_expression, config_value::type::STRING);
-        return dynamic_pointer_cast<const config_string>(v)->transform_to_string();
+        return get_string(compiled(path_expression));
     }
 
     shared_ptr<const config_object> config::get_object(string const& path_expression) const {
-        return dynamic_pointer_cast<const config_object>(find(path_expression, config_value::type::OBJECT));
+        return get_object(compiled(path_expression));
     }
 
     unwrapped_value config::get_any_ref(string const& path_expression) const {
-        return find(path_expression, config_value::type::UNSPECIFIED)->unwrapped();
+        return get_any_ref(compiled(path_expression));
     }
 
     shared_config config::get_config(string const& path_expression) const {
-        return get_object(path_expression)->to_config();
+        return get_config(compiled(path_expression));
     }
 
     shared_list config::get_list(string const& path_expression) const {
-        return dynamic_pointer_cast<const config_list>(find(path_expression, config_value::type::LIST));
+        return get_list(compiled(path_expression));
     }
 
     vector<bool> config::get_bool_list(string const& path) const {
-        return get_homogeneous_unwrapped_list<bool>(path);
+        return get_bool_list(compiled(path));
     }
 
     std::vector<int> config::get_int_list(std::string const& path) const {
-        return get_homogeneous_unwrapped_list<int>(path);
+        return get_int_list(compiled(path));
     }
 
     std::vector<int64_t> config::get_long_list(std::string const& path) const {
-        return get_homogeneous_unwrapped_list<int64_t>(path);
+        return get_long_list(compiled(path));
     }
 
     std::vector<double> config::get_double_list(std::string const& path) const {
-        return get_homogeneous_unwrapped_list<double>(path);
+        return get_double_list(compiled(path));
     }
 
     std::vector<std::string> config::get_string_list(std::string const& path) const {
-        return get_homogeneous_unwrapped_list<string>(path);
+        return get_string_list(compiled(path));
     }
 
     std::vector<shared_object> config::get_object_list(std::string const& path) const {
+        return get_object_list(compiled(path));
+    }
+
+    std::vector<shared_config> config::get_config_list(std::string const& path) const {
+        return get_config_list(compiled(path));
+    }
+
+    bool config::get_is_null(compiled_path const& path) const {
+        shared_value v = find_or_null(path.get_path(), config_value::type::UNSPECIFIED, path.get_path());
+        return v->value_type() == config_value::type::CONFIG_NULL;
+    }
+
+    shared_value config::get_value(compiled_path const& path) const {
+        return find(path.get_path(), config_value::type::UNSPECIFIED, path.get_path());
+    }
+
+    bool config::get_bool(compiled_path const& path) const {
+        shared_value v = find(path.get_path(), config_value::type::BOOLEAN, path.get_path());
+        return dynamic_pointer_cast<const config_boolean>(v)->bool_value();
+    }
+
+    int config::get_int(compiled_path const& path) const {
+        shared_value v = find(path.get_path(), config_value::type::NUMBER, path.get_path());
+        return dynamic_pointer_cast<const config_number>(v)->int_value_range_checked(path.expression());
+    }
+
+    int64_t config::get_long(compiled_path const& path) const {
+        shared_value v = find(path.get_path(), config_value::type::NUMBER, path.get_path());
+        return dynamic_pointer_cast<const config_number>(v)->long_value();
+    }
+
+    double config::get_double(compiled_path const& path) const {
+        shared_value v = find(path.get_path(), config_value::type::NUMBER, path.get_path());
+        return dynamic_pointer_cast<const config_number>(v)->double_value();
+    }
+
+    string config::get_string(compiled_path const& path) const {
+        shared_value v = find(path.get_path(), config_value::type::STRING, path.get_path());
+        return dynamic_pointer_cast<const config_string>(v)->transform_to_string();
+    }
+
+    shared_ptr<const config_object> config::get_object(compiled_path const& path) const {
+        return dynamic_pointer_cast<const config_object>(find(path.get_path(), config_value::type::OBJECT, path.get_path()));
+    }
+
+    unwrapped_value config::get_any_ref(compiled_path const& path) const {
+        return find(path.get_path(), config_value::type::UNSPECIFIED, path.get_path())->unwrapped();
+    }
+
+    shared_config config::get_config(compiled_path const& path) const {
+        return get_object(path)->to_config();
+    }
+
+    shared_list config::get_list(compiled_path const& path) const {
+        return dynamic_pointer_cast<const config_list>(find(path.get_path(), config_value::type::LIST, path.get_path()));
+    }
+
+    /** The list's elements if the parser packed them, otherwise nullptr. */
+    static shared_ptr<const packed_list> packed_elements(shared_list const& list) {
+        auto simple = dynamic_pointer_cast<const simple_config_list>(list);
+        return simple ? simple->packed() : nullptr;
+    }
+
+    // The typed list getters copy packed elements straight out, and otherwise unwrap each element
+
+    vector<bool> config::get_bool_list(compiled_path const& path) const {
+        auto list = get_list(path);
+        auto packed = packed_elements(list);
+        if (packed && packed->element_kind() == packed_list::kind::BOOLEAN) {
+            return packed->booleans();
+        }
+        return unwrapped_list<bool>(list);
+    }
+
+    std::vector<int> config::get_int_list(compiled_path const& path) const {
+        auto list = get_list(path);
+        auto packed = packed_elements(list);
+        if (packed && packed->element_kind() == packed_list::kind::INT) {
+            return vector<int>(packed->longs().begin(), packed->longs().end());
+        }
+        return unwrapped_list<int>(list);
+    }
+
+    std::vector<int64_t> config::get_long_list(compiled_path const& path) const {
+        auto list = get_list(path);
+        auto packed = packed_elements(list);
+        if (packed && (packed->element_kind() == packed_list::kind::INT ||
+                       packed->element_kind() == packed_list::kind::LONG)) {
+            return packed->longs();
+        }
+        return unwrapped_list<int64_t>(list);
+    }
+
+    std::vector<double> config::get_double_list(compiled_path const& path) const {
+        auto list = get_list(path);
+        auto packed = packed_elements(list);
+        if (packed && packed->element_kind() == packed_list::kind::DOUBLE) {
+            return packed->doubles();
+        }
+        return unwrapped_list<double>(list);
+    }
+
+    std::vector<std::string> config::get_string_list(compiled_path const& path) const {
+        return get_homogeneous_unwrapped_list<string>(path);
+    }
+
+    std::vector<shared_object> config::get_object_list(compiled_path const& path) const {
         auto list = get_list(path);
         vector<shared_object> object_list;
         for (auto item : *list) {
@@ -281,7 +478,7 @@ namespace hocon {
         return object_list;
     }
 
-    std::vector<shared_config> config::get_config_list(std::string const& path) const {
+    std::vector<shared_config> config::get_config_list(compiled_path const& path) const {
         auto list = get_list(path);
         vector<shared_config> object_list;
         for (auto item : *list) {
@@ -295,10 +492,15 @@ namespace hocon {
     }
 
     template<>
-    std::vector<int64_t> config::get_homogeneous_unwrapped_list(std::string const& path) const {
-        auto list = boost::get<std::vector<unwrapped_value>>(get_list(path)->unwrapped());
+    std::vector<int64_t> config::get_homogeneous_unwrapped_list(compiled_path const& path) const {
+        return unwrapped_list<int64_t>(get_list(path));
+    }
+
+    template<>
+    std::vector<int64_t> config::unwrapped_list(shared_list const& list) {
+        auto values = boost::get<std::vector<unwrapped_value>>(list->unwrapped());
         std::vector<int64_t> long_list;
-        for (auto item : list) {
+        for (auto item : values) {
             // Even if the parser stored the number as an int, we want to treat it as a long.
             try {
                 long_list.push_back(boost::get<int64_t>(item));
@@ -313,7 +515,7 @@ namespace hocon {
         return long_list;
     }
 
-    duration config::get_duration(string const& path) const {
+    duration config::get_duration(compiled_path const& path) const {
         auto v = get_value(path);
         if (auto d = dynamic_pointer_cast<const config_double>(v)) {
             return convert(d->double_value(), time_unit::MILLISECONDS);
@@ -322,13 +524,18 @@ namespace hocon {
         } else if (auto i = dynamic_pointer_cast<const config_int>(v)) {
             return convert(i->long_value(), time_unit::MILLISECONDS);
         } else if (auto str = dynamic_pointer_cast<const config_string>(v)) {
-            return parse_duration(str->transform_to_string(), str->origin(), path);
+            return parse_duration(str->transform_to_string(), str->origin(), path.expression());
         } else {
-            throw bad_value_exception(*v->origin(), path, _("Value at '{1}' was not a number or string.", path));
+            throw bad_value_exception(*v->origin(), path.expression(),
+                                      _("Value at '{1}' was not a number or string.", path.expression()));
         }
     }
 
     int64_t config::get_duration(string const& path, time_unit unit) const {
+        return get_duration(compiled(path), unit);
+    }
+
+    int64_t config::get_duration(compiled_path const& path, time_unit unit) const {
         auto timespan = get_duration(path);
         int64_t result = 0;
         switch (unit) {
@@ -474,26 +681,23 @@ namespace hocon {
             unit_string += "s";
         }
 
-        try {
-            int64_t number = boost::lexical_cast<int64_t>(number_string);
-            return convert(number, get_units(unit_string));
-        } catch (boost::bad_lexical_cast& ex) {
-            try {
-                double number = boost::lexical_cast<double>(number_string);
-                return convert(number, get_units(unit_string));
-            }
-            catch (boost::bad_lexical_cast& ex) {
-                throw bad_value_exception(*origin_for_exception, path_for_exception, _("Value '{1}' could not be converted to a number.", number_string));
-            }
+        int64_t long_number;
+        if (parse_int64(number_string, long_number)) {
+            return convert(long_number, get_units(unit_string));
         }
+        double double_number;
+        if (parse_double(number_string, double_number)) {
+            return convert(double_number, get_units(unit_string));
+        }
+        throw bad_value_exception(*origin_for_exception, path_for_exception, _("Value '{1}' could not be converted to a number.", number_string));
     }
 
     shared_value config::to_fallback_value() const {
-        return _object;
+        return root();
     }
 
     shared_ptr<const config_mergeable> config::with_fallback(shared_ptr<const config_mergeable> other) const {
-        if (auto newobj = dynamic_pointer_cast<const config_object>(_object->with_fallback(other))) {
+        if (auto newobj = dynamic_pointer_cast<const config_object>(root()->with_fallback(other))) {
             return newobj->to_config();
         } else {
             throw bug_or_broken_exception(_("Creating new object from config_object did not return a config_object"));
@@ -501,7 +705,9 @@ namespace hocon {
     }
 
     bool config::operator==(config const &other) const {
-        return _object == other._object;
+        auto mine = root();
+        auto theirs = other.root();
+        return mine == theirs || *mine == *theirs;
     }
 
     shared_config config::with_value(string const& path_expression, shared_ptr<const config_value> value) const {
@@ -510,7 +716,10 @@ namespace hocon {
     }
 
     bool config::is_resolved() const {
-        return root()->get_resolve_status() == resolve_status::RESOLVED;
+        if (_lazy) {
+            return _lazy->is_resolved();
+        }
+        return _object->get_resolve_status() == resolve_status::RESOLVED;
     }
 
     shared_config config::without_path(string const& path_expression) const {
@@ -549,13 +758,23 @@ namespace hocon {
         return root()->peek_path(desired_path);
     }
 
-    shared_value config::find_or_null(path path_expression, config_value::type expected,
-            path original_path) const {
+    shared_value config::find_or_null(path const& path_expression, config_value::type expected,
+            path const& original_path) const {
+        if (_index) {
+            // Misses walk the tree, which reports exactly where the path went wrong
+            if (auto indexed = _index->find(path_expression)) {
+                return convert_value(indexed, expected, original_path);
+            }
+        }
+        if (_lazy) {
+            return find_or_null(_lazy->resolve_path(path_expression), path_expression, expected, original_path);
+        }
         return find_or_null(_object, path_expression, expected, original_path);
     }
 
-    shared_value config::find(path path_expression, config_value::type expected, path original_path) const {
-        return throw_if_null(find_or_null(_object, path_expression, expected, original_path), expected, original_path);
+    shared_value config::find(path const& path_expression, config_value::type expected,
+                              path const& original_path) const {
+        return throw_if_null(find_or_null(path_expression, expected, original_path), expected, original_path);
     }
 
     shared_object config::env_variables_as_config_object() {
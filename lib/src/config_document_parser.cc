@@ -20,23 +20,26 @@ namespace hocon { namespace config_document_parser {
     shared_ptr<config_node_root> parse(token_iterator tokens, shared_origin origin,
                                                                     config_parse_options options)
     {
-        parse_context context { options.get_syntax(), move(origin), move(tokens) };
+        parse_context context { options.get_syntax(), move(origin), move(tokens), options.get_track_origins() };
         return context.parse();
     }
 
     shared_node_value parse_value(token_iterator tokens, shared_origin origin,
                                                           config_parse_options options)
     {
-        parse_context context { options.get_syntax(), move(origin), move(tokens) };
+        parse_context context { options.get_syntax(), move(origin), move(tokens), options.get_track_origins() };
         return context.parse_single_value();
     }
 
     /** Parse context */
-    parse_context::parse_context(config_syntax flavor, shared_origin origin, token_iterator tokens) :
-        _line_number(1), _tokens(move(tokens)), _flavor(flavor), _base_origin(move(origin)),
-        _equals_count(0) { }
+    parse_context::parse_context(config_syntax flavor, shared_origin origin, token_iterator tokens, bool track_lines) :
+        _line_number(1), _tokens(move(tokens)), _flavor(flavor), _track_lines(track_lines),
+        _base_origin(move(origin)), _equals_count(0) { }
 
     parse_exception parse_context::parse_error(string message) {
+        if (!_track_lines) {
+            return parse_exception(*_base_origin, move(message));
+        }
         return parse_exception(*_base_origin->with_line_number(_line_number), move(message));
     }
 
@@ -10,9 +10,9 @@ using namespace std;
 namespace hocon {
 
     config_parse_options::config_parse_options(shared_string origin_desc,
-            bool allow_missing, shared_includer includer, config_syntax syntax) :
+            bool allow_missing, shared_includer includer, config_syntax syntax, bool track_origins) :
         _syntax(syntax), _origin_description(move(origin_desc)),
-        _allow_missing(allow_missing), _includer(move(includer)) {}
+        _allow_missing(allow_missing), _includer(move(includer)), _track_origins(track_origins) {}
 
     config_parse_options::config_parse_options(): config_parse_options(nullptr, true, nullptr, config_syntax::CONF) {}
 
@@ -22,7 +22,7 @@ namespace hocon {
 
     config_parse_options config_parse_options::set_syntax(config_syntax syntax) const
     {
-        return config_parse_options{_origin_description, _allow_missing, _includer, syntax};
+        return config_parse_options{_origin_description, _allow_missing, _includer, syntax, _track_origins};
     }
 
     config_syntax const& config_parse_options::get_syntax() const
@@ -32,7 +32,7 @@ namespace hocon {
 
     config_parse_options config_parse_options::set_origin_description(shared_string origin_description) const
     {
-        return config_parse_options{move(origin_description), _allow_missing, _includer, _syntax};
+        return config_parse_options{move(origin_description), _allow_missing, _includer, _syntax, _track_origins};
     }
 
 
@@ -52,7 +52,7 @@ namespace hocon {
 
     config_parse_options config_parse_options::set_allow_missing(bool allow_missing) const
     {
-        return config_parse_options{_origin_description, allow_missing, _includer, _syntax};
+        return config_parse_options{_origin_description, allow_missing, _includer, _syntax, _track_origins};
     }
 
     bool config_parse_options::get_allow_missing() const
@@ -62,7 +62,7 @@ namespace hocon {
 
     config_parse_options config_parse_options::set_includer(shared_includer includer) const
     {
-        return config_parse_options{ _origin_description, _allow_missing, move(includer), _syntax};
+        return config_parse_options{ _origin_description, _allow_missing, move(includer), _syntax, _track_origins};
     }
 
     config_parse_options config_parse_options::prepend_includer(shared_includer includer) const
@@ -98,4 +98,14 @@ namespace hocon {
         return _includer;
     }
 
+    config_parse_options config_parse_options::set_track_origins(bool track_origins) const
+    {
+        return config_parse_options{_origin_description, _allow_missing, _includer, _syntax, track_origins};
+    }
+
+    bool config_parse_options::get_track_origins() const
+    {
+        return _track_origins;
+    }
+
 }  // namespace hocon
@@ -3,10 +3,43 @@
 namespace hocon {
 
     config_resolve_options::config_resolve_options(bool use_system_environment, bool allow_unresolved) :
-        _use_system_environment(use_system_environment), _allow_unresovled(allow_unresolved) { }
+        _use_system_environment(use_system_environment), _allow_unresovled(allow_unresolved), _threads(1),
+        _incremental(false), _lazy(false) { }
+
+    config_resolve_options config_resolve_options::set_threads(unsigned value) const {
+        config_resolve_options options = *this;
+        options._threads = value;
+        return options;
+    }
+
+    unsigned config_resolve_options::get_threads() const {
+        return _threads;
+    }
+
+    config_resolve_options config_resolve_options::set_incremental(bool value) const {
+        config_resolve_options options = *this;
+        options._incremental = value;
+        return options;
+    }
+
+    bool config_resolve_options::get_incremental() const {
+        return _incremental;
+    }
+
+    config_resolve_options config_resolve_options::set_lazy(bool value) const {
+        config_resolve_options options = *this;
+        options._lazy = value;
+        return options;
+    }
+
+    bool config_resolve_options::get_lazy() const {
+        return _lazy;
+    }
 
     config_resolve_options config_resolve_options::set_use_system_environment(bool value) const {
-        return config_resolve_options(value, _allow_unresovled);
+        config_resolve_options options = *this;
+        options._use_system_environment = value;
+        return options;
     }
 
     bool config_resolve_options::get_use_system_environment() const {
@@ -14,7 +47,9 @@ namespace hocon {
     }
 
     config_resolve_options config_resolve_options::set_allow_unresolved(bool value) const {
-        return config_resolve_options(_use_system_environment, value);
+        config_resolve_options options = *this;
+        options._allow_unresovled = value;
+        return options;
     }
 
     bool config_resolve_options::get_allow_unresolved() const {
@@ -0,0 +1,789 @@
+#include <internal/config_token_parser.hpp>
+#include <internal/config_document_parser.hpp>
+#include <hocon/config_exception.hpp>
+#include <hocon/config_object.hpp>
+#include <internal/tokens.hpp>
+#include <internal/path_parser.hpp>
+#include <internal/simple_includer.hpp>
+#include <internal/substitution_expression.hpp>
+#include <internal/nodes/config_node_include.hpp>
+#include <internal/nodes/config_node_simple_value.hpp>
+#include <internal/values/config_concatenation.hpp>
+#include <internal/values/config_reference.hpp>
+#include <internal/values/simple_config_object.hpp>
+#include <internal/values/simple_config_list.hpp>
+#include <leatherman/locale/locale.hpp>
+#include <unordered_set>
+
+// Mark string for translation (alias for leatherman::locale::format)
+using leatherman::locale::_;
+
+namespace hocon { namespace config_token_parser {
+    using namespace std;
+
+    using grammar = config_document_parser::parse_context;
+
+    shared_value parse(token_iterator tokens,
+            shared_origin origin,
+            config_parse_options options,
+            shared_include_context include_context)
+    {
+        parse_context context {options.get_syntax(), move(origin), move(tokens),
+                               simple_includer::make_full(options.get_includer()), move(include_context),
+                               options.get_track_origins()};
+        return context.parse();
+    }
+
+    parse_context::container::container(kind k) :
+        type(k), last_was_newline(false), done(false) {}
+
+    parse_context::parse_context(config_syntax flavor, shared_origin origin, token_iterator tokens,
+            shared_ptr<const full_includer> includer, shared_include_context include_context, bool track_origins) :
+        array_count(0), _doc_line_number(1), _line_number(1), _tokens(move(tokens)), _includer(move(includer)),
+        _include_context(move(include_context)), _flavor(flavor), _track_origins(track_origins),
+        _base_origin(move(origin)), _equals_count(0)
+    {}
+
+    parse_exception parse_context::parse_error(string message) {
+        if (!_track_origins) {
+            return parse_exception(*_base_origin, move(message));
+        }
+        return parse_exception(*_base_origin->with_line_number(_doc_line_number), move(message));
+    }
+
+    shared_origin parse_context::line_origin() const {
+        if (!_track_origins) {
+            return _base_origin;
+        }
+        return _base_origin->with_line_number(_line_number);
+    }
+
+    path parse_context::full_current_path() const {
+        // pathStack has top of stack at front
+        if (_path_stack.empty()) {
+            throw bug_or_broken_exception(_("Bug in parser; tried to get current path when at root"));
+        } else {
+            return path {_path_stack.front()};
+        }
+    }
+
+    shared_token parse_context::pop_token() {
+        if (_buffer.empty()) {
+            return _tokens.next();
+        }
+        shared_token top = _buffer.top();
+        _buffer.pop();
+        return top;
+    }
+
+    shared_token parse_context::next_token() {
+        shared_token t = pop_token();
+        if (_flavor == config_syntax::JSON) {
+            if (t->get_token_type() == token_type::UNQUOTED_TEXT && !grammar::is_unquoted_whitespace(t)) {
+                throw parse_error(_("Token not allowed in valid JSON: '{1}'", t->token_text()));
+            } else if (t->get_token_type() == token_type::SUBSTITUTION) {
+                throw parse_error(leatherman::locale::translate("Substitutions (${} syntax) not allowed in JSON"));
+            }
+        }
+        return t;
+    }
+
+    shared_token parse_context::next_token_collecting_whitespace(container& c) {
+        while (true) {
+            shared_token t = next_token();
+            if (t->get_token_type() == token_type::IGNORED_WHITESPACE || t->get_token_type() == token_type::NEWLINE
+                    || grammar::is_unquoted_whitespace(t)) {
+                add_trivia(c, t);
+                if (t->get_token_type() == token_type::NEWLINE) {
+                    _doc_line_number = t->line_number() + 1;
+                }
+            } else if (t->get_token_type() == token_type::COMMENT) {
+                add_trivia(c, t);
+            } else {
+                if (t->line_number() >= 0) {
+                    _doc_line_number = t->line_number();
+                }
+                return t;
+            }
+        }
+    }
+
+    void parse_context::put_back(shared_token token) {
+        _buffer.push(move(token));
+    }
+
+    bool parse_context::check_element_separator(container& c) {
+        if (_flavor == config_syntax::JSON) {
+            shared_token t = next_token_collecting_whitespace(c);
+            if (t->get_token_type() == token_type::COMMA) {
+                add_trivia(c, t);
+                return true;
+            } else {
+                put_back(t);
+                return false;
+            }
+        } else {
+            bool saw_newline = false;
+            shared_token t = next_token();
+            while (true) {
+                if (t->get_token_type() == token_type::IGNORED_WHITESPACE || grammar::is_unquoted_whitespace(t) ||
+                        t->get_token_type() == token_type::COMMENT) {
+                    add_trivia(c, t);
+                } else if (t->get_token_type() == token_type::NEWLINE) {
+                    saw_newline = true;
+                    _doc_line_number++;
+                    add_trivia(c, t);
+                    // we want to continue to also eat a comma if there is one
+                } else if (t->get_token_type() == token_type::COMMA) {
+                    add_trivia(c, t);
+                    return true;
+                } else {
+                    // non-newline-or-comma
+                    put_back(t);
+                    return saw_newline;
+                }
+                t = next_token();
+            }
+        }
+    }
+
+    void parse_context::add_trivia(container& c, shared_token const& t) {
+        bool is_comment = t->get_token_type() == token_type::COMMENT;
+        bool is_newline = t->get_token_type() == token_type::NEWLINE;
+
+        switch (c.type) {
+            case container::kind::DEFERRED:
+                c.deferred.push_back(t);
+                break;
+            case container::kind::INCLUDE:
+                break;
+            case container::kind::FIELD:
+                // comments between a key and its value go to the value
+                if (is_comment && _track_origins) {
+                    c.comments.push_back(dynamic_pointer_cast<const comment>(t)->text());
+                }
+                break;
+            case container::kind::OBJECT:
+                if (is_comment) {
+                    if (c.pending) {
+                        // a comment on the same line as a field belongs to its value
+                        auto old_origin = dynamic_pointer_cast<const simple_config_origin>(c.pending->origin());
+                        if (!old_origin) {
+                            throw bug_or_broken_exception(_("expected origin to be simple_config_origin"));
+                        }
+                        c.pending = c.pending->with_origin(
+                                old_origin->append_comments({dynamic_pointer_cast<const comment>(t)->text()}));
+                        settle_field(c);
+                    } else {
+                        c.last_was_newline = false;
+                        if (_track_origins) {
+                            c.comments.push_back(dynamic_pointer_cast<const comment>(t)->text());
+                        }
+                    }
+                } else if (is_newline) {
+                    settle_field(c);
+                    _line_number++;
+                    if (c.last_was_newline) {
+                        // Drop all comments if there was a blank line and start a new comment block
+                        c.comments.clear();
+                    }
+                    c.last_was_newline = true;
+                } else if (t->get_token_type() != token_type::COMMA &&
+                           t->get_token_type() != token_type::IGNORED_WHITESPACE) {
+                    settle_field(c);
+                }
+                break;
+            case container::kind::ARRAY:
+                if (is_comment) {
+                    if (_track_origins) {
+                        c.comments.push_back(dynamic_pointer_cast<const comment>(t)->text());
+                    }
+                    c.last_was_newline = false;
+                } else if (is_newline) {
+                    _line_number++;
+                    if (c.last_was_newline && !c.pending) {
+                        c.comments.clear();
+                    } else if (c.pending) {
+                        add_element(c, nullptr);
+                    }
+                    c.last_was_newline = true;
+                }
+                break;
+            case container::kind::ROOT:
+                if (c.done) {
+                    break;
+                }
+                if (is_comment) {
+                    if (_track_origins) {
+                        c.comments.push_back(dynamic_pointer_cast<const comment>(t)->text());
+                    }
+                    c.last_was_newline = false;
+                } else if (is_newline) {
+                    ++_line_number;
+                    if (c.last_was_newline && !c.pending) {
+                        c.comments.clear();
+                    } else if (c.pending) {
+                        auto origin = dynamic_pointer_cast<const simple_config_origin>(c.pending->origin());
+                        assert(origin);
+                        c.pending = c.pending->with_origin(origin->append_comments(move(c.comments)));
+                        c.comments.clear();
+                        c.done = true;
+                    }
+                    c.last_was_newline = true;
+                }
+                break;
+        }
+    }
+
+    void parse_context::add_element(container& c, shared_value v) {
+        // Comments after an element, up to the end of its line, are appended to it
+        if (c.pending) {
+            auto origin = dynamic_pointer_cast<const simple_config_origin>(c.pending->origin());
+            if (!origin) {
+                throw bug_or_broken_exception(_("origin was not a simple_config_origin"));
+            }
+            c.elements.push_back(c.pending->with_origin(origin->append_comments(move(c.comments))));
+            c.comments.clear();
+            c.pending = nullptr;
+        }
+        if (v) {
+            c.last_was_newline = false;
+            c.pending = with_comments(move(v), c.comments);
+        }
+    }
+
+    void parse_context::settle_field(container& c) {
+        if (c.pending) {
+            shared_value v = move(c.pending);
+            c.pending = nullptr;
+            store_field(c, c.pending_path, move(v));
+        }
+    }
+
+    shared_object parse_context::create_value_under_path(path p, shared_value value) {
+        // for path foo.bar, we are creating { "foo" : { "bar" : value } }
+        vector<shared_string> keys;
+
+        shared_string key = p.first();
+        path remaining = p.remainder();
+        while (key != nullptr) {
+            keys.push_back(key);
+            if (remaining.empty()) {
+                break;
+            } else {
+                key = remaining.first();
+                remaining = remaining.remainder();
+            }
+        }
+
+        auto current = keys.end();
+        current--;
+        auto new_value = unordered_map<string, shared_value>({ {**current, value} });
+        shared_object obj = make_shared<simple_config_object>(value->origin()->with_comments(vector<string>{}),
+                                                              new_value);
+
+        while (current != keys.begin()) {
+            current--;
+            new_value = unordered_map<string, shared_value>({ {**current, obj} });
+            obj = make_shared<simple_config_object>(value->origin()->with_comments(vector<string>{}), new_value);
+        }
+
+        return obj;
+    }
+
+    void parse_context::store_field(container& c, path const& p, shared_value v) {
+        auto key = p.first();
+        auto remaining = p.remainder();
+
+        if (remaining.empty()) {
+            auto existing = c.fields.find(*key);
+            if (existing != c.fields.end()) {
+                // In our custom config language, duplicates should be merged
+                // if the value is an object (or substitution that could become
+                // an object). Strict JSON rejected them while parsing the key.
+                v = dynamic_pointer_cast<const config_value>(v->with_fallback(existing->second));
+                assert(v);
+                existing->second = move(v);
+            } else {
+                c.fields.emplace(*key, move(v));
+            }
+        } else {
+            shared_object obj = create_value_under_path(remaining, move(v));
+            auto existing = c.fields.find(*key);
+            if (existing != c.fields.end()) {
+                obj = dynamic_pointer_cast<const config_object>(obj->with_fallback(existing->second));
+                assert(obj);
+                existing->second = move(obj);
+            } else {
+                c.fields.emplace(*key, move(obj));
+            }
+        }
+    }
+
+    shared_value parse_context::with_comments(shared_value v, vector<string>& comments) {
+        if (!comments.empty()) {
+            auto old_origin = dynamic_pointer_cast<const simple_config_origin>(v->origin());
+            if (!old_origin) {
+                throw bug_or_broken_exception(_("origin should be a simple_config_origin"));
+            }
+            v = v->with_origin(old_origin->prepend_comments(move(comments)));
+            comments.clear();
+        }
+        return v;
+    }
+
+    shared_value parse_context::consolidate_values(container& c) {
+        // this trick is not done in JSON
+        if (_flavor == config_syntax::JSON) {
+            return nullptr;
+        }
+
+        // create only if we have value tokens
+        vector<shared_value> values;
+        token_list trailing;
+
+        // ignore a newline up front
+        shared_token t = next_token_collecting_whitespace(c);
+        while (t) {
+            if (t->get_token_type() == token_type::IGNORED_WHITESPACE) {
+                trailing.push_back(t);
+                t = next_token();
+                continue;
+            } else if (t->get_token_type() == token_type::VALUE || t->get_token_type() == token_type::UNQUOTED_TEXT ||
+                    t->get_token_type() == token_type::SUBSTITUTION || t->get_token_type() == token_type::OPEN_CURLY ||
+                    t->get_token_type() == token_type::OPEN_SQUARE) {
+                // there may be newlines within objects and arrays
+                values.push_back(parse_value(t));
+                trailing.clear();
+            } else {
+                break;
+            }
+            t = next_token();  // but don't consolidate across a newline
+        }
+
+        // No concatenation was seen, but a single value may have been parsed, so return it, and put back
+        // all succeeding tokens
+        put_back(t);
+        if (values.size() < 2) {
+            if (values.empty()) {
+                return nullptr;
+            }
+            for (auto& w : trailing) {
+                put_back(w);
+            }
+            return values.front();
+        }
+
+        // Put back any trailing whitespace, as the parent object is responsible for tracking
+        // any leading/trailing whitespace
+        for (auto w = trailing.rbegin(); w != trailing.rend(); ++w) {
+            put_back(*w);
+        }
+        return config_concatenation::concatenate(move(values));
+    }
+
+    shared_value parse_context::parse_value(shared_token t) {
+        int starting_equals_count = _equals_count;
+        int starting_array_count = array_count;
+
+        shared_value v;
+        if (t->get_token_type() == token_type::VALUE || t->get_token_type() == token_type::UNQUOTED_TEXT ||
+                t->get_token_type() == token_type::SUBSTITUTION) {
+            v = config_node_simple_value(move(t)).get_value();
+        } else if (t->get_token_type() == token_type::OPEN_CURLY) {
+            v = parse_object(true);
+        } else if (t->get_token_type() == token_type::OPEN_SQUARE) {
+            v = parse_array();
+        } else {
+            throw parse_error(grammar::add_quote_suggestion(t->to_string(),
+                    _("Expecting a value but got wrong token: {1}", t->to_string()), _equals_count > 0, nullptr));
+        }
+
+        if (_equals_count != starting_equals_count) {
+            throw config_exception(_("Bug in config parser: unbalanced quals count"));
+        }
+        if (array_count != starting_array_count) {
+            throw bug_or_broken_exception(_("Bug in config parser: unbalanced array count"));
+        }
+        return v;
+    }
+
+    config_node_path parse_context::parse_key(shared_token token) {
+        if (_flavor == config_syntax::JSON) {
+            if (tokens::is_value_with_type(token, config_value::type::STRING)) {
+                single_token_iterator it(token);
+                return path_parser::parse_path_node_expression(it, nullptr);
+            } else {
+                throw parse_error(_("Expecting close brace } or a field name here, got {1}", token->to_string()));
+            }
+        } else {
+            token_list expression;
+            shared_token t = token;
+            while (t->get_token_type() == token_type::VALUE || t->get_token_type() == token_type::UNQUOTED_TEXT) {
+                expression.push_back(t);
+                t = next_token();  // note - don't cross a newline
+            }
+
+            if (expression.empty()) {
+                throw parse_error(_("expecting a close brace or a field name here, got {1}", t->to_string()));
+            }
+
+            put_back(t);
+            token_list_iterator it { move(expression) };
+            return path_parser::parse_path_node_expression(it, nullptr);
+        }
+    }
+
+    bool parse_context::is_key_value_separator(shared_token t) const {
+        if (_flavor == config_syntax::JSON) {
+            return t->get_token_type() == token_type::COLON;
+        } else {
+            return t->get_token_type() == token_type::COLON || t->get_token_type() == token_type::EQUALS ||
+                                                               t->get_token_type() == token_type::PLUS_EQUALS;
+        }
+    }
+
+    void parse_context::parse_include(container& c) {
+        container ignored { container::kind::INCLUDE };
+        shared_token t = next_token_collecting_whitespace(ignored);
+
+        // we either have a quoted string or the "file()" syntax
+        config_include_kind kind;
+        if (t->get_token_type() == token_type::UNQUOTED_TEXT) {
+            string kind_text = t->token_text();
+
+            if (kind_text == "url(") {
+                kind = config_include_kind::URL;
+            } else if (kind_text == "file(") {
+                kind = config_include_kind::FILE;
+            } else if (kind_text == "classpath(") {
+                kind = config_include_kind::CLASSPATH;
+            } else {
+                throw parse_error(_("expecting include parameter to be quoted filename, file(), classpath(), or url(). No spaces are allowed before the open paren. Not expecting: {1}", t->to_string()));
+            }
+
+            // skip space inside parens
+            t = next_token_collecting_whitespace(ignored);
+
+            // quoted string
+            if (!tokens::is_value_with_type(t, config_value::type::STRING)) {
+                throw parse_error(_("expecting a quoted string inside file(), classpath(), or url(), rather than {1}", t->to_string()));
+            }
+            shared_token name = t;
+
+            // skip space inside parens
+            t = next_token_collecting_whitespace(ignored);
+
+            if (t->token_text() != ")") {
+                throw parse_error(_("expecting a close parentheses ')' here, not: {1}", t->to_string()));
+            }
+            t = name;
+        } else if (tokens::is_value_with_type(t, config_value::type::STRING)) {
+            kind = config_include_kind::HEURISTIC;
+        } else {
+            throw parse_error(_("include keyword is not followed by a quoted string, but by: {1}", t->to_string()));
+        }
+        string name = config_node_simple_value(t).get_value()->transform_to_string();
+
+        shared_object obj;
+        switch (kind) {
+            case config_include_kind::FILE:
+                obj = dynamic_pointer_cast<const config_object>(_includer->include_file(_include_context, name));
+                break;
+            case config_include_kind::CLASSPATH:
+                // TODO: implement include_resource (?)
+                throw config_exception(_("full_includer::include_resource not implemented"));
+                break;
+            case config_include_kind::HEURISTIC:
+                obj = dynamic_pointer_cast<const config_object>(_includer->include(_include_context, name));
+                break;
+            default:
+                throw config_exception(_("should not be reached"));
+                break;
+        }
+
+        // we really should make this work, but for now throwing an
+        // exception is better than producing an incorrect result.
+        // See https://github.com/typesafehub/config/issues/160
+        if (array_count > 0 && obj->get_resolve_status() != resolve_status::RESOLVED) {
+            throw config_exception(leatherman::locale::translate("Due to current limitations of the config parser, when an include statement is nested inside a list value,\n${} substitutions inside the included file cannot be resolved correctly. Either move the include outside of the list value or\nremove the ${} statements from the included file."));
+        }
+
+        if (!_path_stack.empty()) {
+            auto prefix = full_current_path();
+            obj = dynamic_pointer_cast<const config_object>(obj->relativized(prefix.to_string()));
+        }
+
+        for (auto &pair : *obj) {
+            auto &key = pair.first;
+            auto &v = pair.second;
+            auto iter = c.fields.find(key);
+            if (iter != c.fields.end()) {
+                iter->second = dynamic_pointer_cast<const config_value>(v->with_fallback(iter->second));
+            } else {
+                c.fields.emplace(key, v);
+            }
+        }
+    }
+
+    shared_value parse_context::parse_object(bool had_open_curly, token_list const& leading) {
+        // invoked just after the OPEN_CURLY (or START, if !hadOpenCurly)
+        bool after_comma = false;
+        path* last_path = nullptr;
+        bool last_inside_equals = false;
+        unordered_set<string> keys;
+
+        container object { container::kind::OBJECT };
+        auto object_origin = line_origin();
+        for (auto& t : leading) {
+            add_trivia(object, t);
+        }
+
+        while (true) {
+            shared_token t = next_token_collecting_whitespace(object);
+            if (t->get_token_type() == token_type::CLOSE_CURLY) {
+                if (_flavor == config_syntax::JSON && after_comma) {
+                    throw parse_error(grammar::add_quote_suggestion(t->to_string(),
+                        _("expecting a field name after a comma, got a close brace '}' instead"), _equals_count > 0, nullptr));
+                } else if (!had_open_curly) {
+                    throw parse_error(grammar::add_quote_suggestion(t->to_string(),
+                           _("unbalanced close brace '}' with no open brace"), _equals_count > 0, nullptr));
+                }
+                break;
+            } else if (t->get_token_type() == token_type::END && !had_open_curly) {
+                put_back(t);
+                break;
+            } else if (_flavor != config_syntax::JSON && grammar::is_include_keyword(t)) {
+                settle_field(object);
+                parse_include(object);
+                object.last_was_newline = false;
+                after_comma = false;
+            } else {
+                settle_field(object);
+                container field { container::kind::FIELD };
+                auto key_path = parse_key(t);
+                path p = key_path.get_path();
+                shared_token after_key = next_token_collecting_whitespace(field);
+                bool inside_equals = false;
+                bool plus_equals = false;
+
+                shared_value next_value;
+                if (_flavor == config_syntax::CONF && after_key->get_token_type() == token_type::OPEN_CURLY) {
+                    // can omit the ':' or '=' befor an object value
+                    _path_stack.push_back(p);
+                    next_value = parse_value(after_key);
+                } else {
+                    if (!is_key_value_separator(after_key)) {
+                        throw parse_error(grammar::add_quote_suggestion(after_key->to_string(),
+                        _("Key '{1}' may not be followed by token: {2}", key_path.render(), after_key->to_string()),
+                        _equals_count > 0, nullptr));
+                    }
+
+                    if (after_key->get_token_type() == token_type::EQUALS) {
+                        inside_equals = true;
+                        ++_equals_count;
+                    }
+
+                    // path must be on-stack while we parse the value
+                    _path_stack.push_back(p);
+                    if (after_key->get_token_type() == token_type::PLUS_EQUALS) {
+                        // we really should make this work, but for now throwing
+                        // an exception is better than producing an incorrect
+                        // result. See
+                        // https://github.com/typesafehub/config/issues/160
+                        if (array_count > 0) {
+                            throw parse_exception(*line_origin(), leatherman::locale::translate("Due to current limitations of the config parser, += does not work nested inside a list. += expands to a ${} substitution and the path in ${} cannot currently refer to list elements. You might be able to move the += outside of the list and then refer to it from inside the list with ${}."));
+                        }
+
+                        // because we will put it in an array after the fact so
+                        // we want this to be incremented while parsing the value
+                        // in order to throw the above exception.
+                        plus_equals = true;
+                        array_count += 1;
+                    }
+
+                    next_value = consolidate_values(field);
+                    if (!next_value) {
+                        next_value = parse_value(next_token_collecting_whitespace(field));
+                    }
+                }
+
+                if (inside_equals) {
+                    --_equals_count;
+                }
+                last_inside_equals = inside_equals;
+
+                if (_flavor == config_syntax::JSON) {
+                    // In strict JSON, dups should be an error; while in
+                    // our custom config language, they should be merged.
+                    string key = *p.first();
+                    if (!p.remainder().empty()) {
+                        throw config_exception(_("somehow got multi-element path in JSON mode"));
+                    }
+                    if (!keys.insert(key).second) {
+                        throw parse_error(_("JSON does not allow duplicate fields: '{1}' was already seen", key));
+                    }
+                }
+
+                // comments from the key token go to the value token
+                object.last_was_newline = false;
+                object.comments.insert(object.comments.end(), field.comments.begin(), field.comments.end());
+                next_value = with_comments(move(next_value), object.comments);
+                object.comments.clear();
+
+                if (plus_equals) {
+                    array_count -= 1;
+
+                    vector<shared_value> concat;
+                    concat.reserve(2);
+                    auto previous_ref = make_shared<config_reference>(next_value->origin(), make_shared<substitution_expression>(full_current_path(), true));
+                    auto list = make_shared<simple_config_list>(next_value->origin(), vector<shared_value>({next_value}));
+                    concat.push_back(previous_ref);
+                    concat.push_back(list);
+                    next_value = config_concatenation::concatenate(concat);
+                }
+                _path_stack.pop_back();
+
+                if (_track_origins) {
+                    // Hold the value back so a comment later on the same line can be attached
+                    object.pending = move(next_value);
+                    object.pending_path = move(p);
+                } else {
+                    store_field(object, p, move(next_value));
+                }
+                after_comma = false;
+            }
+
+            if (check_element_separator(object)) {
+                // continue looping
+                after_comma = true;
+            } else {
+                t = next_token_collecting_whitespace(object);
+                if (t->get_token_type() == token_type::CLOSE_CURLY) {
+                    if (!had_open_curly) {
+                        throw parse_error(grammar::add_quote_suggestion(t->to_string(),
+                            _("unbalanced close brace '}' with no open brace"), last_inside_equals, last_path));
+                    }
+                    break;
+                } else if (had_open_curly) {
+                    throw parse_error(grammar::add_quote_suggestion(t->to_string(),
+                         _("Expecting close brace '}' or a comma, got {1}", t->to_string()), last_inside_equals, last_path));
+                } else {
+                    if (t->get_token_type() == token_type::END) {
+                        put_back(t);
+                        break;
+                    } else {
+                        throw parse_error(grammar::add_quote_suggestion(t->to_string(),
+                            _("Expecting end of input or a comma, got {1}", t->to_string()), last_inside_equals, last_path));
+                    }
+                }
+            }
+        }
+        settle_field(object);
+        return simple_config_object::new_literal(move(object_origin), object.fields);
+    }
+
+    shared_value parse_context::parse_array() {
+        ++array_count;
+
+        container array { container::kind::ARRAY };
+        auto array_origin = line_origin();
+        shared_token t;
+
+        shared_value next_value = consolidate_values(array);
+        if (next_value) {
+            add_element(array, move(next_value));
+        } else {
+            t = next_token_collecting_whitespace(array);
+
+            // special case the first element
+            if (t->get_token_type() == token_type::CLOSE_SQUARE) {
+                --array_count;
+                return simple_config_list::new_literal(move(array_origin), move(array.elements));
+            } else if (grammar::is_valid_array_element(t)) {
+                add_element(array, parse_value(t));
+            } else {
+                throw parse_error(_("List should have ']' or a first element after the '[', instead had token: {1} (if you want {2} to be part of a string value, then double quote it)",  t->to_string(), t->to_string()));
+            }
+        }
+
+        // now remaining elements
+        while (true) {
+            // just after a value
+            if (check_element_separator(array)) {
+                // comma or newline equivalent consumed
+            } else {
+                t = next_token_collecting_whitespace(array);
+                if (t->get_token_type() == token_type::CLOSE_SQUARE) {
+                    // There shouldn't be any comments at this point, but add them just in case
+                    add_element(array, nullptr);
+                    --array_count;
+                    return simple_config_list::new_literal(move(array_origin), move(array.elements));
+                } else {
+                    throw parse_error(_("List should have ended with ']' or had a comma, instead had token: {1} (if you want {2} to be part of a string value, then double quote it)", t->to_string(), t->to_string()));
+                }
+            }
+
+            // now just after a comma
+            next_value = consolidate_values(array);
+            if (next_value) {
+                add_element(array, move(next_value));
+            } else {
+                t = next_token_collecting_whitespace(array);
+                if (grammar::is_valid_array_element(t)) {
+                    add_element(array, parse_value(t));
+                } else if (_flavor != config_syntax::JSON && t->get_token_type() == token_type::CLOSE_SQUARE) {
+                    // we allow one trailing comma
+                    put_back(t);
+                } else {
+                    throw parse_error(_("List should have had a new element after a comma, instead had token: {1} (if you want the comma or {2} to be part of a string value, then double quote it)", t->to_string(), t->to_string()));
+                }
+            }
+        }
+    }
+
+    shared_value parse_context::parse() {
+        shared_token t = next_token();
+        if (t->get_token_type() == token_type::START) {
+            // OK
+        } else {
+            throw config_exception(_("token stream did not begin with START, had {1}", t->to_string()));
+        }
+
+        container leading { container::kind::DEFERRED };
+        container root { container::kind::ROOT };
+        t = next_token_collecting_whitespace(leading);
+        if (t->get_token_type() == token_type::OPEN_CURLY || t->get_token_type() == token_type::OPEN_SQUARE) {
+            for (auto& trivia : leading.deferred) {
+                add_trivia(root, trivia);
+            }
+            auto value = parse_value(t);
+            root.last_was_newline = false;
+            root.pending = with_comments(move(value), root.comments);
+        } else {
+            if (_flavor == config_syntax::JSON) {
+                if (t->get_token_type() == token_type::END) {
+                    throw parse_error(_("empty document"));
+                } else {
+                    throw parse_error(_("Document must have an object or array at root, unexpected token: {1}", t->to_string()));
+                }
+            } else {
+                // the root object can omit the surrounding braces.
+                // this token should be the first field's key, or part
+                // of it, so put it back. Whitespace read so far belongs
+                // to that object.
+                put_back(t);
+                root.pending = parse_object(false, leading.deferred);
+                root.done = true;
+            }
+        }
+
+        t = next_token_collecting_whitespace(root);
+        if (t->get_token_type() == token_type::END) {
+            return root.pending;
+        } else {
+            throw parse_error(_("Document has trailing tokens after first object or array: {1}", t->to_string()));
+        }
+    }
+
+}}  // namespace hocon::config_token_parser
@@ -1,5 +1,9 @@
 #include <internal/config_util.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <limits>
+#include <locale>
+#include <sstream>
 
 using namespace std;
 
@@ -25,7 +29,8 @@ namespace hocon {
     }
 
     bool is_C0_control(char c) {
-        return c <= 0x001F;
+        // Bytes of multi-byte UTF-8 characters are negative as a signed char, and aren't controls
+        return static_cast<unsigned char>(c) <= 0x001F;
     }
 
     string render_json_string(string const& s) {
@@ -92,4 +97,137 @@ namespace hocon {
         return s;
     }
 
+    bool parse_int64(string const& s, int64_t& result) {
+        auto c = s.begin();
+        bool negative = false;
+        if (c != s.end() && (*c == '-' || *c == '+')) {
+            negative = *c == '-';
+            ++c;
+        }
+        if (c == s.end()) {
+            return false;
+        }
+
+        // Accumulate as a negative value, which has room for the most negative int64_t
+        int64_t value = 0;
+        int64_t const lowest = numeric_limits<int64_t>::min();
+        for (; c != s.end(); ++c) {
+            if (*c < '0' || *c > '9') {
+                return false;
+            }
+            int digit = *c - '0';
+            if (value < (lowest + digit) / 10) {
+                return false;
+            }
+            value = value * 10 - digit;
+        }
+
+        if (!negative) {
+            if (value == lowest) {
+                return false;
+            }
+            value = -value;
+        }
+        result = value;
+        return true;
+    }
+
+    /** Powers of ten that are exactly representable as a double. */
+    static const double exact_powers_of_ten[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    static bool parse_special_double(string const& s, double& result) {
+        string lower = boost::algorithm::to_lower_copy(s);
+        bool negative = !lower.empty() && lower[0] == '-';
+        if (!lower.empty() && (lower[0] == '-' || lower[0] == '+')) {
+            lower.erase(0, 1);
+        }
+        if (lower == "nan") {
+            result = negative ? -numeric_limits<double>::quiet_NaN() : numeric_limits<double>::quiet_NaN();
+            return true;
+        } else if (lower == "inf" || lower == "infinity") {
+            result = negative ? -numeric_limits<double>::infinity() : numeric_limits<double>::infinity();
+            return true;
+        }
+        return false;
+    }
+
+    bool parse_double(string const& s, double& result) {
+        auto c = s.begin();
+        bool negative = false;
+        if (c != s.end() && (*c == '-' || *c == '+')) {
+            negative = *c == '-';
+            ++c;
+        }
+
+        // Validate the syntax while collecting up to 19 significant digits
+        uint64_t mantissa = 0;
+        int significant_digits = 0;
+        int digits = 0;
+        int exponent = 0;
+        for (; c != s.end() && *c >= '0' && *c <= '9'; ++c, ++digits) {
+            if (significant_digits < 19) {
+                mantissa = mantissa * 10 + (*c - '0');
+                significant_digits += (mantissa != 0);
+            } else {
+                exponent++;
+            }
+        }
+        if (c != s.end() && *c == '.') {
+            for (++c; c != s.end() && *c >= '0' && *c <= '9'; ++c, ++digits) {
+                if (significant_digits < 19) {
+                    mantissa = mantissa * 10 + (*c - '0');
+                    significant_digits += (mantissa != 0);
+                    exponent--;
+                }
+            }
+        }
+        if (digits == 0) {
+            return parse_special_double(s, result);
+        }
+        if (c != s.end() && (*c == 'e' || *c == 'E')) {
+            ++c;
+            bool negative_exponent = false;
+            if (c != s.end() && (*c == '-' || *c == '+')) {
+                negative_exponent = *c == '-';
+                ++c;
+            }
+            if (c == s.end()) {
+                return false;
+            }
+            int explicit_exponent = 0;
+            for (; c != s.end() && *c >= '0' && *c <= '9'; ++c) {
+                if (explicit_exponent < 100000) {
+                    explicit_exponent = explicit_exponent * 10 + (*c - '0');
+                }
+            }
+            exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+        }
+        if (c != s.end()) {
+            return false;
+        }
+
+        // When both the mantissa and the power of ten are exact doubles, a single
+        // multiplication or division is correctly rounded.
+        if (significant_digits <= 15 && exponent >= -22 && exponent <= 22) {
+            double value = static_cast<double>(mantissa);
+            value = exponent < 0 ? value / exact_powers_of_ten[-exponent] : value * exact_powers_of_ten[exponent];
+            result = negative ? -value : value;
+            return true;
+        }
+
+        // Otherwise let the C locale's conversion do the correct rounding
+        istringstream stream(s);
+        stream.imbue(locale::classic());
+        double value;
+        stream >> value;
+        if (stream.fail() || !stream.eof()) {
+            return false;
+        }
+        result = value;
+        return true;
+    }
+
 }  // namespace hocon
@@ -12,7 +12,7 @@ namespace hocon {
 
     using namespace std;
 
-    class config_value_visitor : public boost::static_visitor<shared_value> {
+    class wrapping_visitor : public boost::static_visitor<shared_value> {
     public:
         // TODO: If use cases of from_any_ref require other types to produce config_nulls,
         // we can revise this behavior
@@ -43,7 +43,7 @@ namespace hocon {
         shared_value operator()(vector<unwrapped_value> value_list) const {
             vector<shared_value> config_values;
             for (unwrapped_value v : value_list) {
-                config_values.emplace_back(boost::apply_visitor(config_value_visitor(), v));
+                config_values.emplace_back(boost::apply_visitor(wrapping_visitor(), v));
             }
             return make_shared<simple_config_list>(nullptr, config_values);
         }
@@ -51,7 +51,7 @@ namespace hocon {
         shared_value operator()(unordered_map<string, unwrapped_value> value_map) const {
             unordered_map<string, shared_value> config_map;
             for (auto pair : value_map) {
-                config_map[pair.first] = boost::apply_visitor(config_value_visitor(), pair.second);
+                config_map[pair.first] = boost::apply_visitor(wrapping_visitor(), pair.second);
             }
             return make_shared<simple_config_object>(nullptr, config_map);
         }
@@ -63,6 +63,6 @@ namespace hocon {
             origin = "hardcoded value";
         }
         auto conf_origin = make_shared<simple_config_origin>(origin);
-        return boost::apply_visitor(config_value_visitor(), value)->with_origin(conf_origin);
+        return boost::apply_visitor(wrapping_visitor(), value)->with_origin(conf_origin);
     }
 }  // namespace hocon
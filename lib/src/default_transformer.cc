@@ -1,6 +1,6 @@
 #include <internal/default_transformer.hpp>
 #include <hocon/config_value.hpp>
-#include <boost/lexical_cast.hpp>
+#include <internal/config_util.hpp>
 #include <internal/values/config_long.hpp>
 #include <internal/values/config_double.hpp>
 #include <internal/values/config_null.hpp>
@@ -21,20 +21,18 @@ namespace hocon {
         if (value->value_type() == config_value::type::STRING) {
             string s = value->transform_to_string();
             switch (requested) {
-                case config_value::type::NUMBER:
-                    try {
-                        int64_t v = boost::lexical_cast<int64_t>(s);
-                        return make_shared<config_long>(value->origin(), v, s);
-                    } catch (boost::bad_lexical_cast &ex) {
-                        // try double
+                case config_value::type::NUMBER: {
+                    int64_t l;
+                    if (parse_int64(s, l)) {
+                        return make_shared<config_long>(value->origin(), l, s);
                     }
-                    try {
-                        double v = boost::lexical_cast<double>(s);
-                        return make_shared<config_double>(value->origin(), v, s);
-                    } catch (boost::bad_lexical_cast &ex) {
-                        // we don't have a number
+                    double d;
+                    if (parse_double(s, d)) {
+                        return make_shared<config_double>(value->origin(), d, s);
                     }
+                    // we don't have a number
                     break;
+                }
                 case config_value::type::CONFIG_NULL:
                     if (s == "null") {
                         return make_shared<config_null>(value->origin());
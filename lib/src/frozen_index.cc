@@ -0,0 +1,83 @@
+#include <internal/frozen_index.hpp>
+#include <hocon/config_object.hpp>
+#include <internal/path_builder.hpp>
+#include <functional>
+
+using namespace std;
+
+namespace hocon {
+
+    frozen_index::frozen_index(shared_object const& root) {
+        add_entries(root, path());
+
+        vector<size_t> hashes;
+        hashes.reserve(_entries.size());
+        for (auto const& e : _entries) {
+            hashes.push_back(e.full_path.get_path().hash());
+        }
+        if (!_by_path.build(hashes)) {
+            // Two paths share a hash; lookups fall back to walking the tree
+            _entries.clear();
+            return;
+        }
+
+        // Put each entry in its slot so a lookup is a single probe
+        vector<uint32_t> entry_in_slot(_entries.size());
+        for (size_t i = 0; i < _entries.size(); ++i) {
+            entry_in_slot[_by_path.slot(hashes[i])] = static_cast<uint32_t>(i);
+        }
+        vector<entry> placed;
+        placed.reserve(_entries.size());
+        for (uint32_t i : entry_in_slot) {
+            placed.push_back(move(_entries[i]));
+        }
+        _entries.swap(placed);
+
+        hashes.clear();
+        for (auto const& e : _entries) {
+            hashes.push_back(std::hash<string>()(e.full_path.expression()));
+        }
+        if (_by_expression.build(hashes)) {
+            _expression_entries.resize(_entries.size());
+            for (size_t i = 0; i < _entries.size(); ++i) {
+                _expression_entries[_by_expression.slot(hashes[i])] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+
+    void frozen_index::add_entries(shared_object const& object, path const& parent) {
+        for (auto const& child : *object) {
+            path_builder builder;
+            builder.append_path(parent);
+            builder.append_key(child.first);
+            path child_path = builder.result();
+            if (auto child_object = dynamic_pointer_cast<const config_object>(child.second)) {
+                add_entries(child_object, child_path);
+            }
+            _entries.push_back(entry { compiled_path(move(child_path)), child.second });
+        }
+    }
+
+    shared_value frozen_index::find(path const& desired_path) const {
+        if (_entries.empty()) {
+            return nullptr;
+        }
+        auto const& e = _entries[_by_path.slot(desired_path.hash())];
+        if (e.full_path.get_path() != desired_path) {
+            return nullptr;
+        }
+        return e.value;
+    }
+
+    compiled_path const* frozen_index::find_expression(string const& expression) const {
+        if (_expression_entries.empty()) {
+            return nullptr;
+        }
+        auto const& e = _entries[_expression_entries[_by_expression.slot(std::hash<string>()(expression))]];
+        if (e.full_path.expression() != expression) {
+            return nullptr;
+        }
+        return &e.full_path;
+    }
+
+}  // namespace hocon
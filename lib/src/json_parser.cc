@@ -0,0 +1,378 @@
+#include <internal/json_parser.hpp>
+#include <internal/config_util.hpp>
+#include <internal/simple_config_origin.hpp>
+#include <internal/values/config_boolean.hpp>
+#include <internal/values/config_null.hpp>
+#include <internal/values/config_number.hpp>
+#include <internal/values/config_string.hpp>
+#include <internal/values/simple_config_list.hpp>
+#include <internal/values/simple_config_object.hpp>
+#include <boost/nowide/convert.hpp>
+#include <cstring>
+#include <unordered_map>
+
+using namespace std;
+
+namespace hocon { namespace json_parser {
+
+    shared_value parse(input_buffer const& input, shared_origin origin, bool track_origins) {
+        parse_context context { input, move(origin), track_origins };
+        return context.parse();
+    }
+
+    static bool is_hex_digit(char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+
+    static bool is_digit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    parse_context::parse_context(input_buffer const& input, shared_origin origin, bool track_origins) :
+        _pos(input.begin()), _end(input.end()), _base_origin(move(origin)), _track_origins(track_origins),
+        _line_number(1), _container_line_number(1), _value_origin_line(0)
+    {}
+
+    shared_value parse_context::parse() {
+        char c = skip_whitespace();
+        if (c != '{' && c != '[') {
+            return nullptr;
+        }
+
+        shared_value root = parse_value(c);
+        if (!root) {
+            return nullptr;
+        }
+
+        skip_whitespace();
+        if (_pos != _end) {
+            return nullptr;
+        }
+        return root;
+    }
+
+    char parse_context::skip_whitespace(bool count_container_lines) {
+        for (; _pos != _end; ++_pos) {
+            char c = *_pos;
+            if (c == '\n') {
+                ++_line_number;
+                if (count_container_lines) {
+                    ++_container_line_number;
+                }
+            } else if (c != ' ' && c != '\t' && c != '\r') {
+                return c;
+            }
+        }
+        return '\0';
+    }
+
+    shared_origin const& parse_context::value_origin() {
+        if (!_track_origins) {
+            return _base_origin;
+        }
+        // Values on the same line share an origin, as they do coming from the tokenizer
+        if (_value_origin_line != _line_number) {
+            _value_origin = _base_origin->with_line_number(_line_number);
+            _value_origin_line = _line_number;
+        }
+        return _value_origin;
+    }
+
+    shared_origin parse_context::container_origin() const {
+        if (!_track_origins) {
+            return _base_origin;
+        }
+        return _base_origin->with_line_number(_container_line_number);
+    }
+
+    bool parse_context::at_delimiter() const {
+        if (_pos == _end) {
+            return true;
+        }
+        switch (*_pos) {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+            case ',':
+            case ']':
+            case '}':
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool parse_context::pull_string(string& result) {
+        // invoked just after the opening quote
+        char const* run = _pos;
+        while (true) {
+            if (_pos == _end) {
+                return false;
+            }
+            unsigned char c = static_cast<unsigned char>(*_pos);
+            if (c == '"') {
+                result.append(run, _pos);
+                ++_pos;
+                break;
+            } else if (c == '\\') {
+                result.append(run, _pos);
+                if (++_pos == _end) {
+                    return false;
+                }
+                switch (*_pos++) {
+                    case '"':
+                        result += '"';
+                        break;
+                    case '\\':
+                        result += '\\';
+                        break;
+                    case '/':
+                        result += '/';
+                        break;
+                    case 'b':
+                        result += '\b';
+                        break;
+                    case 'f':
+                        result += '\f';
+                        break;
+                    case 'n':
+                        result += '\n';
+                        break;
+                    case 'r':
+                        result += '\r';
+                        break;
+                    case 't':
+                        result += '\t';
+                        break;
+                    case 'u': {
+                        if (_end - _pos < 4) {
+                            return false;
+                        }
+                        unsigned short character = 0;
+                        for (int i = 0; i < 4; ++i) {
+                            char h = *_pos++;
+                            if (!is_hex_digit(h)) {
+                                return false;
+                            }
+                            character = static_cast<unsigned short>(character * 16 +
+                                (is_digit(h) ? h - '0' : (h | 0x20) - 'a' + 10));
+                        }
+                        wchar_t buffer[] { static_cast<wchar_t>(character), '\0'};
+                        result += boost::nowide::narrow(buffer);
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+                run = _pos;
+            } else if (c < 0x20) {
+                // Control characters are errors, which the tokenizer reports
+                return false;
+            } else {
+                ++_pos;
+            }
+        }
+
+        // "" followed by another quote starts a triple-quoted string in the tokenizer
+        if (result.empty() && _pos != _end && *_pos == '"') {
+            return false;
+        }
+        return true;
+    }
+
+    bool parse_context::pull_literal(char const* text, size_t length) {
+        if (static_cast<size_t>(_end - _pos) < length || memcmp(_pos, text, length) != 0) {
+            return false;
+        }
+        _pos += length;
+        return at_delimiter();
+    }
+
+    shared_value parse_context::parse_number() {
+        // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+        char const* start = _pos;
+        bool contained_decimal_or_E = false;
+
+        if (*_pos == '-') {
+            ++_pos;
+        }
+        if (_pos == _end || !is_digit(*_pos)) {
+            return nullptr;
+        }
+        if (*_pos == '0') {
+            ++_pos;
+        } else {
+            while (_pos != _end && is_digit(*_pos)) {
+                ++_pos;
+            }
+        }
+        if (_pos != _end && *_pos == '.') {
+            contained_decimal_or_E = true;
+            if (++_pos == _end || !is_digit(*_pos)) {
+                return nullptr;
+            }
+            while (_pos != _end && is_digit(*_pos)) {
+                ++_pos;
+            }
+        }
+        if (_pos != _end && (*_pos == 'e' || *_pos == 'E')) {
+            contained_decimal_or_E = true;
+            if (++_pos != _end && (*_pos == '+' || *_pos == '-')) {
+                ++_pos;
+            }
+            if (_pos == _end || !is_digit(*_pos)) {
+                return nullptr;
+            }
+            while (_pos != _end && is_digit(*_pos)) {
+                ++_pos;
+            }
+        }
+        if (!at_delimiter()) {
+            return nullptr;
+        }
+
+        string text(start, _pos);
+        if (contained_decimal_or_E) {
+            double number;
+            if (parse_double(text, number)) {
+                return config_number::new_number(value_origin(), number, move(text));
+            }
+        } else {
+            int64_t number;
+            if (parse_int64(text, number)) {
+                return config_number::new_number(value_origin(), number, move(text));
+            }
+        }
+        return nullptr;
+    }
+
+    shared_value parse_context::parse_value(char c) {
+        switch (c) {
+            case '"': {
+                ++_pos;
+                string text;
+                if (!pull_string(text)) {
+                    return nullptr;
+                }
+                return make_shared<config_string>(value_origin(), move(text), config_string_type::QUOTED);
+            }
+            case '{':
+                ++_pos;
+                return parse_object();
+            case '[':
+                ++_pos;
+                return parse_array();
+            case 't':
+                if (!pull_literal("true", 4)) {
+                    return nullptr;
+                }
+                return make_shared<config_boolean>(value_origin(), true);
+            case 'f':
+                if (!pull_literal("false", 5)) {
+                    return nullptr;
+                }
+                return make_shared<config_boolean>(value_origin(), false);
+            case 'n':
+                if (!pull_literal("null", 4)) {
+                    return nullptr;
+                }
+                return make_shared<config_null>(value_origin());
+            default:
+                if (c == '-' || is_digit(c)) {
+                    return parse_number();
+                }
+                return nullptr;
+        }
+    }
+
+    shared_value parse_context::parse_object() {
+        // invoked just after the OPEN_CURLY
+        auto object_origin = container_origin();
+        unordered_map<string, shared_value> values;
+
+        char c = skip_whitespace();
+        if (c == '}') {
+            ++_pos;
+            return make_shared<simple_config_object>(move(object_origin), move(values));
+        }
+
+        while (true) {
+            if (c != '"') {
+                return nullptr;
+            }
+            ++_pos;
+            string key;
+            if (!pull_string(key)) {
+                return nullptr;
+            }
+
+            if (skip_whitespace(false) != ':') {
+                return nullptr;
+            }
+            ++_pos;
+
+            c = skip_whitespace(false);
+            if (_pos == _end) {
+                return nullptr;
+            }
+            shared_value value = parse_value(c);
+            if (!value) {
+                return nullptr;
+            }
+
+            // duplicates are an error in strict JSON
+            if (!values.emplace(move(key), move(value)).second) {
+                return nullptr;
+            }
+
+            c = skip_whitespace();
+            if (c == ',') {
+                ++_pos;
+                c = skip_whitespace();
+            } else if (c == '}') {
+                ++_pos;
+                break;
+            } else {
+                return nullptr;
+            }
+        }
+        return simple_config_object::new_literal(move(object_origin), values);
+    }
+
+    shared_value parse_context::parse_array() {
+        // invoked just after the OPEN_SQUARE
+        auto array_origin = container_origin();
+        vector<shared_value> values;
+
+        char c = skip_whitespace();
+        if (c == ']') {
+            ++_pos;
+            return simple_config_list::new_literal(move(array_origin), move(values));
+        }
+
+        while (true) {
+            if (_pos == _end) {
+                return nullptr;
+            }
+            shared_value value = parse_value(c);
+            if (!value) {
+                return nullptr;
+            }
+            values.push_back(move(value));
+
+            c = skip_whitespace();
+            if (c == ',') {
+                ++_pos;
+                c = skip_whitespace();
+            } else if (c == ']') {
+                ++_pos;
+                break;
+            } else {
+                return nullptr;
+            }
+        }
+        return simple_config_list::new_literal(move(array_origin), move(values));
+    }
+
+}}  // namespace hocon::json_parser
@@ -0,0 +1,50 @@
+#include <internal/lazy_resolver.hpp>
+#include <internal/resolve_result.hpp>
+#include <internal/resolve_source.hpp>
+#include <internal/values/simple_config_object.hpp>
+#include <hocon/config_exception.hpp>
+#include <leatherman/locale/locale.hpp>
+
+// Mark string for translation (alias for leatherman::locale::format)
+using leatherman::locale::_;
+
+using namespace std;
+
+namespace hocon {
+
+    lazy_resolver::lazy_resolver(shared_object root, config_resolve_options options)
+        : _root(move(root)), _context(move(options), path()) { }
+
+    shared_object lazy_resolver::resolve_path(path const& the_path) const {
+        auto found = resolve_source(_root).resolve_path(_context.fork(), the_path);
+
+        // Every parsed root is a simple_config_object, and resolving keeps it one
+        auto partial = dynamic_pointer_cast<const simple_config_object>(found.path_from_root.back());
+        if (!partial) {
+            throw bug_or_broken_exception(_("resolved object to non-object"));
+        }
+        if (found.result.value) {
+            return partial->with_value(the_path, found.result.value);
+        }
+        // A value that resolved to nothing, like an optional substitution, is missing
+        return partial->without_path(the_path);
+    }
+
+    shared_object lazy_resolver::resolved() const {
+        lock_guard<mutex> guard(_lock);
+        if (!_resolved) {
+            auto value = _context.fork().resolve(_root, resolve_source(_root)).value;
+            _resolved = dynamic_pointer_cast<const config_object>(value);
+            if (!_resolved) {
+                throw bug_or_broken_exception(_("resolved object to non-object"));
+            }
+        }
+        return _resolved;
+    }
+
+    bool lazy_resolver::is_resolved() const {
+        lock_guard<mutex> guard(_lock);
+        return _resolved && _resolved->get_resolve_status() == resolve_status::RESOLVED;
+    }
+
+}  // namespace hocon
@@ -0,0 +1,287 @@
+#include <internal/parallel_resolver.hpp>
+#include <internal/resolve_context.hpp>
+#include <internal/resolve_result.hpp>
+#include <internal/values/simple_config_object.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+using namespace std;
+
+namespace hocon {
+
+    parallel_resolver::parallel_resolver(shared_object root) : _root(move(root)) {
+        add_trie_node();
+        if (auto object = dynamic_pointer_cast<const simple_config_object>(_root)) {
+            find_units(object, 0, { object });
+        }
+
+        _graph.resize(_units.size());
+        for (size_t i = 0; i < _units.size(); ++i) {
+            resolve_source::for_each_lookup(_units[i].value, [&](path const& target) { add_dependency(i, target); });
+        }
+        schedule();
+    }
+
+    size_t parallel_resolver::add_trie_node() {
+        _trie.push_back(trie_node { {}, -1, -1 });
+        return _trie.size() - 1;
+    }
+
+    void parallel_resolver::find_units(shared_ptr<const simple_config_object> const& object, size_t trie,
+                                       resolve_source::node const& parents) {
+        for (auto const& entry : object->entry_set()) {
+            auto const& value = entry.second;
+            if (value->get_resolve_status() == resolve_status::RESOLVED) {
+                continue;
+            }
+
+            size_t child_trie = add_trie_node();
+            _trie[trie].children.emplace(entry.first, child_trie);
+
+            if (auto nested = dynamic_pointer_cast<const simple_config_object>(value)) {
+                auto nested_parents = parents;
+                nested_parents.push_front(nested);
+                find_units(nested, child_trie, nested_parents);
+            } else if (_unit_of.emplace(value.get(), _units.size()).second) {
+                // A value shared between paths resolves once, so only its first path waits for it
+                _trie[child_trie].unit = static_cast<int>(_units.size());
+                _units.push_back(unit { value, parents });
+            }
+        }
+    }
+
+    void parallel_resolver::add_dependency(size_t node, path const& target) {
+        // A substitution reads the value at its path, which may be a unit, inside a
+        // unit, or an object holding units
+        size_t trie = 0;
+        for (path remaining = target; !remaining.empty(); remaining = remaining.remainder()) {
+            auto child = _trie[trie].children.find(*remaining.first());
+            if (child == _trie[trie].children.end()) {
+                return;
+            }
+            trie = child->second;
+            if (_trie[trie].unit >= 0) {
+                _graph[node].push_back(static_cast<size_t>(_trie[trie].unit));
+                return;
+            }
+        }
+        auto group = group_of(trie);
+        _graph[node].push_back(group);
+    }
+
+    size_t parallel_resolver::group_of(size_t trie) {
+        if (_trie[trie].group >= 0) {
+            return static_cast<size_t>(_trie[trie].group);
+        }
+
+        size_t group = _graph.size();
+        _trie[trie].group = static_cast<int>(group);
+        _graph.emplace_back();
+        if (_trie[trie].unit >= 0) {
+            _graph[group].push_back(static_cast<size_t>(_trie[trie].unit));
+        }
+        for (auto const& child : _trie[trie].children) {
+            auto child_group = group_of(child.second);
+            _graph[group].push_back(child_group);
+        }
+        return group;
+    }
+
+    void parallel_resolver::schedule() {
+        // Tarjan's algorithm, without recursion since substitutions may chain deeply. It
+        // finds each strongly connected component after those it depends on.
+        const size_t unvisited = numeric_limits<size_t>::max();
+        size_t nodes = _graph.size();
+        vector<size_t> index(nodes, unvisited), low(nodes, 0), component(nodes, unvisited);
+        vector<size_t> stack;
+        vector<pair<size_t, size_t>> calls;
+        size_t next_index = 0, components = 0;
+
+        for (size_t start = 0; start < nodes; ++start) {
+            if (index[start] != unvisited) {
+                continue;
+            }
+            calls.emplace_back(start, 0);
+            while (!calls.empty()) {
+                size_t node = calls.back().first;
+                size_t& edge = calls.back().second;
+                if (edge == 0) {
+                    index[node] = low[node] = next_index++;
+                    stack.push_back(node);
+                }
+                if (edge < _graph[node].size()) {
+                    size_t next = _graph[node][edge++];
+                    if (index[next] == unvisited) {
+                        calls.emplace_back(next, 0);
+                    } else if (component[next] == unvisited) {
+                        low[node] = min(low[node], index[next]);
+                    }
+                    continue;
+                }
+
+                if (low[node] == index[node]) {
+                    size_t member;
+                    do {
+                        member = stack.back();
+                        stack.pop_back();
+                        component[member] = components;
+                    } while (member != node);
+                    ++components;
+                }
+                calls.pop_back();
+                if (!calls.empty()) {
+                    size_t caller = calls.back().first;
+                    low[caller] = min(low[caller], low[node]);
+                }
+            }
+        }
+
+        // Each component becomes a task; those holding only groups have nothing to
+        // resolve but still pass on the order
+        _tasks.assign(components, {});
+        _dependents.assign(components, {});
+        _dependencies.assign(components, 0);
+        vector<vector<size_t>> members(components);
+        for (size_t node = 0; node < nodes; ++node) {
+            members[component[node]].push_back(node);
+            if (node < _units.size()) {
+                _tasks[component[node]].push_back(node);
+            }
+        }
+
+        vector<size_t> last_dependent(components, unvisited);
+        for (size_t task = 0; task < components; ++task) {
+            for (auto node : members[task]) {
+                for (auto next : _graph[node]) {
+                    size_t dependency = component[next];
+                    if (dependency != task && last_dependent[dependency] != task) {
+                        last_dependent[dependency] = task;
+                        _dependents[dependency].push_back(task);
+                        ++_dependencies[task];
+                    }
+                }
+            }
+        }
+    }
+
+    shared_value parallel_resolver::run(resolve_context const& context, unsigned threads) const {
+        mutex lock;
+        condition_variable changed;
+        vector<size_t> waiting = _dependencies;
+        deque<size_t> ready;
+        size_t remaining = _tasks.size();
+        bool failed = false;
+        exception_ptr first_error;
+        // Each unit's result is written by the thread that resolves it, and read after all have joined
+        vector<shared_value> results(_units.size());
+
+        for (size_t task = 0; task < _tasks.size(); ++task) {
+            if (waiting[task] == 0) {
+                ready.push_back(task);
+            }
+        }
+
+        auto work = [&]() {
+            // Every unit finishes before the next starts, so the thread's cycle markers
+            // are empty between units
+            auto thread_context = context.fork();
+            unique_lock<mutex> guard(lock);
+            for (;;) {
+                changed.wait(guard, [&]() { return failed || remaining == 0 || !ready.empty(); });
+                if (failed || remaining == 0) {
+                    return;
+                }
+                size_t task = ready.front();
+                ready.pop_front();
+                guard.unlock();
+
+                exception_ptr error;
+                try {
+                    for (auto index : _tasks[task]) {
+                        auto const& u = _units[index];
+                        results[index] = thread_context.resolve(u.value, resolve_source(_root, u.parents)).value;
+                    }
+                } catch (...) {
+                    error = current_exception();
+                }
+
+                guard.lock();
+                if (error) {
+                    if (!failed) {
+                        first_error = error;
+                    }
+                    failed = true;
+                } else {
+                    --remaining;
+                    for (auto dependent : _dependents[task]) {
+                        if (--waiting[dependent] == 0) {
+                            ready.push_back(dependent);
+                        }
+                    }
+                }
+                changed.notify_all();
+            }
+        };
+
+        vector<thread> workers;
+        for (unsigned i = 1; i < threads && i < _tasks.size(); ++i) {
+            try {
+                workers.emplace_back(work);
+            } catch (system_error&) {
+                // Carry on with the threads we have
+                break;
+            }
+        }
+        work();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        if (first_error) {
+            rethrow_exception(first_error);
+        }
+
+        // The root is a simple object, or there would have been no units
+        return assemble(dynamic_pointer_cast<const simple_config_object>(_root), results);
+    }
+
+    shared_value parallel_resolver::assemble(shared_ptr<const simple_config_object> const& object,
+                                             vector<shared_value> const& results) const {
+        auto entries = object->entry_set();
+        bool changed = false;
+        bool unresolved = false;
+        for (auto const& entry : object->entry_set()) {
+            auto const& value = entry.second;
+            if (value->get_resolve_status() == resolve_status::RESOLVED) {
+                continue;
+            }
+
+            shared_value resolved;
+            if (auto nested = dynamic_pointer_cast<const simple_config_object>(value)) {
+                resolved = assemble(nested, results);
+            } else {
+                resolved = results[_unit_of.at(value.get())];
+            }
+
+            // As when resolving an object, a value that resolves to nothing is removed
+            if (resolved != value) {
+                entries = resolved ? entries.set(entry.first, resolved) : entries.erase(entry.first);
+                changed = true;
+            }
+            unresolved = unresolved || (resolved && resolved->get_resolve_status() == resolve_status::UNRESOLVED);
+        }
+        if (!changed) {
+            return object;
+        }
+        return make_shared<simple_config_object>(object->origin(), move(entries),
+                                                 unresolved ? resolve_status::UNRESOLVED : resolve_status::RESOLVED,
+                                                 object->ignores_fallbacks());
+    }
+
+}  // namespace hocon
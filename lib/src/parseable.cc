@@ -10,7 +10,8 @@
 #include <internal/simple_includer.hpp>
 #include <internal/config_document_parser.hpp>
 #include <internal/simple_include_context.hpp>
-#include <internal/config_parser.hpp>
+#include <internal/config_token_parser.hpp>
+#include <internal/json_parser.hpp>
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-variable"
 #include <boost/thread/tss.hpp>
@@ -20,6 +21,16 @@
 #include <leatherman/util/scope_exit.hpp>
 #include <leatherman/locale/locale.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/nowide/convert.hpp>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#endif
 
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
@@ -177,7 +188,7 @@ namespace hocon {
     }
 
     shared_object parseable::parse() const {
-        return force_parsed_to_object(parse_value(config_parse_options()));
+        return force_parsed_to_object(parse_value(options()));
     }
 
     shared_value parseable::parse_value() const {
@@ -208,27 +219,58 @@ namespace hocon {
         }
     }
 
-    shared_value parseable::raw_parse_value(shared_origin origin, config_parse_options const& options) const {
-        auto stream = reader(options);
-
-        // after reader() we will have loaded the content type
+    config_parse_options parseable::with_content_type(config_parse_options const& options) const {
         config_syntax cont_type = content_type();
-        config_parse_options options_with_content_type;
         if (cont_type != config_syntax::UNSPECIFIED) {
-            options_with_content_type = options.set_syntax(cont_type);
-        } else {
-            options_with_content_type = options;
+            return options.set_syntax(cont_type);
+        }
+        return options;
+    }
+
+    token_iterator parseable::tokenize(shared_origin origin, shared_input_buffer input,
+                                       config_parse_options const& options,
+                                       config_parse_options& options_with_content_type) const {
+        // Sources without a contiguous buffer are read through a stream.
+        unique_ptr<istream> stream;
+        if (!input) {
+            stream = reader(options);
         }
 
-        return raw_parse_value(move(stream), origin, options_with_content_type);
+        // after reader() we will have loaded the content type
+        options_with_content_type = with_content_type(options);
+
+        auto syntax = options_with_content_type.get_syntax();
+        bool track_lines = options_with_content_type.get_track_origins();
+        if (input) {
+            return token_iterator(move(origin), move(input), syntax, track_lines);
+        }
+        return token_iterator(move(origin), move(stream), syntax, track_lines);
     }
 
-    shared_value parseable::raw_parse_value(unique_ptr<istream> stream, shared_origin origin,
+    shared_value parseable::raw_parse_value(shared_origin origin, config_parse_options const& options) const {
+        auto input = buffer();
+
+        // Strict JSON is parsed straight from the buffer; anything else, including
+        // invalid JSON, goes through the tokenizer for its results and errors. A
+        // buffer's content type is known without reading it.
+        if (input) {
+            auto json_options = with_content_type(options);
+            if (json_options.get_syntax() == config_syntax::JSON) {
+                if (auto value = json_parser::parse(*input, origin, json_options.get_track_origins())) {
+                    return value;
+                }
+            }
+        }
+
+        config_parse_options options_with_content_type;
+        auto tokens = tokenize(origin, move(input), options, options_with_content_type);
+        return raw_parse_value(move(tokens), origin, options_with_content_type);
+    }
+
+    shared_value parseable::raw_parse_value(token_iterator tokens, shared_origin origin,
                                             config_parse_options const& options) const {
         // config_syntax::PROPERTIES handling not needed because we don't plan to support it.
-        token_iterator tokens(origin, move(stream), options.get_syntax());
-        auto document = config_document_parser::parse(move(tokens), origin, options);
-        return config_parser::parse(document, origin, options, _include_context);
+        return config_token_parser::parse(move(tokens), move(origin), options, _include_context);
     }
 
     shared_ptr<config_document> parseable::parse_document(config_parse_options const& base_options) const {
@@ -264,24 +306,14 @@ namespace hocon {
 
     std::shared_ptr<config_document> parseable::raw_parse_document(shared_origin origin,
                                                                    config_parse_options const& options) const {
-        auto stream = reader(options);
-
-        config_syntax cont_type = content_type();
-
         config_parse_options options_with_content_type;
-        if (cont_type != config_syntax::UNSPECIFIED) {
-            options_with_content_type = options.set_syntax(cont_type);
-        } else {
-            options_with_content_type = options;
-        }
-
-        return raw_parse_document(move(stream), move(origin), options_with_content_type);
+        auto tokens = tokenize(origin, buffer(), options, options_with_content_type);
+        return raw_parse_document(move(tokens), move(origin), options_with_content_type);
     }
 
-    std::shared_ptr<config_document> parseable::raw_parse_document(std::unique_ptr<std::istream> stream,
+    std::shared_ptr<config_document> parseable::raw_parse_document(token_iterator tokens,
                                                                    shared_origin origin,
                                                                    config_parse_options const& options) const {
-        auto tokens = token_iterator(origin, move(stream), options.get_syntax());
         return make_shared<simple_config_document>(config_document_parser::parse(move(tokens), origin, options), options);
     }
 
@@ -289,6 +321,10 @@ namespace hocon {
         return reader();
     }
 
+    shared_input_buffer parseable::buffer() const {
+        return nullptr;
+    }
+
     /** Parseable file */
     parseable_file::parseable_file(std::string input_file_path, config_parse_options options) :
         _input(move(input_file_path)) {
@@ -302,6 +338,121 @@ namespace hocon {
         return unique_ptr<istream>(new boost::nowide::ifstream(_input.c_str()));
     }
 
+    /** The file's path, widened from UTF-8 on Windows so any file name can be opened. */
+    static boost::filesystem::path native_path(string const& file) {
+#ifdef _WIN32
+        return boost::filesystem::path(boost::nowide::widen(file));
+#else
+        return boost::filesystem::path(file);
+#endif
+    }
+
+    /** Below this size a single read is cheaper than setting up a mapping. */
+    static const uintmax_t min_mapped_size = 64 * 1024;
+
+    /**
+     * An input_buffer over a read-only memory mapping of a file, so the tokenizer reads
+     * straight from the page cache and processes loading the same file share its pages.
+     *
+     * The mapping sees the file as it changes. If another process truncates the file
+     * while it is being parsed, reading the pages past its new end raises SIGBUS on
+     * POSIX systems, which ends the process; Windows refuses to truncate a mapped file.
+     * Files that are rewritten while programs load them should be replaced by renaming
+     * a new file over them, which leaves the mapped one intact.
+     */
+    class mapped_file_input_buffer : public input_buffer {
+    public:
+        /** Maps the file, returning nullptr if it can't be mapped. */
+        static shared_ptr<mapped_file_input_buffer> map(boost::filesystem::path const& file) {
+            auto result = make_shared<mapped_file_input_buffer>();
+            return result->open(file) ? result : nullptr;
+        }
+
+        mapped_file_input_buffer() : input_buffer(nullptr, nullptr) {}
+
+#ifdef _WIN32
+        ~mapped_file_input_buffer() {
+            if (_begin) {
+                UnmapViewOfFile(_begin);
+            }
+            if (_mapping) {
+                CloseHandle(_mapping);
+            }
+            if (_file != INVALID_HANDLE_VALUE) {
+                CloseHandle(_file);
+            }
+        }
+
+    private:
+        bool open(boost::filesystem::path const& file) {
+            _file = CreateFileW(file.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            LARGE_INTEGER size;
+            if (_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(_file, &size)) {
+                return false;
+            }
+            _mapping = CreateFileMappingW(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!_mapping) {
+                return false;
+            }
+            _begin = static_cast<char const*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+            if (!_begin) {
+                return false;
+            }
+            _end = _begin + size.QuadPart;
+            return true;
+        }
+
+        HANDLE _file = INVALID_HANDLE_VALUE;
+        HANDLE _mapping = nullptr;
+#else
+    private:
+        bool open(boost::filesystem::path const& file) {
+            try {
+                _mapping = boost::interprocess::file_mapping(file.c_str(), boost::interprocess::read_only);
+                _region = boost::interprocess::mapped_region(_mapping, boost::interprocess::read_only);
+            } catch (boost::interprocess::interprocess_exception&) {
+                return false;
+            }
+            _begin = static_cast<char const*>(_region.get_address());
+            _end = _begin + _region.get_size();
+            return true;
+        }
+
+        boost::interprocess::file_mapping _mapping;
+        boost::interprocess::mapped_region _region;
+#endif
+    };
+
+    shared_input_buffer parseable_file::buffer() const {
+        // Only regular files big enough to be worth it are mapped; special files can't be
+        // mapped or sized, and small ones are read at once like any other.
+        auto native = native_path(_input);
+        boost::system::error_code ec;
+        auto length = boost::filesystem::is_regular_file(native, ec) ? boost::filesystem::file_size(native, ec) : 0;
+        if (!ec && length >= min_mapped_size) {
+            if (auto mapped = mapped_file_input_buffer::map(native)) {
+                return mapped;
+            }
+        }
+
+        // Read the whole file with a single read and tokenize it from memory; the
+        // chunked stream reader is left as the fallback for files we can't size.
+        boost::nowide::ifstream file(_input.c_str(), ios::in | ios::binary);
+        if (!file || !file.seekg(0, ios::end)) {
+            return nullptr;
+        }
+        auto size = file.tellg();
+        if (size < 0 || !file.seekg(0, ios::beg)) {
+            return nullptr;
+        }
+        string contents(static_cast<size_t>(size), '\0');
+        if (size > 0 && !file.read(&contents[0], size)) {
+            return nullptr;
+        }
+        return make_shared<string_input_buffer>(move(contents));
+    }
+
     shared_origin parseable_file::create_origin() const {
         return make_shared<simple_config_origin>("file: " + _input);
     }
@@ -319,6 +470,11 @@ namespace hocon {
         return unique_ptr<istringstream>(new istringstream(_input));
     }
 
+    shared_input_buffer parseable_string::buffer() const {
+        // The string outlives any parse of it, so it can be scanned where it is.
+        return make_shared<input_buffer>(_input.data(), _input.data() + _input.size());
+    }
+
     shared_origin parseable_string::create_origin() const {
         return make_shared<simple_config_origin>("string");
     }
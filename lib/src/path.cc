@@ -3,6 +3,7 @@
 #include <internal/path_builder.hpp>
 #include <internal/config_util.hpp>
 #include <internal/path_parser.hpp>
+#include <internal/symbol_table.hpp>
 #include <leatherman/locale/locale.hpp>
 #include <algorithm>
 
@@ -13,72 +14,115 @@ using namespace std;
 
 namespace hocon {
 
-    path::path() { }
+    /**
+     * The element array shared by a path and all of its slices. prefix_hashes[i] is the
+     * hash of the first i elements, from which the hash of any slice can be derived.
+     */
+    struct path::elements {
+        vector<symbol_ref> symbols;
+        vector<size_t> prefix_hashes;
+    };
+
+    static const size_t hash_multiplier = 1099511628211u;
+
+    static size_t power(size_t base, size_t exponent) {
+        size_t result = 1;
+        for (; exponent; exponent >>= 1) {
+            if (exponent & 1) {
+                result *= base;
+            }
+            base *= base;
+        }
+        return result;
+    }
 
-    path::path(List<shared_string> other_path) : _path(move(other_path)) { }
+    path::path() : _begin(0), _end(0) { }
 
-    path::path(string first, path const& remainder) :
-            _path(make_shared<string>(move(first)), remainder._path) { }
+    path::path(shared_ptr<const elements> elements, size_t begin, size_t end) :
+            _elements(move(elements)), _begin(begin), _end(end) {
+        if (_begin == _end) {
+            // empty slices don't keep the array alive
+            _elements.reset();
+            _begin = _end = 0;
+        }
+    }
+
+    path path::from_symbols(vector<symbol_ref> symbols) {
+        if (symbols.empty()) {
+            return path { };
+        }
+        auto result = make_shared<elements>();
+        result->prefix_hashes.reserve(symbols.size() + 1);
+        result->prefix_hashes.push_back(0);
+        for (auto const& s : symbols) {
+            result->prefix_hashes.push_back(result->prefix_hashes.back() * hash_multiplier + s->hash);
+        }
+        result->symbols = move(symbols);
+        size_t size = result->symbols.size();
+        return path(move(result), 0, size);
+    }
 
-    path::path(vector<string> elements) {
+    symbol_ref const& path::element(size_t index) const {
+        return _elements->symbols[_begin + index];
+    }
+
+    path::path(string first, path const& remainder) : path() {
+        path_builder builder;
+        builder.append_key(first);
+        builder.append_path(remainder);
+        *this = builder.result();
+    }
+
+    path::path(vector<string> elements) : path() {
         if (elements.size() == 0) {
             throw config_exception(_("Empty path"));
         }
 
-        path remainder;
-        if (elements.size() > 1) {
-            path_builder builder;
-            for (size_t i = 1; i < elements.size(); i++) {
-                builder.append_key(elements[i]);
-            }
-            remainder = builder.result();
+        path_builder builder;
+        for (auto const& element : elements) {
+            builder.append_key(element);
         }
-        _path = List<shared_string>(make_shared<string>(move(elements[0])), remainder._path);
+        *this = builder.result();
     }
 
-    path::path(vector<path> paths_to_concat) {
+    path::path(vector<path> paths_to_concat) : path() {
         if (paths_to_concat.size() == 0) {
             throw config_exception(_("Empty path"));
         }
 
         path_builder builder;
-        if (paths_to_concat[0].has_remainder()) {
-            builder.append_path(paths_to_concat[0].remainder());
+        for (auto const& p : paths_to_concat) {
+            builder.append_path(p);
         }
-
-        for (size_t i = 1; i < paths_to_concat.size(); i++) {
-            builder.append_path(paths_to_concat[i]);
-        }
-        _path = List<shared_string>(paths_to_concat[0].first(), builder.result()._path);
+        *this = builder.result();
     }
 
     shared_string path::first() const {
-        if (_path.isEmpty()) {
+        if (empty()) {
             return nullptr;
         }
-        return _path.front();
+        return symbol_table::shared_text(element(0));
     }
 
     path path::remainder() const {
-        if (_path.isEmpty()) {
+        if (empty()) {
             return path { };
         }
-        return path(_path.popped_front());
+        return path(_elements, _begin + 1, _end);
     }
 
     bool path::has_remainder() const {
-        return !remainder()._path.isEmpty();
+        return _end - _begin > 1;
     }
 
     shared_string path::last() const {
-        path p = *this;
-        while (p.has_remainder()) {
-            p = p.remainder();
+        if (empty()) {
+            return nullptr;
         }
-        return p.first();
+        return symbol_table::shared_text(element(_end - _begin - 1));
     }
 
-    path path::prepend(path prefix) {
+    path path::prepend(path prefix) const {
         path_builder builder;
         builder.append_path(prefix);
         builder.append_path(*this);
@@ -86,93 +130,82 @@ namespace hocon {
     }
 
     int path::length() const {
-        int length = 1;
-        path p = *this;
-        while (p.has_remainder()) {
-            length++;
-            p = p.remainder();
-        }
-        return length;
+        return static_cast<int>(_end - _begin);
     }
 
-    path path::sub_path(int remove_from_front) {
-        int count = remove_from_front;
-        path p = *this;
-        while (p.has_remainder() && count > 0) {
-            count--;
-            p = p.remainder();
+    path path::sub_path(int remove_from_front) const {
+        if (empty()) {
+            return *this;
         }
-        return p;
+        // Like walking remainder(), this stops at the last element
+        size_t removed = min(static_cast<size_t>(max(remove_from_front, 0)), _end - _begin - 1);
+        return path(_elements, _begin + removed, _end);
     }
 
-    path path::sub_path(int first_index, int last_index) {
+    path path::sub_path(int first_index, int last_index) const {
         if (last_index < first_index) {
             throw config_exception(_("Bad call to sub_path: invalid range"));
         }
 
         path from = sub_path(first_index);
-        path_builder builder;
         int count = last_index - first_index;
-        while (count > 0) {
-            count--;
-            builder.append_key(*from.first());
-            from = from.remainder();
-            if (from.empty()) {
-                throw config_exception(_("sub_path last_index out of range"));
-            }
+        if (count > 0 && count >= from.length()) {
+            throw config_exception(_("sub_path last_index out of range"));
         }
-        return builder.result();
+        return path(from._elements, from._begin, from._begin + count);
     }
 
     bool path::empty() const {
-        return _path.isEmpty();
+        return _begin == _end;
     }
 
     bool path::starts_with(path other) const {
-        path my_remainder = *this;
-        path other_remainder = other;
-        if (other_remainder.length() <= my_remainder.length()) {
-            while (other_remainder.first()) {
-                if (*other_remainder.first() != *my_remainder.first()) {
-                    return false;
-                }
-                my_remainder = my_remainder.remainder();
-                other_remainder = other_remainder.remainder();
+        if (other.length() > length()) {
+            return false;
+        }
+        for (size_t i = 0; i < other._end - other._begin; ++i) {
+            if (!symbol_table::same(*element(i), *other.element(i))) {
+                return false;
             }
-            return true;
         }
-        return false;
+        return true;
     }
 
     path path::parent() const {
         if (!has_remainder()) {
             return path { };
         }
-
-        path_builder builder;
-        path p = *this;
-        while (p.has_remainder()) {
-            builder.append_key(*p.first());
-            p = p.remainder();
-        }
-        return builder.result();
+        return path(_elements, _begin, _end - 1);
     }
 
     bool path::operator==(path const& other) const {
-        if ((first() == nullptr) ^ (other.first() == nullptr)) {
+        if (length() != other.length()) {
             return false;
         }
-        if (first() == nullptr && other.first() == nullptr) {
+        if (_elements == other._elements && _begin == other._begin) {
             return true;
         }
-        return *first() == *other.first() &&
-               remainder() == other.remainder();
+        // elements with the same text are usually the same symbol
+        for (size_t i = 0; i < _end - _begin; ++i) {
+            if (!symbol_table::same(*element(i), *other.element(i))) {
+                return false;
+            }
+        }
+        return true;
     }
 
     bool path::operator!=(path const& other) const {
         return !(*this == other);
     }
 
+    size_t path::hash() const {
+        if (empty()) {
+            return 0;
+        }
+        auto const& prefix = _elements->prefix_hashes;
+        return prefix[_end] - prefix[_begin] * power(hash_multiplier, _end - _begin);
+    }
+
     bool path::has_funky_chars(string const& s) {
         auto bad_char = find_if(s.begin(), s.end(), [] (char c) {
             return !(isalnum(c) || c == '-' || c == '_');
@@ -182,17 +215,16 @@ namespace hocon {
     }
 
     void path::append_to_string(std::string &base) const {
-        if (_path.isEmpty()) {
-            return;
-        }
-        if (has_funky_chars(*first()) || first()->empty()) {
-            base += render_json_string(*first());
-        } else {
-            base += *first();
-        }
-        if (has_remainder()) {
-            base += ".";
-            remainder().append_to_string(base);
+        for (size_t i = 0; i < _end - _begin; ++i) {
+            if (i > 0) {
+                base += ".";
+            }
+            string const& key = element(i)->text;
+            if (has_funky_chars(key) || key.empty()) {
+                base += render_json_string(key);
+            } else {
+                base += key;
+            }
         }
     }
 
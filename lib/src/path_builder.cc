@@ -4,35 +4,19 @@ using namespace std;
 
 namespace hocon {
 
-    void path_builder::append_key(string key) {
-        _keys.push(key);
+    void path_builder::append_key(string const& key) {
+        // Path elements are only compared with object keys by hash and text, so they aren't added to the table
+        _keys.push_back(symbol_table::unlisted(key));
     }
 
     void path_builder::append_path(path path_to_append) {
-        if (!path_to_append.first()) {
-            return;
-        }
-        string first = *path_to_append.first();
-        path remainder = path_to_append;
-        while (true) {
-            _keys.push(first);
-            if (remainder.has_remainder()) {
-                remainder = remainder.remainder();
-                first = *remainder.first();
-            } else {
-                break;
-            }
+        for (int i = 0; i < path_to_append.length(); ++i) {
+            _keys.push_back(path_to_append.element(i));
         }
     }
 
     path path_builder::result() {
-        path remainder;
-        while (!_keys.empty()) {
-            string key = _keys.top();
-            _keys.pop();
-            remainder = path(key, move(remainder));
-        }
-        return remainder;
+        return path::from_symbols(move(_keys));
     }
 
 }  // namesapce hocon
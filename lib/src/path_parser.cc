@@ -1,6 +1,5 @@
 #include <internal/path_parser.hpp>
 #include <internal/tokens.hpp>
-#include <sstream>
 #include <internal/values/config_string.hpp>
 #include <boost/algorithm/string.hpp>
 #include <leatherman/locale/locale.hpp>
@@ -26,7 +25,8 @@ namespace hocon {
 
     config_node_path path_parser::parse_path_node(string const& path_string, config_syntax flavor) {
         token_iterator tokens = token_iterator(api_origin,
-                                               unique_ptr<istringstream>(new istringstream(path_string)),
+                                               make_shared<input_buffer>(path_string.data(),
+                                                                         path_string.data() + path_string.size()),
                                                (flavor != config_syntax::JSON));
 
         tokens.next();  // drop start token
@@ -40,7 +40,8 @@ namespace hocon {
         }
 
         token_iterator tokens = token_iterator(api_origin,
-                                               unique_ptr<istringstream>(new istringstream(path_string)),
+                                               make_shared<input_buffer>(path_string.data(),
+                                                                         path_string.data() + path_string.size()),
                                                true);
         tokens.next();  // drop start token
         return parse_path_expression(tokens, api_origin, path_string);
@@ -229,15 +230,16 @@ namespace hocon {
     }
 
     path path_parser::fast_path_build(path tail, string s) {
-        size_t split_at = s.find_last_of('.');
-        token_list tokens;
-        tokens.push_back(make_shared<unquoted_text>(nullptr, s));
-        path with_one_more_element = path(s.substr(split_at + 1), tail);
-        if (split_at == string::npos) {
-            return with_one_more_element;
-        } else {
-            return fast_path_build(with_one_more_element, s.substr(0, split_at));
+        // Build the whole path in one go rather than prepending one element at a time
+        path_builder builder;
+        size_t start = 0;
+        for (size_t dot = s.find('.'); dot != string::npos; dot = s.find('.', start)) {
+            builder.append_key(s.substr(start, dot - start));
+            start = dot + 1;
         }
+        builder.append_key(s.substr(start));
+        builder.append_path(tail);
+        return builder.result();
     }
 
     path path_parser::speculative_fast_parse_path(std::string const& path_string) {
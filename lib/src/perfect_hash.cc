@@ -0,0 +1,134 @@
+#include <internal/perfect_hash.hpp>
+#include <algorithm>
+
+using namespace std;
+
+namespace hocon {
+
+    // A displacement with this bit set is the slot itself rather than a seed
+    static const uint32_t direct_slot = 0x80000000u;
+
+    // Values per bucket on average; smaller buckets are quicker to place
+    static const size_t bucket_load = 2;
+
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        return x;
+    }
+
+    // Maps a mixed value onto [0, range) with a multiply rather than a division;
+    // range is always below 2^31
+    static size_t reduce(uint64_t x, size_t range) {
+        return static_cast<size_t>(((x >> 32) * range) >> 32);
+    }
+
+    static size_t bucket_of(size_t hash, size_t buckets) {
+        return reduce(mix(hash), buckets);
+    }
+
+    static size_t place(size_t hash, uint32_t seed, size_t size) {
+        return reduce(mix(hash + (seed + 1ull) * 0x9e3779b97f4a7c15ull), size);
+    }
+
+    bool perfect_hash::build(vector<size_t> const& hashes) {
+        _displacements.clear();
+        _size = 0;
+        if (hashes.empty()) {
+            return true;
+        }
+        if (hashes.size() >= direct_slot) {
+            return false;
+        }
+
+        size_t size = hashes.size();
+        size_t buckets = (size + bucket_load - 1) / bucket_load;
+
+        // Group the values by bucket
+        vector<size_t> starts(buckets + 1, 0);
+        for (size_t h : hashes) {
+            ++starts[bucket_of(h, buckets) + 1];
+        }
+        size_t largest = 0;
+        for (size_t b = 0; b < buckets; ++b) {
+            largest = max(largest, starts[b + 1]);
+            starts[b + 1] += starts[b];
+        }
+        vector<size_t> grouped(size);
+        vector<size_t> next(starts.begin(), starts.end() - 1);
+        for (size_t h : hashes) {
+            grouped[next[bucket_of(h, buckets)]++] = h;
+        }
+
+        // Equal values always share a bucket, where no seed could separate them
+        for (size_t b = 0; b < buckets; ++b) {
+            for (size_t i = starts[b]; i < starts[b + 1]; ++i) {
+                if (find(grouped.begin() + i + 1, grouped.begin() + starts[b + 1], grouped[i]) != grouped.begin() + starts[b + 1]) {
+                    return false;
+                }
+            }
+        }
+
+        // Place the largest buckets first, while there are plenty of free slots
+        vector<vector<uint32_t>> by_size(largest + 1);
+        for (size_t b = 0; b < buckets; ++b) {
+            by_size[starts[b + 1] - starts[b]].push_back(static_cast<uint32_t>(b));
+        }
+        vector<uint32_t> order;
+        order.reserve(buckets);
+        for (size_t count = largest; count > 0; --count) {
+            order.insert(order.end(), by_size[count].begin(), by_size[count].end());
+        }
+
+        vector<uint32_t> displacements(buckets, 0);
+        vector<char> taken(size, false);
+        vector<size_t> slots;
+        size_t free_slot = 0;
+        for (uint32_t b : order) {
+            size_t first = starts[b], last = starts[b + 1];
+            if (last - first == 1) {
+                while (taken[free_slot]) {
+                    ++free_slot;
+                }
+                taken[free_slot] = true;
+                displacements[b] = direct_slot | static_cast<uint32_t>(free_slot);
+                continue;
+            }
+            for (uint32_t seed = 0; ; ++seed) {
+                if (seed == direct_slot) {
+                    return false;
+                }
+                slots.clear();
+                bool placed = true;
+                for (size_t i = first; i < last && placed; ++i) {
+                    size_t s = place(grouped[i], seed, size);
+                    placed = !taken[s] && find(slots.begin(), slots.end(), s) == slots.end();
+                    slots.push_back(s);
+                }
+                if (placed) {
+                    for (size_t s : slots) {
+                        taken[s] = true;
+                    }
+                    displacements[b] = seed;
+                    break;
+                }
+            }
+        }
+
+        _displacements = move(displacements);
+        _size = size;
+        return true;
+    }
+
+    size_t perfect_hash::slot(size_t hash) const {
+        uint32_t d = _displacements[bucket_of(hash, _displacements.size())];
+        if (d & direct_slot) {
+            return d & ~direct_slot;
+        }
+        return place(hash, d, _size);
+    }
+
+}  // namespace hocon
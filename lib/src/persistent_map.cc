@@ -0,0 +1,523 @@
+#include <hocon/persistent_map.hpp>
+#include <internal/symbol_table.hpp>
+#include <algorithm>
+#include <bitset>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace hocon {
+
+    /**
+     * A trie node. Entries whose hash fragment at this level is unique are kept inline,
+     * flagged in entry_map; fragments shared by several keys lead to a child node,
+     * flagged in child_map. Both vectors are ordered by fragment, so the position of a
+     * fragment is the number of lower bits set in its map.
+     *
+     * Below the last level that has hash bits left, a node holds keys with identical
+     * hashes as a plain list of entries and has no children.
+     *
+     * Nodes are never modified once built; an update builds new nodes along its path.
+     */
+    struct persistent_map::node {
+        struct entry {
+            entry(symbol_ref key, shared_value value) : key(move(key)), key_value(this->key->text, move(value)) {}
+
+            symbol_ref key;
+            value_type key_value;
+        };
+
+        uint32_t entry_map = 0;
+        uint32_t child_map = 0;
+        vector<entry> entries;
+        vector<shared_ptr<const node>> children;
+    };
+
+    static size_t hash_key(string const& key) {
+        return std::hash<string>()(key);
+    }
+
+    static unsigned fragment(size_t hash, unsigned shift) {
+        return (hash >> shift) & 31;
+    }
+
+    static uint32_t fragment_bit(size_t hash, unsigned shift) {
+        return uint32_t(1) << fragment(hash, shift);
+    }
+
+    /** The index in a node's vector of the fragment flagged by bit. */
+    static size_t position(uint32_t map, uint32_t bit) {
+        return bitset<32>(map & (bit - 1)).count();
+    }
+
+    /** A key looked up by its own symbol is the entry's text itself. */
+    static bool same_key(string const& entry_key, string const& key) {
+        return &entry_key == &key || entry_key == key;
+    }
+
+    /** The trie walks are static members so they can name the private node type. */
+    struct persistent_map_ops {
+        using node = persistent_map::node;
+        using entry = node::entry;
+        using shared_node = shared_ptr<const node>;
+        using item = pair<symbol_ref, shared_value>;
+        static const unsigned bits_per_level = persistent_map::bits_per_level;
+        static const unsigned hash_bits = persistent_map::hash_bits;
+
+        static bool is_collision_level(unsigned shift) {
+            return shift >= hash_bits;
+        }
+
+        /*
+         * Entries refer to their key's text, so they can be constructed but not assigned.
+         * These build a node's new entry vector in one pass instead of editing a copy.
+         */
+
+        static vector<entry> with_entry_replaced(vector<entry> const& entries, size_t index, entry const& replacement) {
+            vector<entry> result;
+            result.reserve(entries.size());
+            for (size_t i = 0; i < entries.size(); ++i) {
+                result.push_back(i == index ? replacement : entries[i]);
+            }
+            return result;
+        }
+
+        static vector<entry> with_entry_inserted(vector<entry> const& entries, size_t index, entry const& added) {
+            vector<entry> result;
+            result.reserve(entries.size() + 1);
+            for (size_t i = 0; i < entries.size(); ++i) {
+                if (i == index) {
+                    result.push_back(added);
+                }
+                result.push_back(entries[i]);
+            }
+            if (index == entries.size()) {
+                result.push_back(added);
+            }
+            return result;
+        }
+
+        static vector<entry> with_entry_removed(vector<entry> const& entries, size_t index) {
+            vector<entry> result;
+            result.reserve(entries.size() - 1);
+            for (size_t i = 0; i < entries.size(); ++i) {
+                if (i != index) {
+                    result.push_back(entries[i]);
+                }
+            }
+            return result;
+        }
+
+        static shared_ptr<node> copy_with_entries(node const& original, vector<entry> entries) {
+            auto result = make_shared<node>();
+            result->entry_map = original.entry_map;
+            result->child_map = original.child_map;
+            result->entries = move(entries);
+            result->children = original.children;
+            return result;
+        }
+
+        /**
+         * Builds the subtree for items with distinct keys, all of which share the hash
+         * fragments above shift, by bucketing them on their fragment at this level.
+         */
+        static shared_node build(item const* first, item const* last, unsigned shift) {
+            auto result = make_shared<node>();
+            size_t count = last - first;
+            if (is_collision_level(shift)) {
+                result->entries.reserve(count);
+                for (auto it = first; it != last; ++it) {
+                    result->entries.emplace_back(it->first, it->second);
+                }
+                return result;
+            }
+
+            uint32_t seen = 0;
+            uint32_t shared = 0;
+            for (auto it = first; it != last; ++it) {
+                uint32_t bit = fragment_bit(it->first->hash, shift);
+                shared |= seen & bit;
+                seen |= bit;
+            }
+            result->entry_map = seen & ~shared;
+            result->child_map = shared;
+
+            // Entries go in fragment order; an insertion sort is quick for at most 32
+            item const* singles[32];
+            size_t single_count = 0;
+            for (auto it = first; it != last; ++it) {
+                if (result->entry_map & fragment_bit(it->first->hash, shift)) {
+                    size_t i = single_count++;
+                    auto f = fragment(it->first->hash, shift);
+                    for (; i > 0 && fragment(singles[i - 1]->first->hash, shift) > f; --i) {
+                        singles[i] = singles[i - 1];
+                    }
+                    singles[i] = it;
+                }
+            }
+            result->entries.reserve(single_count);
+            for (size_t i = 0; i < single_count; ++i) {
+                result->entries.emplace_back(singles[i]->first, singles[i]->second);
+            }
+            if (!shared) {
+                return result;
+            }
+
+            uint32_t counts[32] = {};
+            for (auto it = first; it != last; ++it) {
+                ++counts[fragment(it->first->hash, shift)];
+            }
+
+            // Group the items that share a fragment so each group can become a child
+            vector<item> grouped(count);
+            size_t offsets[33] = {};
+            for (unsigned f = 0; f < 32; ++f) {
+                offsets[f + 1] = offsets[f] + (counts[f] > 1 ? counts[f] : 0);
+            }
+            size_t next[32];
+            copy(offsets, offsets + 32, next);
+            for (auto it = first; it != last; ++it) {
+                auto f = fragment(it->first->hash, shift);
+                if (counts[f] > 1) {
+                    grouped[next[f]++] = *it;
+                }
+            }
+
+            result->children.reserve(bitset<32>(result->child_map).count());
+            for (unsigned f = 0; f < 32; ++f) {
+                if (counts[f] > 1) {
+                    result->children.push_back(build(grouped.data() + offsets[f], grouped.data() + offsets[f + 1],
+                                                     shift + bits_per_level));
+                }
+            }
+            return result;
+        }
+
+        static shared_node insert(shared_node const& original, entry const& added_entry, unsigned shift, bool& added) {
+            if (is_collision_level(shift)) {
+                for (size_t i = 0; i < original->entries.size(); ++i) {
+                    if (original->entries[i].key == added_entry.key) {
+                        return copy_with_entries(*original, with_entry_replaced(original->entries, i, added_entry));
+                    }
+                }
+                added = true;
+                return copy_with_entries(*original,
+                                         with_entry_inserted(original->entries, original->entries.size(), added_entry));
+            }
+
+            uint32_t bit = fragment_bit(added_entry.key->hash, shift);
+            if (original->entry_map & bit) {
+                size_t index = position(original->entry_map, bit);
+                auto const& existing = original->entries[index];
+                if (existing.key == added_entry.key) {
+                    return copy_with_entries(*original, with_entry_replaced(original->entries, index, added_entry));
+                }
+
+                // Two keys now share this fragment, so they move down into a child node
+                item moved[] { { existing.key, existing.key_value.second },
+                               { added_entry.key, added_entry.key_value.second } };
+                auto result = copy_with_entries(*original, with_entry_removed(original->entries, index));
+                result->entry_map ^= bit;
+                result->child_map |= bit;
+                result->children.insert(result->children.begin() + position(result->child_map, bit),
+                                        build(moved, moved + 2, shift + bits_per_level));
+                added = true;
+                return result;
+            } else if (original->child_map & bit) {
+                size_t index = position(original->child_map, bit);
+                auto result = make_shared<node>(*original);
+                result->children[index] = insert(original->children[index], added_entry, shift + bits_per_level, added);
+                return result;
+            } else {
+                auto result = copy_with_entries(*original, with_entry_inserted(original->entries,
+                                                                               position(original->entry_map, bit),
+                                                                               added_entry));
+                result->entry_map |= bit;
+                added = true;
+                return result;
+            }
+        }
+
+        /** Returns original itself when key isn't present. */
+        static shared_node remove(shared_node const& original, size_t hash, string const& key, unsigned shift) {
+            if (is_collision_level(shift)) {
+                for (size_t i = 0; i < original->entries.size(); ++i) {
+                    if (same_key(original->entries[i].key_value.first, key)) {
+                        return copy_with_entries(*original, with_entry_removed(original->entries, i));
+                    }
+                }
+                return original;
+            }
+
+            uint32_t bit = fragment_bit(hash, shift);
+            if (original->entry_map & bit) {
+                size_t index = position(original->entry_map, bit);
+                auto const& existing = original->entries[index];
+                if (existing.key->hash != hash || !same_key(existing.key_value.first, key)) {
+                    return original;
+                }
+                auto result = copy_with_entries(*original, with_entry_removed(original->entries, index));
+                result->entry_map ^= bit;
+                return result;
+            } else if (original->child_map & bit) {
+                size_t index = position(original->child_map, bit);
+                auto const& child = original->children[index];
+                auto new_child = remove(child, hash, key, shift + bits_per_level);
+                if (new_child == child) {
+                    return original;
+                }
+
+                if (new_child->children.empty() && new_child->entries.size() == 1) {
+                    // A lone entry moves back up, so each child always holds at least two
+                    auto result = copy_with_entries(*original, with_entry_inserted(original->entries,
+                                                                                   position(original->entry_map, bit),
+                                                                                   new_child->entries.front()));
+                    result->entry_map |= bit;
+                    result->children.erase(result->children.begin() + index);
+                    result->child_map ^= bit;
+                    return result;
+                }
+                auto result = make_shared<node>(*original);
+                result->children[index] = move(new_child);
+                return result;
+            }
+            return original;
+        }
+
+        static void descend(persistent_map::const_iterator& it, node const* trie_node, uint32_t entry) {
+            it._stack[it._depth++] = { trie_node, entry, 0 };
+        }
+
+        /** Appends every entry under trie_node, which may be null. */
+        static void collect(node const* trie_node, vector<entry const*>& entries) {
+            if (!trie_node) {
+                return;
+            }
+            for (auto const& e : trie_node->entries) {
+                entries.push_back(&e);
+            }
+            for (auto const& child : trie_node->children) {
+                collect(child.get(), entries);
+            }
+        }
+
+        /** Compares two lists of entries, matching keys by their interned symbol. */
+        static void difference(vector<entry const*> const& mine, vector<entry const*> const& theirs,
+                               persistent_map::difference_visitor const& visit) {
+            static const shared_value none;
+            for (auto m : mine) {
+                auto t = find_if(theirs.begin(), theirs.end(), [&](entry const* e) { return e->key == m->key; });
+                if (t == theirs.end()) {
+                    visit(m->key_value.first, m->key_value.second, none);
+                } else if ((*t)->key_value.second != m->key_value.second) {
+                    visit(m->key_value.first, m->key_value.second, (*t)->key_value.second);
+                }
+            }
+            for (auto t : theirs) {
+                if (none_of(mine.begin(), mine.end(), [&](entry const* e) { return e->key == t->key; })) {
+                    visit(t->key_value.first, none, t->key_value.second);
+                }
+            }
+        }
+
+        static void difference(node const* mine, node const* theirs, unsigned shift,
+                               persistent_map::difference_visitor const& visit) {
+            if (mine == theirs) {
+                return;
+            }
+            if (!mine || !theirs || is_collision_level(shift)) {
+                vector<entry const*> my_entries, their_entries;
+                collect(mine, my_entries);
+                collect(theirs, their_entries);
+                difference(my_entries, their_entries, visit);
+                return;
+            }
+
+            // Walk the fragments together, descending only where both sides have a child
+            for (unsigned f = 0; f < 32; ++f) {
+                uint32_t bit = uint32_t(1) << f;
+                bool my_child = mine->child_map & bit, their_child = theirs->child_map & bit;
+                if (my_child && their_child) {
+                    difference(mine->children[position(mine->child_map, bit)].get(),
+                               theirs->children[position(theirs->child_map, bit)].get(),
+                               shift + bits_per_level, visit);
+                    continue;
+                }
+
+                vector<entry const*> my_entries, their_entries;
+                if (mine->entry_map & bit) {
+                    my_entries.push_back(&mine->entries[position(mine->entry_map, bit)]);
+                } else if (my_child) {
+                    collect(mine->children[position(mine->child_map, bit)].get(), my_entries);
+                }
+                if (theirs->entry_map & bit) {
+                    their_entries.push_back(&theirs->entries[position(theirs->entry_map, bit)]);
+                } else if (their_child) {
+                    collect(theirs->children[position(theirs->child_map, bit)].get(), their_entries);
+                }
+                difference(my_entries, their_entries, visit);
+            }
+        }
+
+        /** Finds key, whose hash is already known, below root. */
+        static persistent_map::const_iterator find(node const* root, string const& key, size_t hash) {
+            persistent_map::const_iterator it;
+            node const* current = root;
+            if (!current) {
+                return it;
+            }
+
+            for (unsigned shift = 0; ; shift += bits_per_level) {
+                if (is_collision_level(shift)) {
+                    for (size_t i = 0; i < current->entries.size(); ++i) {
+                        if (same_key(current->entries[i].key_value.first, key)) {
+                            descend(it, current, static_cast<uint32_t>(i));
+                            it._current = &current->entries[i].key_value;
+                            return it;
+                        }
+                    }
+                    return persistent_map::const_iterator();
+                }
+
+                uint32_t bit = fragment_bit(hash, shift);
+                if (current->entry_map & bit) {
+                    auto index = static_cast<uint32_t>(position(current->entry_map, bit));
+                    auto const& existing = current->entries[index];
+                    if (existing.key->hash != hash || !same_key(existing.key_value.first, key)) {
+                        return persistent_map::const_iterator();
+                    }
+                    descend(it, current, index);
+                    it._current = &existing.key_value;
+                    return it;
+                } else if (current->child_map & bit) {
+                    // Record that this node's entries are done and which child comes next
+                    auto index = static_cast<uint32_t>(position(current->child_map, bit));
+                    it._stack[it._depth++] = { current, static_cast<uint32_t>(current->entries.size()), index + 1 };
+                    current = current->children[index].get();
+                } else {
+                    return persistent_map::const_iterator();
+                }
+            }
+        }
+    };
+
+    persistent_map::persistent_map() : _size(0) {}
+
+    persistent_map::persistent_map(shared_ptr<const node> root, size_type size) :
+        _root(move(root)), _size(size) {}
+
+    persistent_map::persistent_map(unordered_map<string, shared_value> const& values) : _size(values.size()) {
+        if (values.empty()) {
+            return;
+        }
+        vector<persistent_map_ops::item> items;
+        items.reserve(values.size());
+        for (auto const& kv : values) {
+            items.emplace_back(symbol_table::intern(kv.first), kv.second);
+        }
+        _root = persistent_map_ops::build(items.data(), items.data() + items.size(), 0);
+    }
+
+    persistent_map::persistent_map(vector<pair<symbol_ref, shared_value>> const& entries) : _size(entries.size()) {
+        if (!entries.empty()) {
+            _root = persistent_map_ops::build(entries.data(), entries.data() + entries.size(), 0);
+        }
+    }
+
+    persistent_map persistent_map::set(string const& key, shared_value value) const {
+        node::entry added_entry(symbol_table::intern(key), move(value));
+        if (!_root) {
+            auto root = make_shared<node>();
+            root->entry_map = fragment_bit(added_entry.key->hash, 0);
+            root->entries.push_back(move(added_entry));
+            return persistent_map(move(root), 1);
+        }
+        bool added = false;
+        auto root = persistent_map_ops::insert(_root, added_entry, 0, added);
+        return persistent_map(move(root), added ? _size + 1 : _size);
+    }
+
+    persistent_map persistent_map::erase(string const& key) const {
+        if (!_root) {
+            return *this;
+        }
+        auto root = persistent_map_ops::remove(_root, hash_key(key), key, 0);
+        if (root == _root) {
+            return *this;
+        }
+        if (_size == 1) {
+            return persistent_map();
+        }
+        return persistent_map(move(root), _size - 1);
+    }
+
+    persistent_map::const_iterator persistent_map::begin() const {
+        const_iterator it;
+        if (_root) {
+            persistent_map_ops::descend(it, _root.get(), 0);
+            it.settle();
+        }
+        return it;
+    }
+
+    persistent_map::const_iterator persistent_map::find(string const& key) const {
+        return persistent_map_ops::find(_root.get(), key, hash_key(key));
+    }
+
+    persistent_map::const_iterator persistent_map::find(symbol const& key) const {
+        return persistent_map_ops::find(_root.get(), key.text, key.hash);
+    }
+
+    void persistent_map::for_each_difference(persistent_map const& other, difference_visitor const& visit) const {
+        persistent_map_ops::difference(_root.get(), other._root.get(), 0, visit);
+    }
+
+    persistent_map::size_type persistent_map::count(string const& key) const {
+        return find(key) == end() ? 0 : 1;
+    }
+
+    shared_value const& persistent_map::at(string const& key) const {
+        auto it = find(key);
+        if (it == end()) {
+            throw out_of_range("persistent_map::at");
+        }
+        return it->second;
+    }
+
+    shared_value persistent_map::get(string const& key) const {
+        auto it = find(key);
+        return it == end() ? nullptr : it->second;
+    }
+
+    void persistent_map::const_iterator::settle() {
+        while (_depth > 0) {
+            auto& top = _stack[_depth - 1];
+            if (top.entry < top.trie_node->entries.size()) {
+                _current = &top.trie_node->entries[top.entry].key_value;
+                return;
+            }
+            if (top.child < top.trie_node->children.size()) {
+                node const* child = top.trie_node->children[top.child++].get();
+                persistent_map_ops::descend(*this, child, 0);
+                continue;
+            }
+            --_depth;
+        }
+        _current = nullptr;
+    }
+
+    persistent_map::const_iterator& persistent_map::const_iterator::operator++() {
+        ++_stack[_depth - 1].entry;
+        settle();
+        return *this;
+    }
+
+    persistent_map::const_iterator persistent_map::const_iterator::operator++(int) {
+        auto previous = *this;
+        ++*this;
+        return previous;
+    }
+
+}  // namespace hocon
@@ -1,10 +1,14 @@
+#include <hocon/config.hpp>
 #include <hocon/config_exception.hpp>
+#include <hocon/config_object.hpp>
 #include <hocon/config_value.hpp>
+#include <internal/parallel_resolver.hpp>
 #include <internal/resolve_context.hpp>
 #include <internal/resolve_result.hpp>
 #include <internal/resolve_source.hpp>
 #include <leatherman/locale/locale.hpp>
-#include <algorithm>
+
+#include <thread>
 
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
@@ -13,11 +17,30 @@ using namespace std;
 
 namespace hocon {
 
-    resolve_context::resolve_context(config_resolve_options options, path restrict_to_child, vector<shared_value> cycle_markers)
-         : _options(move(options)), _restrict_to_child(move(restrict_to_child)), _cycle_markers(move(cycle_markers)) { }
+    namespace {
+        /** Below this many values to resolve, starting threads costs more than it saves. */
+        const size_t min_parallel_units = 64;
+    }
+
+    resolve_context::resolve_context(config_resolve_options options, path restrict_to_child,
+                                     shared_ptr<memo_table> memos, shared_ptr<cycle_markers> markers)
+         : _options(move(options)), _restrict_to_child(move(restrict_to_child)),
+           _memos(move(memos)), _cycle_markers(move(markers)) { }
 
     resolve_context::resolve_context(config_resolve_options options, path restrict_to_child)
-         : resolve_context(move(options), move(restrict_to_child), vector<shared_value> {}) { }
+         : resolve_context(move(options), move(restrict_to_child), make_shared<memo_table>(),
+                           make_shared<cycle_markers>()) { }
+
+    resolve_context::resolve_context(config_resolve_options options, path restrict_to_child, earlier_results earlier,
+                                     shared_object environment)
+         : resolve_context(move(options), move(restrict_to_child))
+    {
+        _memos->earlier = move(earlier);
+        if (environment) {
+            auto& memos = *_memos;
+            call_once(memos.environment_read, [&]() { memos.environment = move(environment); });
+        }
+    }
 
     bool resolve_context::is_restricted_to_child() const
     {
@@ -34,47 +57,39 @@ namespace hocon {
         memo_key full_key {original, {}};
         memo_key restricted_key = {nullptr, {}};
 
-        shared_value cached;
-        auto cached_iter = _memos.find(full_key);
-        if (cached_iter != _memos.end()) {
-            cached = cached_iter->second;
-        }
+        shared_value cached = find_memo(full_key);
 
         if (!cached && is_restricted_to_child()) {
             restricted_key = {original, restrict_to_child()};
-            auto cached_iter = _memos.find(full_key);
-            if (cached_iter != _memos.end()) {
-                cached = cached_iter->second;
-            }
+            cached = find_memo(restricted_key);
         }
 
         if (cached) {
             return make_resolve_result(*this, cached);
         } else {
-            if (find(_cycle_markers.begin(), _cycle_markers.end(), original) != _cycle_markers.end()) {
+            if (_cycle_markers->count(original.get())) {
                 throw not_possible_to_resolve_exception(_("Cycle detected, can't resolve."));
             }
 
             auto result = original->resolve_substitutions(*this, source);
             auto& resolved = result.value;
-            auto& with_memo = result.context;
 
             if (!resolved || resolved->get_resolve_status() == resolve_status::RESOLVED) {
-                with_memo = with_memo.memoize(full_key, resolved);
+                memoize(full_key, resolved);
             }  else {
                 if (is_restricted_to_child()) {
                     if (restricted_key.value == nullptr && restricted_key.restrict_to_child.empty()) {
                         throw bug_or_broken_exception(_("restricted_key should not be empty here"));
                     }
-                    with_memo = with_memo.memoize(restricted_key, resolved);
+                    memoize(restricted_key, resolved);
                 } else if (options().get_allow_unresolved()) {
-                    with_memo = with_memo.memoize(full_key, resolved);
+                    memoize(full_key, resolved);
                 } else {
                     throw bug_or_broken_exception(_("resolve_substitutions() did not give us a resolved object"));
                 }
             }
 
-            return make_resolve_result(with_memo, resolved);
+            return result;
         }
     }
 
@@ -82,29 +97,11 @@ namespace hocon {
         return _restrict_to_child;
     }
 
-    resolve_context resolve_context::add_cycle_marker(shared_value value) const {
-        if (find(_cycle_markers.begin(), _cycle_markers.end(), value) != _cycle_markers.end()) {
-            throw config_exception(_("Added cycle marker twice"));
-        }
-
-        vector<shared_value> copy { _cycle_markers };
-        copy.push_back(value);
-        return resolve_context(_options, _restrict_to_child, move(copy));
-    }
-
-    resolve_context resolve_context::remove_cycle_marker(shared_value value) {
-        vector<shared_value> copy { _cycle_markers };
-        if (!copy.empty()) {
-            copy.erase(remove(copy.begin(), copy.end(), value), copy.end());
-        }
-        return resolve_context(_options, _restrict_to_child, move(copy));
-    }
-
     resolve_context resolve_context::restrict(path restrict_to) const {
         if (restrict_to == _restrict_to_child) {
             return *this;
         } else {
-            return resolve_context(_options, restrict_to, _cycle_markers);
+            return resolve_context(_options, restrict_to, _memos, _cycle_markers);
         }
     }
 
@@ -112,28 +109,82 @@ namespace hocon {
         return restrict({});
     }
 
-    shared_value resolve_context::resolve(shared_value value, shared_object root, config_resolve_options options) {
+    resolve_context resolve_context::fork() const {
+        return resolve_context(_options, {}, _memos, make_shared<cycle_markers>());
+    }
+
+    shared_object resolve_context::environment() const {
+        auto& memos = *_memos;
+        call_once(memos.environment_read, [&memos]() { memos.environment = config::env_variables_as_config_object(); });
+        return memos.environment;
+    }
+
+    shared_value resolve_context::resolve(shared_value value, shared_object root, config_resolve_options options,
+                                          shared_object environment) {
         resolve_source source { root };
-        resolve_context context { options, path(), vector<shared_value> {}};
+        resolve_context context { options, path(), nullptr, move(environment) };
+
+        // Big configs resolve their substitutions on several threads, and the resolved
+        // root is put together from the results
+        unsigned threads = options.get_threads() ? options.get_threads() : thread::hardware_concurrency();
+        if (threads > 1 && value == root && root->get_resolve_status() == resolve_status::UNRESOLVED) {
+            parallel_resolver resolver(root);
+            if (resolver.size() >= min_parallel_units) {
+                return resolver.run(context, threads);
+            }
+        }
 
         return context.resolve(value, source).value;
     }
 
-    resolve_context resolve_context::memoize(const resolve_context::memo_key& key, const shared_value& value) const {
-        resolve_context result {_options, _restrict_to_child, _cycle_markers};
-        result._memos = _memos;
-        result._memos.emplace(key, value);
-        return result;
+    resolve_context::memo_table::shard& resolve_context::memo_table::shard_for(memo_key const& key) {
+        // The low bits of the hash are mostly the pointer's alignment
+        size_t hash = memo_key_hash()(key);
+        return shards[((hash >> 4) ^ (hash >> 12)) % shards.size()];
+    }
+
+    shared_value resolve_context::find_memo(const resolve_context::memo_key& key) const {
+        auto& shard = _memos->shard_for(key);
+        {
+            lock_guard<mutex> guard(shard.lock);
+            auto cached = shard.memos.find(key);
+            if (cached != shard.memos.end()) {
+                return cached->second;
+            }
+        }
+
+        // Earlier results are for whole values, not for parts of them
+        if (!_memos->earlier || !key.restrict_to_child.empty()) {
+            return nullptr;
+        }
+        auto earlier = _memos->earlier(key.value);
+        if (earlier) {
+            memoize(key, earlier);
+        }
+        return earlier;
+    }
+
+    void resolve_context::memoize(const resolve_context::memo_key& key, const shared_value& value) const {
+        auto& shard = _memos->shard_for(key);
+        lock_guard<mutex> guard(shard.lock);
+        shard.memos.emplace(key, value);
+    }
+
+    resolve_context::cycle_marker::cycle_marker(resolve_context const& context, shared_value const& value)
+        : _markers(context._cycle_markers), _value(value.get())
+    {
+        if (!_markers->insert(_value).second) {
+            throw config_exception(_("Added cycle marker twice"));
+        }
+    }
+
+    resolve_context::cycle_marker::~cycle_marker() {
+        _markers->erase(_value);
     }
 
     std::size_t resolve_context::memo_key_hash::operator()(const hocon::resolve_context::memo_key& k) const {
         // Treat pointer as our hash value
         size_t h = reinterpret_cast<size_t>(k.value.get());
-        auto p = k.restrict_to_child;
-        while (!p.empty()) {
-            h += 41 * (41 + hash<string>()(*p.first()));
-            p = p.remainder();
-        }
-        return h;
+        return h * 41 + k.restrict_to_child.hash();
     }
 }  // namespace hocon
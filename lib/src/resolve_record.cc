@@ -0,0 +1,355 @@
+#include <internal/resolve_record.hpp>
+#include <hocon/config.hpp>
+#include <internal/resolve_context.hpp>
+#include <internal/resolve_result.hpp>
+#include <internal/resolve_source.hpp>
+#include <internal/values/simple_config_object.hpp>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace hocon {
+
+    namespace {
+        /** Updates add layers up to this many, then all but the first are merged. */
+        const size_t max_layers = 8;
+
+        /** The value at a path in a resolved object, or nullptr if there isn't one. */
+        shared_value value_at(shared_object const& root, path const& at) {
+            shared_value value = root;
+            for (path rest = at; !rest.empty() && value; rest = rest.remainder()) {
+                auto object = dynamic_pointer_cast<const config_object>(value);
+                if (!object) {
+                    return nullptr;
+                }
+                value = object->get(*rest.first());
+            }
+            return value;
+        }
+
+        /**
+         * The value at a path in a source, or nullptr if there isn't one. If parents
+         * isn't null, the objects holding the value are added to it, nearest first.
+         */
+        shared_value find_in_source(shared_ptr<const simple_config_object> const& root, path const& at,
+                                    resolve_source::node* parents) {
+            shared_value value = root;
+            for (path rest = at; !rest.empty() && value; rest = rest.remainder()) {
+                auto object = dynamic_pointer_cast<const simple_config_object>(value);
+                if (!object) {
+                    return nullptr;
+                }
+                if (parents && object != root) {
+                    parents->push_front(object);
+                }
+                value = object->get(*rest.first());
+            }
+            return value;
+        }
+
+        /** Removes a path from a resolved root, which like every parsed root is a simple_config_object. */
+        shared_object without(shared_object const& root, path const& at) {
+            auto object = dynamic_pointer_cast<const simple_config_object>(root);
+            return object ? object->without_path(at) : root;
+        }
+    }
+
+    resolve_record::layer::layer() {
+        trie.push_back(node { {}, -1, {}, false });
+    }
+
+    size_t resolve_record::layer::child(size_t parent, string const& key) {
+        auto found = trie[parent].children.find(key);
+        if (found != trie[parent].children.end()) {
+            return found->second;
+        }
+        trie.push_back(node { {}, -1, {}, false });
+        trie[parent].children.emplace(key, trie.size() - 1);
+        return trie.size() - 1;
+    }
+
+    void resolve_record::layer::add_units(shared_value const& value, path const& at) {
+        vector<string> elements;
+        for (path rest = at; !rest.empty(); rest = rest.remainder()) {
+            elements.push_back(*rest.first());
+        }
+        add_units(value, elements);
+    }
+
+    bool resolve_record::layer::replace(path const& at) {
+        size_t position = 0;
+        for (path rest = at; !rest.empty(); rest = rest.remainder()) {
+            position = child(position, *rest.first());
+            if (trie[position].replaced) {
+                return false;
+            }
+        }
+        trie[position].replaced = true;
+        regions.push_back(at);
+        return true;
+    }
+
+    void resolve_record::layer::add_units(shared_value const& value, vector<string>& at) {
+        if (value->get_resolve_status() == resolve_status::RESOLVED) {
+            return;
+        }
+        if (auto object = dynamic_pointer_cast<const simple_config_object>(value)) {
+            for (auto const& entry : object->entry_set()) {
+                at.push_back(entry.first);
+                add_units(entry.second, at);
+                at.pop_back();
+            }
+        } else if (!at.empty()) {
+            add_unit(value, at);
+        }
+    }
+
+    void resolve_record::layer::add_unit(shared_value const& value, vector<string> const& at) {
+        size_t index = units.size();
+        size_t position = 0;
+        for (auto const& key : at) {
+            position = child(position, key);
+        }
+        trie[position].unit = static_cast<int>(index);
+        units.push_back(unit { path(at), value });
+        by_value.emplace(value.get(), index);
+
+        resolve_source::for_each_lookup(value, [&](path const& target) {
+            size_t read = 0;
+            for (path rest = target; !rest.empty(); rest = rest.remainder()) {
+                read = child(read, *rest.first());
+            }
+            trie[read].readers.push_back(index);
+        });
+    }
+
+    resolve_record::resolve_record(config_resolve_options options, shared_object source, shared_object result,
+                                   shared_object environment, vector<shared_layer> layers)
+        : _options(move(options)), _source(move(source)), _result(move(result)),
+          _environment(move(environment)), _layers(move(layers)) { }
+
+    shared_ptr<const resolve_record> resolve_record::record(config_resolve_options options, shared_object source) {
+        auto environment = environment_for(options);
+        auto result = dynamic_pointer_cast<const config_object>(
+            resolve_context::resolve(source, source, options, environment));
+        auto recorded = make_shared<layer>();
+        if (auto root = dynamic_pointer_cast<const simple_config_object>(source)) {
+            recorded->add_units(root, path());
+        }
+        return shared_ptr<const resolve_record>(new resolve_record(move(options), move(source), move(result),
+                                                                   move(environment), { recorded }));
+    }
+
+    shared_object resolve_record::environment_for(config_resolve_options const& options) {
+        return options.get_use_system_environment() ? config::env_variables_as_config_object() : nullptr;
+    }
+
+    void resolve_record::find_environment_changes(shared_object const& mine, shared_object const& theirs,
+                                                  shared_ptr<const simple_config_object> const& source,
+                                                  vector<path>& changed) {
+        auto my_variables = dynamic_pointer_cast<const simple_config_object>(mine);
+        auto their_variables = dynamic_pointer_cast<const simple_config_object>(theirs);
+        if (!my_variables || !their_variables) {
+            return;
+        }
+        // Each snapshot has its own values, so compare what they hold. Substitutions only
+        // fall back to a variable the source doesn't have at its root.
+        my_variables->entry_set().for_each_difference(their_variables->entry_set(),
+            [&](string const& name, shared_value const& my_value, shared_value const& their_value) {
+                if (source->entry_set().get(name)) {
+                    return;
+                }
+                if (!my_value || !their_value || !(*my_value == *their_value)) {
+                    changed.push_back(path::new_key(name));
+                }
+            });
+    }
+
+    bool resolve_record::is_live(size_t layer_index, size_t unit_index) const {
+        auto const& at = _layers[layer_index]->units[unit_index].at;
+        for (size_t later = layer_index + 1; later < _layers.size(); ++later) {
+            auto const& trie = _layers[later]->trie;
+            size_t position = 0;
+            for (path rest = at; !rest.empty(); rest = rest.remainder()) {
+                auto found = trie[position].children.find(*rest.first());
+                if (found == trie[position].children.end()) {
+                    break;
+                }
+                position = found->second;
+                if (trie[position].replaced) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    shared_value resolve_record::earlier_result(shared_value const& value,
+                                                unordered_set<config_value const*> const& affected) const {
+        if (affected.count(value.get())) {
+            return nullptr;
+        }
+        for (size_t layer_index = _layers.size(); layer_index-- > 0;) {
+            auto const& recorded = *_layers[layer_index];
+            auto found = recorded.by_value.find(value.get());
+            if (found != recorded.by_value.end()) {
+                return is_live(layer_index, found->second) ? value_at(_result, recorded.units[found->second].at)
+                                                           : nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    template<typename Visit>
+    void resolve_record::for_each_affected(size_t layer_index, path const& changed, Visit const& visit) const {
+        auto const& recorded = *_layers[layer_index];
+        auto const& trie = recorded.trie;
+        auto visit_node = [&](size_t position, bool with_unit) {
+            for (auto reader : trie[position].readers) {
+                visit(reader);
+            }
+            if (with_unit && trie[position].unit >= 0) {
+                visit(static_cast<size_t>(trie[position].unit));
+            }
+        };
+
+        // Values looking up the whole root, then those looking up the changed path or
+        // an object holding it, and the value it's part of
+        size_t position = 0;
+        visit_node(position, false);
+        for (path rest = changed; !rest.empty(); rest = rest.remainder()) {
+            auto found = trie[position].children.find(*rest.first());
+            if (found == trie[position].children.end()) {
+                return;
+            }
+            position = found->second;
+            visit_node(position, true);
+        }
+
+        // Values under the changed path, and those looking up paths under it
+        vector<size_t> pending;
+        for (auto const& child : trie[position].children) {
+            pending.push_back(child.second);
+        }
+        while (!pending.empty()) {
+            position = pending.back();
+            pending.pop_back();
+            visit_node(position, true);
+            for (auto const& child : trie[position].children) {
+                pending.push_back(child.second);
+            }
+        }
+    }
+
+    void resolve_record::find_changes(shared_ptr<const simple_config_object> const& mine,
+                                      shared_ptr<const simple_config_object> const& theirs,
+                                      vector<string>& at, vector<path>& changed) {
+        mine->entry_set().for_each_difference(theirs->entry_set(),
+            [&](string const& key, shared_value const& my_value, shared_value const& their_value) {
+                at.push_back(key);
+                auto my_object = dynamic_pointer_cast<const simple_config_object>(my_value);
+                auto their_object = dynamic_pointer_cast<const simple_config_object>(their_value);
+                if (my_object && their_object) {
+                    find_changes(my_object, their_object, at, changed);
+                } else {
+                    changed.push_back(path(at));
+                }
+                at.pop_back();
+            });
+    }
+
+    shared_ptr<const resolve_record> resolve_record::update(shared_object source) const {
+        auto mine = dynamic_pointer_cast<const simple_config_object>(_source);
+        auto theirs = dynamic_pointer_cast<const simple_config_object>(source);
+        if (!mine || !theirs) {
+            return record(_options, move(source));
+        }
+
+        // Variables that changed are looked up afresh, like paths edited in the source
+        vector<path> changed;
+        auto environment = environment_for(_options);
+        find_environment_changes(_environment, environment, theirs, changed);
+        if (source == _source && changed.empty()) {
+            return shared_from_this();
+        }
+        vector<string> at;
+        find_changes(mine, theirs, at, changed);
+
+        // Follow the changes to the values they affect, and on to the values those affect
+        vector<unordered_set<size_t>> affected(_layers.size());
+        unordered_set<config_value const*> affected_values;
+        vector<path> regions;
+        while (!changed.empty()) {
+            path next = changed.back();
+            changed.pop_back();
+            regions.push_back(next);
+            for (size_t layer_index = 0; layer_index < _layers.size(); ++layer_index) {
+                for_each_affected(layer_index, next, [&](size_t unit_index) {
+                    if (affected[layer_index].insert(unit_index).second && is_live(layer_index, unit_index)) {
+                        auto const& u = _layers[layer_index]->units[unit_index];
+                        affected_values.insert(u.value.get());
+                        changed.push_back(u.at);
+                    }
+                });
+            }
+        }
+
+        // Resolve each region again, skipping those inside another
+        sort(regions.begin(), regions.end(), [](path const& a, path const& b) { return a.length() < b.length(); });
+        auto fresh = make_shared<layer>();
+        resolve_context context(_options, path(), [&](shared_value const& value) {
+            return earlier_result(value, affected_values);
+        }, environment);
+        auto result = _result;
+        for (auto const& region : regions) {
+            if (!fresh->replace(region)) {
+                continue;
+            }
+            resolve_source::node parents { theirs };
+            auto value = find_in_source(theirs, region, &parents);
+            if (!value) {
+                result = without(result, region);
+                continue;
+            }
+            fresh->add_units(value, region);
+            auto resolved = context.resolve(value, resolve_source(theirs, parents)).value;
+            result = resolved ? result->with_value(region, resolved) : without(result, region);
+        }
+
+        auto layers = _layers;
+        layers.push_back(move(fresh));
+        if (layers.size() > max_layers) {
+            layers = compacted(layers, theirs);
+        }
+        return shared_ptr<const resolve_record>(new resolve_record(_options, move(source), move(result),
+                                                                   move(environment), move(layers)));
+    }
+
+    vector<resolve_record::shared_layer> resolve_record::compacted(vector<shared_layer> const& layers,
+                                                                   shared_ptr<const simple_config_object> const& source) {
+        // Merge the layers after the first into one by recording their regions again
+        vector<path> regions;
+        for (size_t i = 1; i < layers.size(); ++i) {
+            regions.insert(regions.end(), layers[i]->regions.begin(), layers[i]->regions.end());
+        }
+        sort(regions.begin(), regions.end(), [](path const& a, path const& b) { return a.length() < b.length(); });
+        auto merged = make_shared<layer>();
+        for (auto const& region : regions) {
+            if (merged->replace(region)) {
+                if (auto value = find_in_source(source, region, nullptr)) {
+                    merged->add_units(value, region);
+                }
+            }
+        }
+        if (merged->units.size() < layers[0]->units.size()) {
+            return { layers[0], merged };
+        }
+
+        // Once the edits have touched as many values as the first layer holds, start over
+        auto whole = make_shared<layer>();
+        whole->add_units(source, path());
+        return { whole };
+    }
+
+}  // namespace hocon
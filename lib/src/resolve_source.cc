@@ -4,7 +4,11 @@
 #include <hocon/config_value.hpp>
 #include <hocon/config_object.hpp>
 #include <internal/values/simple_config_object.hpp>
+#include <internal/values/simple_config_list.hpp>
+#include <internal/values/config_concatenation.hpp>
+#include <internal/values/config_reference.hpp>
 #include <internal/container.hpp>
+#include <internal/unmergeable.hpp>
 #include <leatherman/locale/locale.hpp>
 
 // Mark string for translation (alias for leatherman::locale::format)
@@ -99,13 +103,52 @@ namespace hocon {
             }
 
             if (!result.result.value && result.result.context.options().get_use_system_environment()) {
-                result = find_in_object(config::env_variables_as_config_object(), context, unprefixed);
+                result = find_in_object(result.result.context.environment(), result.result.context, unprefixed);
             }
         }
 
         return result;
     }
 
+    void resolve_source::for_each_lookup(shared_value const& value, function<void(path const&)> const& visit) {
+        if (auto reference = dynamic_pointer_cast<const config_reference>(value)) {
+            auto target = reference->expression()->get_path();
+            visit(target);
+            // Relativized substitutions fall back to the path without their prefix
+            if (reference->prefix_length() > 0) {
+                visit(target.sub_path(reference->prefix_length()));
+            }
+        } else if (auto concatenation = dynamic_pointer_cast<const config_concatenation>(value)) {
+            for (auto const& piece : concatenation->pieces()) {
+                for_each_lookup(piece, visit);
+            }
+        } else if (auto merge = dynamic_pointer_cast<const unmergeable>(value)) {
+            for (auto const& merged : merge->unmerged_values()) {
+                for_each_lookup(merged, visit);
+            }
+        } else if (auto object = dynamic_pointer_cast<const simple_config_object>(value)) {
+            for (auto const& entry : object->entry_set()) {
+                for_each_lookup(entry.second, visit);
+            }
+        } else if (auto list = dynamic_pointer_cast<const simple_config_list>(value)) {
+            // Packed lists hold only numbers and booleans
+            if (!list->packed()) {
+                for (auto const& element : *list) {
+                    for_each_lookup(element, visit);
+                }
+            }
+        }
+    }
+
+    resolve_source::result_with_path resolve_source::resolve_path(resolve_context context, path const& the_path) const {
+        auto found = find_in_object(_root, move(context), the_path);
+        if (!found.result.value) {
+            return found;
+        }
+        resolve_source source { root_must_be_obj(found.path_from_root.back()), found.path_from_root };
+        return {found.result.context.resolve(found.result.value, source), found.path_from_root};
+    }
+
     resolve_source::result_with_path resolve_source::find_in_object(shared_object obj, resolve_context context,
                                                                     path the_path) {
         auto restriction = context.restrict_to_child();
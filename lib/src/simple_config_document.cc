@@ -3,7 +3,6 @@
 #include <hocon/config_exception.hpp>
 #include <internal/tokenizer.hpp>
 #include <internal/config_document_parser.hpp>
-#include <sstream>
 #include <boost/algorithm/string.hpp>
 #include <leatherman/locale/locale.hpp>
 
@@ -24,7 +23,8 @@ namespace hocon {
         }
 
         shared_origin origin = make_shared<simple_config_origin>("single value parsing");
-        token_iterator tokens {origin, unique_ptr<istream>{new stringstream(new_value)}, _parse_options.get_syntax()};
+        token_iterator tokens {origin, make_shared<input_buffer>(new_value.data(), new_value.data() + new_value.size()),
+                               _parse_options.get_syntax()};
         shared_node_value parsed_value = config_document_parser::parse_value(move(tokens), origin, _parse_options);
 
         return unique_ptr<config_document>{new simple_config_document(
@@ -15,65 +15,78 @@ namespace hocon {
 
     simple_config_origin::simple_config_origin(string description, int line_number, int end_line_number,
                                                origin_type org_type, string resource, vector<string> comments) :
-        _description(move(description)), _line_number(line_number), _end_line_number(end_line_number),
-        _origin_type(org_type), _resource_or_null(move(resource)), _comments_or_null(move(comments)) { }
+        _descriptor(make_shared<origin_descriptor>(origin_descriptor { move(description), org_type, move(resource) })),
+        _line_number(line_number), _end_line_number(end_line_number),
+        _comments_or_null(make_comments(move(comments))) { }
 
     simple_config_origin::simple_config_origin(string description, int line_number, int end_line_number,
                                                origin_type org_type) :
-        _description(move(description)), _line_number(line_number), _end_line_number(end_line_number),
-        _origin_type(org_type) { }
+        _descriptor(make_shared<origin_descriptor>(origin_descriptor { move(description), org_type, "" })),
+        _line_number(line_number), _end_line_number(end_line_number) { }
+
+    simple_config_origin::simple_config_origin(shared_origin_descriptor descriptor, int line_number,
+                                               int end_line_number, shared_comments comments_or_null) :
+        _descriptor(move(descriptor)), _line_number(line_number), _end_line_number(end_line_number),
+        _comments_or_null(move(comments_or_null)) { }
+
+    shared_comments simple_config_origin::make_comments(vector<string> comments) {
+        if (comments.empty()) {
+            return nullptr;
+        }
+        return make_shared<const vector<string>>(move(comments));
+    }
 
     int simple_config_origin::line_number() const {
         return _line_number;
     }
 
     string const& simple_config_origin::description() const {
-        return _description;
+        return _descriptor->description;
     }
 
     vector<string> const& simple_config_origin::comments() const {
-        return _comments_or_null;
+        static const vector<string> no_comments;
+        return _comments_or_null ? *_comments_or_null : no_comments;
     }
 
     shared_origin simple_config_origin::with_line_number(int line_number) const {
         if (line_number == _line_number && line_number == _end_line_number) {
             return shared_from_this();
         } else {
-            return make_shared<simple_config_origin>(_description, line_number, line_number, _origin_type,
-                    _resource_or_null, _comments_or_null);
+            return make_shared<simple_config_origin>(_descriptor, line_number, line_number, _comments_or_null);
         }
     }
 
     shared_origin simple_config_origin::with_comments(std::vector<std::string> comments) const {
-        if (comments == _comments_or_null || comments.empty()) {
+        if (comments == this->comments() || comments.empty()) {
             return shared_from_this();
         } else {
-            return make_shared<simple_config_origin>(_description, _line_number, _end_line_number, _origin_type,
-                                                     _resource_or_null, move(comments));
+            return make_shared<simple_config_origin>(_descriptor, _line_number, _end_line_number,
+                                                     make_comments(move(comments)));
         }
     }
 
     shared_ptr<const simple_config_origin> simple_config_origin::append_comments(vector<string> comments) const {
-        if (comments == _comments_or_null || comments.empty()) {
+        if (comments == this->comments() || comments.empty()) {
             return shared_from_this();
         } else {
             // Don't re-use with_comments, because we've already checked whether they're equal.
             // If they're not equal now, the concatenated comments won't be equal either.
-            comments.insert(comments.begin(), _comments_or_null.begin(), _comments_or_null.end());
-            return make_shared<simple_config_origin>(_description, _line_number, _line_number, _origin_type,
-                                                     _resource_or_null, move(comments));
+            comments.insert(comments.begin(), this->comments().begin(), this->comments().end());
+            return make_shared<simple_config_origin>(_descriptor, _line_number, _line_number,
+                                                     make_comments(move(comments)));
         }
     }
 
     shared_ptr<const simple_config_origin> simple_config_origin::prepend_comments(vector<string> comments) const {
-        if (comments == _comments_or_null || comments.empty()) {
+        if (comments == this->comments() || comments.empty()) {
             return shared_from_this();
         } else {
             // Don't re-use with_comments, because we've already checked whether they're equal.
             // If they're not equal now, the concatenated comments won't be equal either.
-            comments.insert(comments.end(), _comments_or_null.begin(), _comments_or_null.end());
-            return make_shared<simple_config_origin>(_description, _line_number, _line_number, _origin_type,
-                                                     _resource_or_null, move(comments));
+            comments.insert(comments.end(), this->comments().begin(), this->comments().end());
+            return make_shared<simple_config_origin>(_descriptor, _line_number, _line_number,
+                                                     make_comments(move(comments)));
         }
     }
 
@@ -129,8 +142,8 @@ namespace hocon {
         int merged_end_line;
 
         origin_type merged_type;
-        if (a->_origin_type == b->_origin_type) {
-            merged_type = a->_origin_type;
+        if (a->_descriptor->type == b->_descriptor->type) {
+            merged_type = a->_descriptor->type;
         } else {
             merged_type = origin_type::GENERIC;
         }
@@ -171,26 +184,31 @@ namespace hocon {
         }
 
         string merged_resource;
-        if (a->_resource_or_null == b->_resource_or_null) {
-            merged_resource = a->_resource_or_null;
+        if (a->_descriptor->resource_or_null == b->_descriptor->resource_or_null) {
+            merged_resource = a->_descriptor->resource_or_null;
         }
 
-        vector<string> merged_comments;
-        if (a->_comments_or_null == b->_comments_or_null) {
+        shared_comments merged_comments;
+        if (a->comments() == b->comments()) {
             merged_comments = a->_comments_or_null;
         } else {
-            if (!a->_comments_or_null.empty())
-            {
-                merged_comments.insert(merged_comments.end(), a->_comments_or_null.begin(), a->_comments_or_null.end());
-            }
-            if (!b->_comments_or_null.empty())
-            {
-                merged_comments.insert(merged_comments.end(), b->_comments_or_null.begin(), b->_comments_or_null.end());
-            }
+            vector<string> comments { a->comments() };
+            comments.insert(comments.end(), b->comments().begin(), b->comments().end());
+            merged_comments = make_comments(move(comments));
+        }
+
+        // Lines of the same file keep sharing its descriptor
+        shared_origin_descriptor merged_descriptor;
+        if (merged_desc == a->description() && merged_type == a->_descriptor->type &&
+            merged_resource == a->_descriptor->resource_or_null) {
+            merged_descriptor = a->_descriptor;
+        } else {
+            merged_descriptor = make_shared<origin_descriptor>(
+                origin_descriptor { move(merged_desc), merged_type, move(merged_resource) });
         }
 
-        return make_shared<simple_config_origin>(move(merged_desc), move(merged_start_line), move(merged_end_line), move(merged_type),
-                                                 move(merged_resource), move(merged_comments));
+        return make_shared<simple_config_origin>(move(merged_descriptor), merged_start_line, merged_end_line,
+                                                 move(merged_comments));
     }
 
     shared_ptr<const simple_config_origin> simple_config_origin::merge_three(shared_ptr<const simple_config_origin> a,
@@ -207,10 +225,10 @@ namespace hocon {
                                          shared_ptr<const simple_config_origin> b) {
         int count = 0;
 
-        if (a->_origin_type == b->_origin_type) {
+        if (a->_descriptor->type == b->_descriptor->type) {
             count += 1;
         }
-        if (a->_description == b->_description) {
+        if (a->description() == b->description()) {
             count += 1;
         }
 
@@ -222,7 +240,7 @@ namespace hocon {
         if (a->_end_line_number == b->_end_line_number) {
             count += 1;
         }
-        if (a->_resource_or_null == b->_resource_or_null) {
+        if (a->_descriptor->resource_or_null == b->_descriptor->resource_or_null) {
             count += 1;
         }
 
@@ -231,12 +249,12 @@ namespace hocon {
 
 
     bool simple_config_origin::operator==(const simple_config_origin &other) const {
-        return (other._description == _description) &&
+        return (other.description() == description()) &&
                 (other._line_number == _line_number) &&
                 (other._end_line_number == _end_line_number) &&
-                (other._origin_type == _origin_type) &&
-                (other._resource_or_null == _resource_or_null) &&
-                (other._comments_or_null == _comments_or_null);
+                (other._descriptor->type == _descriptor->type) &&
+                (other._descriptor->resource_or_null == _descriptor->resource_or_null) &&
+                (other.comments() == comments());
     }
 
     bool simple_config_origin::operator!=(const simple_config_origin &other) const {
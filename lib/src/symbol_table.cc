@@ -0,0 +1,116 @@
+#include <internal/symbol_table.hpp>
+#include <array>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+using namespace std;
+
+namespace hocon {
+
+    namespace {
+        using entries = unordered_multimap<size_t, pair<symbol const*, weak_ptr<const symbol>>>;
+
+        /**
+         * Symbols are found through their stored hash, so a key's text is hashed only
+         * once. Each entry keeps the symbol's address next to the weak reference, so a
+         * symbol being released can find and remove its own entry.
+         */
+        struct shard {
+            mutex lock;
+            entries symbols;
+        };
+
+        struct table {
+            array<shard, 16> shards;
+
+            shard& shard_for(size_t hash) {
+                // The low bits pick the bucket within a shard's map
+                return shards[(hash >> 8) % shards.size()];
+            }
+        };
+
+        table& instance() {
+            // Never destroyed, since symbols held by static objects may be released after it
+            static table* the_table = new table();
+            return *the_table;
+        }
+
+        /** Removes a symbol from the table when its last reference goes away. */
+        struct release {
+            void operator()(symbol const* s) const {
+                auto& sh = instance().shard_for(s->hash);
+                {
+                    lock_guard<mutex> guard(sh.lock);
+                    auto range = sh.symbols.equal_range(s->hash);
+                    for (auto it = range.first; it != range.second; ++it) {
+                        // The entry may already have been replaced by a new symbol for the same text
+                        if (it->second.first == s) {
+                            sh.symbols.erase(it);
+                            break;
+                        }
+                    }
+                }
+                delete s;
+            }
+        };
+
+        /**
+         * Finds the live symbol for text, or the entry a released one still holds until
+         * its release gets the lock. A released symbol isn't deleted before that, so its
+         * text can still be compared. Call with the shard locked.
+         */
+        symbol_ref find(shard& sh, string const& text, size_t hash, entries::iterator& stale) {
+            stale = sh.symbols.end();
+            auto range = sh.symbols.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second.first->text == text) {
+                    auto live = it->second.second.lock();
+                    if (live) {
+                        return live;
+                    }
+                    stale = it;
+                }
+            }
+            return nullptr;
+        }
+    }
+
+    symbol_ref symbol_table::intern(string const& text) {
+        size_t hash = std::hash<string>()(text);
+        auto& sh = instance().shard_for(hash);
+        lock_guard<mutex> guard(sh.lock);
+        entries::iterator stale;
+        auto existing = find(sh, text, hash, stale);
+        if (existing) {
+            return existing;
+        }
+
+        symbol_ref added(new symbol(text, hash), release());
+        if (stale != sh.symbols.end()) {
+            stale->second = make_pair(added.get(), weak_ptr<const symbol>(added));
+        } else {
+            sh.symbols.emplace(hash, make_pair(added.get(), weak_ptr<const symbol>(added)));
+        }
+        return added;
+    }
+
+    symbol_ref symbol_table::unlisted(string const& text) {
+        return make_shared<const symbol>(text, std::hash<string>()(text));
+    }
+
+    shared_string symbol_table::shared_text(symbol_ref const& s) {
+        // aliasing constructor, sharing ownership of the symbol
+        return shared_string(s, &s->text);
+    }
+
+    size_t symbol_table::size() {
+        size_t count = 0;
+        for (auto& sh : instance().shards) {
+            lock_guard<mutex> guard(sh.lock);
+            count += sh.symbols.size();
+        }
+        return count;
+    }
+
+}  // namespace hocon
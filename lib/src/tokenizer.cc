@@ -6,9 +6,15 @@
 #include <internal/values/config_long.hpp>
 #include <internal/values/config_string.hpp>
 #include <boost/nowide/fstream.hpp>
-#include <boost/lexical_cast.hpp>
 #include <boost/nowide/convert.hpp>
 #include <leatherman/locale/locale.hpp>
+#include <array>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HOCON_TOKENIZER_SSE2
+#endif
 
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
@@ -31,12 +37,16 @@ namespace hocon {
         _whitespace += c;
     }
 
-    shared_token token_iterator::whitespace_saver::check(token_type type, shared_origin base_origin, int line_number)
+    void token_iterator::whitespace_saver::add(char const* begin, char const* end) {
+        _whitespace.append(begin, end);
+    }
+
+    shared_token token_iterator::whitespace_saver::check(token_type type, shared_origin const& line_origin)
     {
         if (is_simple_value(type)) {
-            return next_is_simple_value(base_origin, line_number);
+            return next_is_simple_value(line_origin);
         } else {
-            return next_is_not_simple_value(base_origin, line_number);
+            return next_is_not_simple_value(line_origin);
         }
     }
 
@@ -45,10 +55,10 @@ namespace hocon {
      * discards any whitespace we were saving between
      * simple values.
      */
-    shared_token token_iterator::whitespace_saver::next_is_not_simple_value(shared_origin base_origin, int line_number)
+    shared_token token_iterator::whitespace_saver::next_is_not_simple_value(shared_origin const& line_origin)
     {
         _last_token_was_simple_value = false;
-        return create_whitespace_token(base_origin, line_number);
+        return create_whitespace_token(line_origin);
     }
 
     /**
@@ -56,21 +66,21 @@ namespace hocon {
      * so creates a whitespace token if the previous
      * token also was simple.
      */
-    shared_token token_iterator::whitespace_saver::next_is_simple_value(shared_origin base_origin, int line_number) {
-        shared_token t = create_whitespace_token(base_origin, line_number);
+    shared_token token_iterator::whitespace_saver::next_is_simple_value(shared_origin const& line_origin) {
+        shared_token t = create_whitespace_token(line_origin);
         if (!_last_token_was_simple_value) {
             _last_token_was_simple_value = true;
         }
         return t;
     }
 
-    shared_token token_iterator::whitespace_saver::create_whitespace_token(shared_origin base_origin, int line_number) {
+    shared_token token_iterator::whitespace_saver::create_whitespace_token(shared_origin const& line_origin) {
         if (_whitespace.length() > 0) {
             shared_token t;
             if (_last_token_was_simple_value) {
-                t = make_shared<unquoted_text>(line_origin(base_origin, line_number), _whitespace);
+                t = make_shared<unquoted_text>(line_origin, _whitespace);
             } else {
-                t = make_shared<ignored_whitespace>(line_origin(base_origin, line_number), _whitespace);
+                t = make_shared<ignored_whitespace>(line_origin, _whitespace);
             }
             _whitespace = "";  // reset
             return t;
@@ -78,28 +88,206 @@ namespace hocon {
         return nullptr;
     }
 
+    /** Character that stop an unquoted string */
+    static const string not_in_unquoted_text = "$\"{}[]:=,+#`^?!@*&\\";
+
+    /**
+     * Bytes that end a run of unquoted text: the reserved characters, whitespace, and
+     * '/', which may start a comment and has to be looked at by the caller.
+     */
+    static const array<bool, 256> unquoted_run_stops = [] {
+        array<bool, 256> stops {};
+        for (int c = 0; c < 256; c++) {
+            char ch = static_cast<char>(c);
+            stops[c] = ch == '/' || is_whitespace(ch) || not_in_unquoted_text.find(ch) != string::npos;
+        }
+        return stops;
+    }();
+
+    static bool ends_unquoted_run(char c) {
+        return unquoted_run_stops[static_cast<unsigned char>(c)];
+    }
+
+#ifdef HOCON_TOKENIZER_SSE2
+    /** Bits set for the bytes of block that are space, \t, \v, \f or \r (ASCII whitespace other than \n). */
+    static int inline_whitespace_mask(__m128i block) {
+        __m128i control = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('\t' - 1)),
+                                        _mm_cmplt_epi8(block, _mm_set1_epi8('\r' + 1)));
+        __m128i whitespace = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')), control),
+                                          _mm_cmpeq_epi8(block, _mm_set1_epi8(' ')));
+        return _mm_movemask_epi8(whitespace);
+    }
+
+    /** Bits set for the bytes of block that end a run of unquoted text. */
+    static int unquoted_run_stop_mask(__m128i block) {
+        __m128i stops = _mm_or_si128(_mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('\t' - 1)),
+                                                   _mm_cmplt_epi8(block, _mm_set1_epi8('\r' + 1))),
+                                     _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')),
+                                                  _mm_cmpeq_epi8(block, _mm_set1_epi8('/'))));
+        for (char c : not_in_unquoted_text) {
+            stops = _mm_or_si128(stops, _mm_cmpeq_epi8(block, _mm_set1_epi8(c)));
+        }
+        return _mm_movemask_epi8(stops);
+    }
+
+    static int lowest_bit(int mask) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+#endif
+
+    /** Returns the first byte in [begin, end) that isn't whitespace other than a newline, or end. */
+    static char const* skip_inline_whitespace(char const* begin, char const* end) {
+#ifdef HOCON_TOKENIZER_SSE2
+        for (; end - begin >= 16; begin += 16) {
+            int others = ~inline_whitespace_mask(_mm_loadu_si128(reinterpret_cast<__m128i const*>(begin))) & 0xFFFF;
+            if (others) {
+                return begin + lowest_bit(others);
+            }
+        }
+#endif
+        while (begin != end && is_whitespace_not_newline(*begin)) {
+            ++begin;
+        }
+        return begin;
+    }
+
+    /** Returns the first byte in [begin, end) that ends a run of unquoted text, or end. */
+    static char const* find_unquoted_run_end(char const* begin, char const* end) {
+#ifdef HOCON_TOKENIZER_SSE2
+        for (; end - begin >= 16; begin += 16) {
+            int stops = unquoted_run_stop_mask(_mm_loadu_si128(reinterpret_cast<__m128i const*>(begin)));
+            if (stops) {
+                return begin + lowest_bit(stops);
+            }
+        }
+#endif
+        while (begin != end && !ends_unquoted_run(*begin)) {
+            ++begin;
+        }
+        return begin;
+    }
+
+    /** Returns the first newline in [begin, end), or end. */
+    static char const* find_newline(char const* begin, char const* end) {
+        auto newline = static_cast<char const*>(memchr(begin, '\n', end - begin));
+        return newline ? newline : end;
+    }
+
+    /** Input buffer */
+    input_buffer::input_buffer(char const* begin, char const* end) : _begin(begin), _end(end) { }
+
+    char const* input_buffer::begin() const {
+        return _begin;
+    }
+
+    char const* input_buffer::end() const {
+        return _end;
+    }
+
+    string_input_buffer::string_input_buffer(string contents) :
+        input_buffer(nullptr, nullptr), _contents(move(contents))
+    {
+        _begin = _contents.data();
+        _end = _begin + _contents.size();
+    }
+
     /**
      * Token Iterator
      */
-    token_iterator::token_iterator(shared_origin origin, unique_ptr<std::istream> input, bool allow_comments) :
-            _origin(move(origin)), _input(move(input)), _allow_comments(allow_comments),
-            _line_number(1), _line_origin(_origin->with_line_number(1))
+
+    /** Size of the chunks read from a stream input; the extra leading byte keeps the last char for unget(). */
+    static const size_t stream_chunk_size = 64 * 1024;
+
+    token_iterator::token_iterator(shared_origin origin, unique_ptr<std::istream> input, bool allow_comments,
+                                   bool track_lines) :
+            _origin(move(origin)), _input(move(input)), _chunk(stream_chunk_size + 1),
+            _pos(_chunk.data() + 1), _end(_pos), _eof(false), _allow_comments(allow_comments),
+            _track_lines(track_lines), _line_number(1),
+            _line_origin(track_lines ? _origin->with_line_number(1) : _origin),
+            _tokens_head(0), _tokens_size(0)
+    {
+        _tokens[_tokens_size++] = tokens::start_token();
+    }
+
+    token_iterator::token_iterator(shared_origin origin, unique_ptr<std::istream> input, config_syntax flavor,
+                                   bool track_lines) :
+        token_iterator(move(origin), move(input), flavor != config_syntax::JSON, track_lines) {}
+
+    token_iterator::token_iterator(shared_origin origin, shared_input_buffer input, bool allow_comments,
+                                   bool track_lines) :
+            _origin(move(origin)), _buffer(move(input)), _pos(_buffer->begin()), _end(_buffer->end()),
+            _eof(false), _allow_comments(allow_comments),
+            _track_lines(track_lines), _line_number(1),
+            _line_origin(track_lines ? _origin->with_line_number(1) : _origin),
+            _tokens_head(0), _tokens_size(0)
     {
-        _tokens.push(tokens::start_token());
+        _tokens[_tokens_size++] = tokens::start_token();
     }
 
-    token_iterator::token_iterator(shared_origin origin, unique_ptr<std::istream> input, config_syntax flavor) :
-        token_iterator(move(origin), move(input), flavor != config_syntax::JSON) {}
+    token_iterator::token_iterator(shared_origin origin, shared_input_buffer input, config_syntax flavor,
+                                   bool track_lines) :
+        token_iterator(move(origin), move(input), flavor != config_syntax::JSON, track_lines) {}
+
+    void token_iterator::next_line() {
+        _line_number++;
+        if (_track_lines) {
+            _line_origin = _origin->with_line_number(_line_number);
+        }
+    }
+
+    inline bool token_iterator::good() const {
+        return !_eof;
+    }
+
+    inline char token_iterator::get() {
+        if (_pos == _end && !fill()) {
+            // Like std::istream, reading past the end leaves the input permanently failed.
+            _eof = true;
+            return char_traits<char>::eof();
+        }
+        return *_pos++;
+    }
+
+    inline int token_iterator::peek() {
+        if (_pos == _end && !fill()) {
+            return char_traits<char>::eof();
+        }
+        return *_pos;
+    }
+
+    inline void token_iterator::unget() {
+        if (!_eof) {
+            --_pos;
+        }
+    }
+
+    bool token_iterator::fill() {
+        if (!_input || !*_input) {
+            return false;
+        }
+        // Carry the last character over so that unget() still works after a refill.
+        _chunk[0] = _pos[-1];
+        _input->read(_chunk.data() + 1, stream_chunk_size);
+        _pos = _chunk.data() + 1;
+        _end = _pos + _input->gcount();
+        return _pos != _end;
+    }
 
     bool token_iterator::start_of_comment(char c) {
-        if (!*_input) {
+        if (!good()) {
             return false;
         } else {
             if (_allow_comments) {
                 if (c == '#') {
                     return true;
                 } else if (c == '/') {
-                    char maybe_second_slash = _input->peek();
+                    char maybe_second_slash = peek();
                     return maybe_second_slash == '/';  // Double slash indicates a comment
                 } else {
                     return false;
@@ -111,17 +299,19 @@ namespace hocon {
     }
 
     char token_iterator::next_char_after_whitespace(whitespace_saver& saver) {
-        char c = 0;
-        while (*_input) {
-            c = _input->get();
-            if (is_whitespace_not_newline(c)) {
-                saver.add(c);
-                continue;
-            } else {
-                return c;
+        if (!good()) {
+            return 0;
+        }
+        // Skip indentation and other runs of whitespace in bulk, refilling as needed.
+        while (true) {
+            char const* run_end = skip_inline_whitespace(_pos, _end);
+            saver.add(_pos, run_end);
+            _pos = run_end;
+            if (_pos != _end || !fill()) {
+                break;
             }
         }
-        return c;
+        return get();
     }
 
     bool token_iterator::is_simple_value(token_type type) {
@@ -130,10 +320,6 @@ namespace hocon {
                 type == token_type::UNQUOTED_TEXT;
     }
 
-    shared_origin token_iterator::line_origin(shared_origin origin, int line_number) {
-        return origin->with_line_number(line_number);
-    }
-
     string token_iterator::render(token_list tokens) {
         string rendered_text = "";
         for (auto&& t : tokens) {
@@ -145,21 +331,22 @@ namespace hocon {
     shared_token token_iterator::pull_comment(char first_char) {
         bool double_slash = false;
         if (first_char == '/') {
-            int discard = _input->get();
+            int discard = get();
             if (discard != '/') {
                 throw config_exception(_("called pull_comment() but // not seen"));
             }
             double_slash = true;
         }
 
+        // Take everything up to, but not including, the newline
         string result;
-        int c = _input->get();
-        while (*_input && c != '\n') {
-            result += c;
-            c = _input->get();
-        }
-        if (c == '\n') {
-            _input->putback(c);
+        while (true) {
+            char const* newline = find_newline(_pos, _end);
+            result.append(_pos, newline);
+            _pos = newline;
+            if (_pos != _end || !fill()) {
+                break;
+            }
         }
         if (double_slash) {
             return make_shared<double_slash_comment>(_line_origin, result);
@@ -180,9 +367,6 @@ namespace hocon {
         return number_chars_;
     }
 
-    /** Character that stop an unquoted string */
-    static const string not_in_unquoted_text = "$\"{}[]:=,+#`^?!@*&\\";
-
     /**
      * The rules here are intended to maximize convenience while
      * avoiding confusion with real valid JSON. Basically anything
@@ -192,8 +376,8 @@ namespace hocon {
     shared_token token_iterator::pull_unquoted_text() {
         auto const& origin = _line_origin;
         string result;
-        char c = _input->get();
-        while (*_input
+        char c = get();
+        while (good()
                && not_in_unquoted_text.find(c) == string::npos
                && !is_whitespace(c)
                && !start_of_comment(c)) {
@@ -211,63 +395,97 @@ namespace hocon {
             } else if (result.length() == 5) {
                 if (result == "false") {
                     return make_shared<value>(make_shared<config_boolean>(origin, false));
+                } else {
+                    // Past the keywords, so the rest of the text can be taken a run at a time
+                    pull_unquoted_run(result);
+                    return make_shared<unquoted_text>(origin, result);
                 }
             }
 
-            c = _input->get();
+            c = get();
         }
 
         // Put back the char that ended the unquoted text
-        _input->putback(c);
+        unget();
 
 
         return make_shared<unquoted_text>(origin, result);
     }
 
+    void token_iterator::pull_unquoted_run(string& result) {
+        while (true) {
+            char const* run_end = find_unquoted_run_end(_pos, _end);
+            result.append(_pos, run_end);
+            _pos = run_end;
+            if (_pos == _end) {
+                if (!fill()) {
+                    return;
+                }
+                continue;
+            }
+
+            // A lone '/' is part of the text; "//" starts a comment when comments are allowed
+            if (*_pos == '/') {
+                get();
+                if (!_allow_comments || peek() != '/') {
+                    result += '/';
+                    continue;
+                }
+                unget();
+            }
+            return;
+        }
+    }
+
     shared_token token_iterator::pull_number(char first_char) {
         string result;
         result += first_char;
         bool contained_decimal_or_E = false;
-        char c = _input->get();
-        while (*_input && number_chars().find(c) != string::npos) {
+        char c = get();
+        while (good() && number_chars().find(c) != string::npos) {
             if (c == '.' || c == 'e' || c == 'E') {
                 contained_decimal_or_E = true;
             }
             result += c;
-            c = _input->get();
+            c = get();
         }
 
         // The last char we looked at wasn't part of the number, put it back
-        _input->putback(c);
-
-        try {
-            if (contained_decimal_or_E) {
-                return make_shared<value>(config_number::new_number(
-                        _line_origin, boost::lexical_cast<double>(result), result));
-            } else {
-                return make_shared<value>(config_number::new_number(
-                        _line_origin, boost::lexical_cast<int64_t>(result), result));
+        unget();
+
+        // The token keeps the text as written, rather than rendering it back from the number
+        if (contained_decimal_or_E) {
+            double number;
+            if (parse_double(result, number)) {
+                auto parsed = config_number::new_number(_line_origin, number, result);
+                return make_shared<value>(move(parsed), move(result));
             }
-        } catch (boost::bad_lexical_cast const& ex) {
-            // not a number after all, see if it's an unquoted string
-            for (char character : result) {
-                if (not_in_unquoted_text.find(character) != string::npos) {
-                    throw config_exception(_("Line {1}: Reserved character '{2}' not allowed outside quotes", std::to_string(_line_number), character));
-                }
+        } else {
+            int64_t number;
+            if (parse_int64(result, number)) {
+                auto parsed = config_number::new_number(_line_origin, number, result);
+                return make_shared<value>(move(parsed), move(result));
+            }
+        }
+
+        // not a number after all, see if it's an unquoted string
+        for (char character : result) {
+            if (not_in_unquoted_text.find(character) != string::npos) {
+                throw config_exception(_("Line {1}: Reserved character '{2}' not allowed outside quotes", std::to_string(_line_number), character));
             }
-            // no disallowed chars, so we decide this was a string and not a number
-            return make_shared<unquoted_text>(_line_origin, result);
         }
+        // no disallowed chars, so we decide this was a string and not a number
+        return make_shared<unquoted_text>(_line_origin, result);
     }
 
     void token_iterator::pull_escape_sequence(string& parsed, string& original) {
-        if (!*_input) {
+        if (!good()) {
             throw config_exception(_("End of input but backslash in string had nothing after it"));
         }
 
         // This is needed so we return the unescaped escape characters back out when rendering
         // the token
-        char escaped = _input->get();
+        char escaped = get();
         original += "\\";
         original += escaped;
 
@@ -299,10 +517,10 @@ namespace hocon {
             case 'u': {
                 char utf[5] = {};
                 for (int i = 0; i < 4; i++) {
-                    if (!*_input) {
+                    if (!good()) {
                         throw config_exception(_("End of input but expecting 4 hex digits for \\uXXXX escape"));
                     }
-                    utf[i] = _input->get();
+                    utf[i] = get();
                 }
                 original += string(utf);
                 unsigned short character;
@@ -320,21 +538,20 @@ namespace hocon {
         // We are after the opening triple quote and need to consume the close triple
         int consecutive_quotes = 0;
         while (true) {
-            char c = _input->get();
+            char c = get();
             if (c == '"') {
                 consecutive_quotes++;
             } else if (consecutive_quotes >= 3) {
                 // The last three quotes end the string, and the others are kept.
                 parsed = parsed.substr(0, parsed.length() - 3);
-                _input->putback(c);
+                unget();
                 break;
             } else {
                 consecutive_quotes = 0;
-                if (!*_input) {
+                if (!good()) {
                     throw config_exception(_("End of input but triple-quoted string was still open"));
                 } else if (c == '\n') {
-                    _line_number++;
-                    _line_origin = _origin->with_line_number(_line_number);
+                    next_line();
                 }
             }
             parsed += c;
@@ -352,11 +569,11 @@ namespace hocon {
         string original = "\"";
 
         while (true) {
-            if (!*_input) {
+            if (!good()) {
                 throw config_exception(_("End of input but string quote was still open"));
             }
 
-            char c = _input->get();
+            char c = get();
             if (c == '\\') {
                 pull_escape_sequence(result, original);
             } else if (c == '"') {
@@ -372,21 +589,21 @@ namespace hocon {
 
         // maybe switch to triple quoted string
         if (result.length() == 0) {
-            char third = _input->get();
+            char third = get();
             if (third == '"') {
                 original += third;
                 append_triple_quoted_string(result, original);
             } else {
-                _input->putback(third);
+                unget();
             }
         }
 
         return make_shared<value>(make_shared<config_string>(_line_origin, result, config_string_type::QUOTED),
-                                               original);
+                                 original);
     }
 
     shared_token const& token_iterator::pull_plus_equals() {
-        char c = _input->get();
+        char c = get();
         if (c != '=') {
             throw config_exception(_("'+' not followed by '=', '{1}' not allowed after '+'", string(1, c)));
         }
@@ -395,18 +612,17 @@ namespace hocon {
 
     shared_token token_iterator::pull_substitution() {
         // The initial '$' has already been consumed
-        auto const& origin = _line_origin;
-        char c = _input->get();
+        char c = get();
         if (c != '{') {
             throw config_exception(_("'$' not followed by '{', '{1}' not allowed after '$'", string(1, c)));
         }
 
         bool optional = false;
-        c = _input->get();
+        c = get();
         if (c == '?') {
             optional = true;
         } else {
-            _input->putback(c);
+            unget();
         }
 
         whitespace_saver saver;
@@ -425,7 +641,7 @@ namespace hocon {
             } else if (t == tokens::end_token()) {
                 throw config_exception(_("Substitution '${' was not closed with a '}'"));
             } else {
-                shared_token whitespace = saver.check(t->get_token_type(), origin, _line_number);
+                shared_token whitespace = saver.check(t->get_token_type(), _line_origin);
                 if (whitespace != nullptr) {
                     expression.push_back(whitespace);
                 }
@@ -438,12 +654,11 @@ namespace hocon {
 
     shared_token token_iterator::pull_next_token(whitespace_saver& saver) {
         char c = next_char_after_whitespace(saver);
-        if (!*_input) {
+        if (!good()) {
             return tokens::end_token();
         } else if (c == '\n') {
             shared_token newline = make_shared<line>(_line_origin);
-            _line_number++;
-            _line_origin = _origin->with_line_number(_line_number);
+            next_line();
             return newline;
         } else {
             shared_token t;
@@ -492,7 +707,7 @@ namespace hocon {
                     } else if (not_in_unquoted_text.find(c) != string::npos) {
                         throw config_exception(_("Reserved character '{1}' is not allowed outside quotes", string(1, c)));
                     } else {
-                        _input->putback(c);
+                        unget();
                         t = pull_unquoted_text();
                     }
                 }
@@ -508,21 +723,22 @@ namespace hocon {
 
     void token_iterator::queue_next_token() {
         shared_token t = pull_next_token(_whitespace_saver);
-        shared_token whitespace = _whitespace_saver.check(t->get_token_type(), _origin, _line_number);
+        shared_token whitespace = _whitespace_saver.check(t->get_token_type(), _line_origin);
+        _tokens_head = 0;
         if (whitespace != nullptr) {
-           _tokens.push(whitespace);
+           _tokens[_tokens_size++] = move(whitespace);
         }
-        _tokens.push(t);
+        _tokens[_tokens_size++] = move(t);
     }
 
     bool token_iterator::has_next() {
-        return !_tokens.empty();
+        return _tokens_size != 0;
     }
 
     shared_token token_iterator::next() {
-        shared_token t = _tokens.front();
-        _tokens.pop();
-        if (_tokens.empty() && t != tokens::end_token()) {
+        shared_token t = move(_tokens[_tokens_head++]);
+        _tokens_size--;
+        if (_tokens_size == 0 && t != tokens::end_token()) {
             try {
                 queue_next_token();
             } catch (config_exception& ex) {
@@ -532,7 +748,7 @@ namespace hocon {
                 // This will require rewriting some tests, will wait and
                 // see how exceptions are handled elsewhere before switching
             }
-            if (_tokens.empty()) {
+            if (_tokens_size == 0) {
                 throw config_exception(_("Tokens queue should not be empty here"));
             }
         }
@@ -0,0 +1,105 @@
+#include <internal/value_interner.hpp>
+#include <internal/value_hash.hpp>
+#include <internal/values/config_number.hpp>
+#include <internal/values/config_string.hpp>
+#include <internal/values/simple_config_list.hpp>
+#include <internal/values/simple_config_object.hpp>
+
+#include <algorithm>
+#include <typeinfo>
+
+using namespace std;
+
+namespace hocon {
+
+    shared_value value_interner::intern(shared_value const& value) {
+        shared_value candidate = value;
+        if (auto object = dynamic_pointer_cast<const simple_config_object>(value)) {
+            persistent_map entries = object->entry_set();
+            bool changed = false;
+            for (auto const& entry : object->entry_set()) {
+                auto interned = intern(entry.second);
+                if (interned != entry.second) {
+                    entries = entries.set(entry.first, move(interned));
+                    changed = true;
+                }
+            }
+            if (changed) {
+                candidate = make_shared<simple_config_object>(object->origin(), move(entries),
+                                                              object->get_resolve_status(),
+                                                              object->ignores_fallbacks());
+            }
+        } else if (auto list = dynamic_pointer_cast<const simple_config_list>(value)) {
+            // Packed lists hold no values to share
+            if (!list->packed()) {
+                vector<shared_value> elements;
+                elements.reserve(list->size());
+                bool changed = false;
+                for (auto const& element : *list) {
+                    auto interned = intern(element);
+                    changed = changed || interned != element;
+                    elements.push_back(move(interned));
+                }
+                if (changed) {
+                    candidate = make_shared<simple_config_list>(list->origin(), move(elements),
+                                                                list->get_resolve_status());
+                }
+            }
+        }
+
+        auto candidate_hash = hash(*candidate);
+        auto range = _values.equal_range(candidate_hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (interchangeable(*it->second, *candidate)) {
+                return it->second;
+            }
+        }
+        _values.emplace(candidate_hash, candidate);
+        return candidate;
+    }
+
+    uint64_t value_interner::hash(config_value const& value) {
+        // Numbers that are equal but written differently, like 1 and 1.0, hash alike
+        if (dynamic_cast<const config_number*>(&value)) {
+            return value_hash::combine(value.hash_code(), value_hash::of_string(value.transform_to_string()));
+        }
+        return value.hash_code();
+    }
+
+    bool value_interner::interchangeable(config_value const& a, config_value const& b) {
+        if (typeid(a) != typeid(b)) {
+            return false;
+        }
+
+        // The children of both are interned, so interchangeable children are the same value
+        if (auto object = dynamic_cast<const simple_config_object*>(&a)) {
+            auto const& mine = object->entry_set();
+            auto const& theirs = static_cast<const simple_config_object&>(b).entry_set();
+            if (mine.size() != theirs.size()) {
+                return false;
+            }
+            for (auto const& entry : mine) {
+                if (theirs.get(entry.first) != entry.second) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        if (auto list = dynamic_cast<const simple_config_list*>(&a)) {
+            auto const& other = static_cast<const simple_config_list&>(b);
+            if (list->packed() || other.packed()) {
+                return list->packed() && other.packed() && list->packed()->same_text(*other.packed());
+            }
+            return list->size() == other.size() && equal(list->begin(), list->end(), other.begin());
+        }
+
+        if (!(a == b) || a.transform_to_string() != b.transform_to_string()) {
+            return false;
+        }
+        if (auto str = dynamic_cast<const config_string*>(&a)) {
+            return str->was_quoted() == static_cast<const config_string&>(b).was_quoted();
+        }
+        return true;
+    }
+
+}  // namespace hocon
@@ -1,4 +1,5 @@
 #include <internal/values/config_boolean.hpp>
+#include <internal/value_hash.hpp>
 
 using namespace std;
 
@@ -19,8 +20,8 @@ namespace hocon {
         return _value;
     }
 
-    unwrapped_value config_boolean::unwrapped() const {
-        return _value;
+    void config_boolean::accept(config_value_visitor& visitor) const {
+        visitor.bool_value(_value);
     }
 
     shared_value config_boolean::new_copy(shared_origin origin) const {
@@ -31,4 +32,8 @@ namespace hocon {
         return equals<config_boolean>(other, [&](config_boolean const& o) { return _value == o._value; });
     }
 
+    uint64_t config_boolean::compute_hash() const {
+        return value_hash::of_bool(_value);
+    }
+
 }  // namespace hocon
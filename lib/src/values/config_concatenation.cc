@@ -10,6 +10,7 @@
 #include <internal/resolve_result.hpp>
 #include <internal/resolve_source.hpp>
 #include <internal/resolve_context.hpp>
+#include <internal/value_hash.hpp>
 #include <leatherman/locale/locale.hpp>
 
 // Mark string for translation (alias for leatherman::locale::format)
@@ -168,20 +169,29 @@ namespace hocon {
     bool config_concatenation::operator==(config_value const& other) const {
         // note that "origin" is deliberately NOT part of equality
         return equals<config_concatenation>(other, [&](config_concatenation const& o) {
-            if (_pieces.size() != o._pieces.size()) { return false; }
-            bool result = true;
+            if (_pieces.size() != o._pieces.size() || hash_code() != o.hash_code()) { return false; }
             for (unsigned long i = 0; i < _pieces.size(); i++) {
-                result = *_pieces[i] == *o._pieces[i];
+                if (!(*_pieces[i] == *o._pieces[i])) {
+                    return false;
+                }
             }
-            return result;
+            return true;
         });
     }
 
+    uint64_t config_concatenation::compute_hash() const {
+        uint64_t hash = value_hash::CONCATENATION;
+        for (auto const& piece : _pieces) {
+            hash = value_hash::combine(hash, piece->hash_code());
+        }
+        return hash;
+    }
+
     shared_value config_concatenation::new_copy(shared_origin origin) const {
         return make_shared<config_concatenation>(move(origin), _pieces);
     }
 
-    unwrapped_value config_concatenation::unwrapped() const {
+    void config_concatenation::accept(config_value_visitor& visitor) const {
         throw config_exception(_("Not resolved, call config::resolve() before attempting to unwrap. See API docs."));
     }
 
@@ -5,6 +5,7 @@
 #include <internal/resolve_context.hpp>
 #include <internal/resolve_result.hpp>
 #include <internal/resolve_source.hpp>
+#include <internal/value_hash.hpp>
 
 #include <leatherman/locale/locale.hpp>
 
@@ -59,7 +60,7 @@ namespace hocon {
         throw config_exception(_("called value_type() on value with unresolved substitutions, need to config#resolve() first, see API docs."));
     }
 
-    unwrapped_value config_delayed_merge::unwrapped() const {
+    void config_delayed_merge::accept(config_value_visitor& visitor) const {
         throw config_exception(_("called unwrapped() on value with unresolved substitutions, need to config::resolve() first, see API docs."));
     }
 
@@ -127,6 +128,14 @@ namespace hocon {
         return equals<config_delayed_merge>(other, [&](config_delayed_merge const& o) { return _stack == o._stack; });
     }
 
+    uint64_t config_delayed_merge::compute_hash() const {
+        uint64_t hash = value_hash::DELAYED_MERGE;
+        for (auto const& value : _stack) {
+            hash = value_hash::combine(hash, value->hash_code());
+        }
+        return hash;
+    }
+
     shared_value config_delayed_merge::replace_child(shared_value const& child, shared_value replacement) const
     {
         auto new_stack = replace_child_in_list(_stack, child, move(replacement));
@@ -2,6 +2,7 @@
 #include <internal/values/config_delayed_merge.hpp>
 #include <internal/values/simple_config_list.hpp>
 #include <internal/resolve_result.hpp>
+#include <internal/value_hash.hpp>
 #include <hocon/config_exception.hpp>
 #include <leatherman/locale/locale.hpp>
 
@@ -57,7 +58,7 @@ namespace hocon {
         return make_shared<config_delayed_merge_object>(move(origin), _stack);
     }
 
-    unwrapped_value config_delayed_merge_object::unwrapped() const {
+    void config_delayed_merge_object::accept(config_value_visitor& visitor) const {
         throw config_exception(_("need to config::resolve before using this object, see the API docs."));
     }
 
@@ -137,7 +138,7 @@ namespace hocon {
         throw bug_or_broken_exception(_("Delayed merge stack does not contain any unmergeable values"));
     }
 
-    unordered_map<string, shared_value> const& config_delayed_merge_object::entry_set() const {
+    persistent_map const& config_delayed_merge_object::entry_set() const {
         throw not_resolved();
     }
 
@@ -157,6 +158,14 @@ namespace hocon {
         return equals<config_delayed_merge_object>(other, [&](config_delayed_merge_object const& o) { return _stack == o._stack; });
     }
 
+    uint64_t config_delayed_merge_object::compute_hash() const {
+        uint64_t hash = value_hash::DELAYED_MERGE_OBJECT;
+        for (auto const& value : _stack) {
+            hash = value_hash::combine(hash, value->hash_code());
+        }
+        return hash;
+    }
+
     bool config_delayed_merge_object::ignores_fallbacks() const {
         return _stack.back()->ignores_fallbacks();
     }
@@ -1,11 +1,15 @@
 #include <internal/values/config_double.hpp>
+#include <cctype>
+#include <cstdio>
 
 using namespace std;
 
 namespace hocon {
 
     config_double::config_double(shared_origin origin, double value, string original_text) :
-            config_number(move(origin), move(original_text)), _value(value) { }
+            config_number(move(origin)), _value(value) {
+        set_original_text(move(original_text));
+    }
 
     std::string config_double::transform_to_string() const {
         string s = config_number::transform_to_string();
@@ -16,8 +20,57 @@ namespace hocon {
         }
     }
 
-    unwrapped_value config_double::unwrapped() const {
-        return _value;
+    string config_double::canonical_text() const {
+        // Fifteen significant digits give back what was written for most decimals, like 3.14
+        char buffer[32];
+        int length = snprintf(buffer, sizeof(buffer), "%.15g", _value);
+        string text(buffer, length > 0 ? length : 0);
+        // Whatever the C locale's decimal point, parsed text uses a period
+        for (auto& c : text) {
+            if (c == ',') {
+                c = '.';
+            }
+        }
+        return text;
+    }
+
+    bool config_double::is_canonical(string const& text) const {
+        // Formatting the value to compare would dominate parsing numeric arrays, so check
+        // the text's shape instead: a plain decimal with at most 15 significant digits and
+        // no redundant zeros comes back unchanged from %.15g, which round-trips that many
+        // digits and only switches to an exponent outside 1e-4 to 1e15.
+        size_t i = (!text.empty() && text[0] == '-') ? 1 : 0;
+        size_t int_start = i;
+        while (i < text.size() && isdigit(static_cast<unsigned char>(text[i]))) {
+            ++i;
+        }
+        size_t int_digits = i - int_start;
+        if (int_digits == 0 || int_digits > 15 || (int_digits > 1 && text[int_start] == '0')) {
+            return false;
+        }
+        if (i == text.size() || text[i] != '.') {
+            return false;
+        }
+        size_t frac_start = ++i;
+        while (i < text.size() && isdigit(static_cast<unsigned char>(text[i]))) {
+            ++i;
+        }
+        if (i != text.size() || i == frac_start || text.back() == '0') {
+            return false;
+        }
+        size_t significant = int_digits + (i - frac_start);
+        if (text[int_start] == '0') {
+            size_t leading_zeros = text.find_first_not_of('0', frac_start) - frac_start;
+            if (leading_zeros > 3) {
+                return false;
+            }
+            significant = i - frac_start - leading_zeros;
+        }
+        return significant <= 15;
+    }
+
+    void config_double::accept(config_value_visitor& visitor) const {
+        visitor.double_value(_value);
     }
 
     int64_t config_double::long_value() const {
@@ -29,7 +82,7 @@ namespace hocon {
     }
 
     shared_value config_double::new_copy(shared_origin origin) const {
-        return make_shared<config_double>(move(origin), _value, _original_text);
+        return make_shared<config_double>(move(origin), _value, original_text());
     }
 
 }  // namespace hocon
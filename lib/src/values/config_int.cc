@@ -5,7 +5,9 @@ using namespace std;
 namespace hocon {
 
     config_int::config_int(shared_origin origin, int value, string original_text) :
-            config_number(move(origin), move(original_text)), _value(value) { }
+            config_number(move(origin)), _value(value) {
+        set_original_text(move(original_text));
+    }
 
     std::string config_int::transform_to_string() const {
         string s = config_number::transform_to_string();
@@ -16,8 +18,12 @@ namespace hocon {
         }
     }
 
-    unwrapped_value config_int::unwrapped() const {
-        return _value;
+    string config_int::canonical_text() const {
+        return to_string(_value);
+    }
+
+    void config_int::accept(config_value_visitor& visitor) const {
+        visitor.int_value(_value);
     }
 
     int64_t config_int::long_value() const {
@@ -29,7 +35,7 @@ namespace hocon {
     }
 
     shared_value config_int::new_copy(shared_origin origin) const {
-        return make_shared<config_int>(move(origin), _value, _original_text);
+        return make_shared<config_int>(move(origin), _value, original_text());
     }
 
 }  // namespace hocon
@@ -5,7 +5,9 @@ using namespace std;
 namespace hocon {
 
     config_long::config_long(shared_origin origin, int64_t value, string original_text) :
-            config_number(move(origin), move(original_text)), _value(value) { }
+            config_number(move(origin)), _value(value) {
+        set_original_text(move(original_text));
+    }
 
     std::string config_long::transform_to_string() const {
         string s = config_number::transform_to_string();
@@ -16,8 +18,12 @@ namespace hocon {
         }
     }
 
-    unwrapped_value config_long::unwrapped() const {
-        return _value;
+    string config_long::canonical_text() const {
+        return to_string(_value);
+    }
+
+    void config_long::accept(config_value_visitor& visitor) const {
+        visitor.long_value(_value);
     }
 
     int64_t config_long::long_value() const {
@@ -29,7 +35,7 @@ namespace hocon {
     }
 
     shared_value config_long::new_copy(shared_origin origin) const {
-        return make_shared<config_long>(move(origin), _value, _original_text);
+        return make_shared<config_long>(move(origin), _value, original_text());
     }
 
 }  // namespace hocon
@@ -1,4 +1,5 @@
 #include <internal/values/config_null.hpp>
+#include <internal/value_hash.hpp>
 #include <boost/blank.hpp>
 
 using namespace std;
@@ -20,14 +21,18 @@ namespace hocon {
         return make_shared<config_null>(move(origin));
     }
 
-    unwrapped_value config_null::unwrapped() const {
-        return boost::blank();
+    void config_null::accept(config_value_visitor& visitor) const {
+        visitor.null_value();
     }
 
     bool config_null::operator==(config_value const& other) const {
         return dynamic_cast<config_null const*>(&other);
     }
 
+    uint64_t config_null::compute_hash() const {
+        return value_hash::mix(value_hash::NULL_VALUE);
+    }
+
     void config_null::render(string& result, int indent, bool at_root, config_render_options options) const {
         result += "null";
     }
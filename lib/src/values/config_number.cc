@@ -2,6 +2,7 @@
 #include <internal/values/config_int.hpp>
 #include <internal/values/config_long.hpp>
 #include <internal/values/config_double.hpp>
+#include <internal/value_hash.hpp>
 #include <hocon/config_exception.hpp>
 #include <leatherman/locale/locale.hpp>
 #include <limits>
@@ -13,15 +14,45 @@ using namespace std;
 
 namespace hocon {
 
-    config_number::config_number(shared_origin origin, string original_text) :
-            config_value(move(origin)), _original_text(move(original_text)) { }
+    config_number::config_number(shared_origin origin) :
+            config_value(move(origin)), _text_form(text_form::NONE) { }
+
+    void config_number::set_original_text(string text) {
+        if (text.empty()) {
+            _text_form = text_form::NONE;
+        } else if (is_canonical(text)) {
+            _text_form = text_form::CANONICAL;
+        } else {
+            _stored_text.reset(new string(move(text)));
+            _text_form = text_form::STORED;
+        }
+    }
+
+    bool config_number::is_canonical(string const& text) const {
+        return text == canonical_text();
+    }
+
+    bool config_number::has_canonical_text() const {
+        return _text_form == text_form::CANONICAL;
+    }
+
+    string config_number::original_text() const {
+        switch (_text_form) {
+            case text_form::CANONICAL:
+                return canonical_text();
+            case text_form::STORED:
+                return *_stored_text;
+            default:
+                return {};
+        }
+    }
 
     config_value::type config_number::value_type() const {
         return config_value::type::NUMBER;
     }
 
     string config_number::transform_to_string() const {
-        return _original_text;
+        return original_text();
     }
 
     bool config_number::is_whole() const {
@@ -69,10 +100,30 @@ namespace hocon {
         }
     }
 
+    shared_ptr<config_number> config_number::new_canonical_number(shared_origin origin, int64_t value) {
+        auto number = new_number(move(origin), value, "");
+        number->_text_form = text_form::CANONICAL;
+        return number;
+    }
+
+    shared_ptr<config_number> config_number::new_canonical_number(shared_origin origin, double value) {
+        auto number = new_number(move(origin), value, "");
+        number->_text_form = text_form::CANONICAL;
+        return number;
+    }
+
     bool config_number::operator==(config_value const& other) const {
         return equals<config_number>(other, [&](config_number const& o) {
             return long_value() == o.long_value() && double_value() == o.double_value();
         });
     }
 
+    uint64_t config_number::compute_hash() const {
+        // Equal numbers of different classes, like an int and a long, hash the same
+        if (is_whole()) {
+            return value_hash::of_number(long_value());
+        }
+        return value_hash::of_number(double_value());
+    }
+
 }  // namespace hocon
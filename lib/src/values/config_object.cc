@@ -2,6 +2,7 @@
 #include <hocon/config.hpp>
 #include <internal/simple_config_origin.hpp>
 #include <internal/values/config_delayed_merge_object.hpp>
+#include <internal/symbol_table.hpp>
 #include <hocon/config_exception.hpp>
 #include <hocon/path.hpp>
 #include <leatherman/locale/locale.hpp>
@@ -22,7 +23,7 @@ namespace hocon {
     shared_value config_object::peek_path(const config_object* self, path desired_path) {
         try {
             path next = desired_path.remainder();
-            shared_value v = self->attempt_peek_with_partial_resolve(*desired_path.first());
+            shared_value v = self->attempt_peek_with_partial_resolve(*desired_path.element(0));
 
             if (next.empty()) {
                 return v;
@@ -38,7 +39,11 @@ namespace hocon {
         }
     }
 
-    shared_value config_object::peek_assuming_resolved(std::string const& key, path original_path) const {
+    shared_value config_object::attempt_peek_with_partial_resolve(symbol const& key) const {
+        return attempt_peek_with_partial_resolve(key.text);
+    }
+
+    shared_value config_object::peek_assuming_resolved(symbol const& key, path const& original_path) const {
         try {
             return attempt_peek_with_partial_resolve(key);
         } catch (config_exception& ex) {
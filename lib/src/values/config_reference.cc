@@ -4,6 +4,7 @@
 #include <internal/resolve_source.hpp>
 #include <internal/container.hpp>
 #include <internal/substitution_expression.hpp>
+#include <internal/value_hash.hpp>
 #include <leatherman/locale/locale.hpp>
 
 // Mark string for translation (alias for leatherman::locale::format)
@@ -24,7 +25,7 @@ namespace hocon {
         return {shared_from_this()};
     }
 
-    unwrapped_value config_reference::unwrapped() const {
+    void config_reference::accept(config_value_visitor& visitor) const {
         throw not_resolved_exception(_("Can't unwrap a config reference."));
     }
 
@@ -40,12 +41,18 @@ namespace hocon {
         return equals<config_reference>(other, [&](config_reference const& o) { return *_expr == *o._expr; });
     }
 
+    uint64_t config_reference::compute_hash() const {
+        auto hash = value_hash::combine(value_hash::REFERENCE, _expr->get_path().hash());
+        return value_hash::combine(hash, _expr->optional() ? 1 : 0);
+    }
+
     resolve_status config_reference::get_resolve_status() const {
         return resolve_status::UNRESOLVED;
     }
 
     resolve_result<shared_value> config_reference::resolve_substitutions(resolve_context const &context, resolve_source const &source) const {
-        resolve_context new_context = context.add_cycle_marker(shared_from_this());
+        resolve_context::cycle_marker marker(context, shared_from_this());
+        resolve_context new_context = context;
         shared_value v;
 
         try {
@@ -70,12 +77,12 @@ namespace hocon {
 
         if (!v && !_expr->optional()) {
             if (new_context.options().get_allow_unresolved()) {
-                return make_resolve_result(new_context.remove_cycle_marker(shared_from_this()), shared_from_this());
+                return make_resolve_result(new_context, shared_from_this());
             } else {
                 throw unresolved_substitution_exception(*origin(), _expr->to_string());
             }
         } else {
-            return make_resolve_result(new_context.remove_cycle_marker(shared_from_this()), v);
+            return make_resolve_result(new_context, v);
         }
     }
 
@@ -1,4 +1,5 @@
 #include <internal/values/config_string.hpp>
+#include <internal/value_hash.hpp>
 
 using namespace std;
 
@@ -19,8 +20,8 @@ namespace hocon {
         return make_shared<config_string>(move(origin), _text, _quoted);
     }
 
-    unwrapped_value config_string::unwrapped() const {
-        return _text;
+    void config_string::accept(config_value_visitor& visitor) const {
+        visitor.string_value(_text);
     }
 
     bool config_string::was_quoted() const {
@@ -31,6 +32,10 @@ namespace hocon {
         return equals<config_string>(other, [&](config_string const& o) { return _text == o._text; });
     }
 
+    uint64_t config_string::compute_hash() const {
+        return value_hash::of_string(_text);
+    }
+
     void config_string::render(std::string& s, int indent, bool at_root, config_render_options options) const {
         string rendered;
 
@@ -17,8 +17,95 @@ using namespace std;
 
 namespace hocon {
 
+    namespace {
+        /**
+         * Builds the unwrapped_value of whatever it visits. Moves are qualified, since
+         * argument-dependent lookup also finds boost::move for variants.
+         */
+        class unwrapping_visitor : public config_value_visitor {
+        public:
+            void begin_object(size_t size) override {
+                _stack.emplace_back(true);
+                _stack.back().object.reserve(size);
+            }
+
+            void key(string const& name) override {
+                _stack.back().key = name;
+            }
+
+            void end_object() override {
+                auto object = std::move(_stack.back().object);
+                _stack.pop_back();
+                add(std::move(object));
+            }
+
+            void begin_list(size_t size) override {
+                _stack.emplace_back(false);
+                _stack.back().list.reserve(size);
+            }
+
+            void end_list() override {
+                auto list = std::move(_stack.back().list);
+                _stack.pop_back();
+                add(std::move(list));
+            }
+
+            void null_value() override { add(boost::blank()); }
+            void bool_value(bool value) override { add(value); }
+            void int_value(int value) override { add(value); }
+            void long_value(int64_t value) override { add(value); }
+            void double_value(double value) override { add(value); }
+            void string_value(string const& value) override { add(value); }
+
+            unwrapped_value& result() { return _result; }
+
+        private:
+            /** An object or list whose contents are still being visited. */
+            struct container {
+                explicit container(bool is_object) : is_object(is_object) {}
+
+                bool is_object;
+                string key;
+                unordered_map<string, unwrapped_value> object;
+                vector<unwrapped_value> list;
+            };
+
+            void add(unwrapped_value value) {
+                if (_stack.empty()) {
+                    _result = std::move(value);
+                } else if (_stack.back().is_object) {
+                    _stack.back().object.emplace(std::move(_stack.back().key), std::move(value));
+                } else {
+                    _stack.back().list.push_back(std::move(value));
+                }
+            }
+
+            vector<container> _stack;
+            unwrapped_value _result;
+        };
+    }
+
     config_value::config_value(shared_origin origin) :
-        _origin(move(origin)) { }
+        _origin(move(origin)), _hash(0) { }
+
+    uint64_t config_value::hash_code() const {
+        // Racing threads compute the same hash, so either store may win
+        auto hash = _hash.load(memory_order_relaxed);
+        if (hash == 0) {
+            hash = compute_hash();
+            if (hash == 0) {
+                hash = 1;
+            }
+            _hash.store(hash, memory_order_relaxed);
+        }
+        return hash;
+    }
+
+    unwrapped_value config_value::unwrapped() const {
+        unwrapping_visitor visitor;
+        accept(visitor);
+        return std::move(visitor.result());
+    }
 
     string config_value::transform_to_string() const {
         return "";
@@ -101,7 +188,7 @@ namespace hocon {
 
     shared_config config_value::at_key(shared_origin origin, std::string const& key) const {
         unordered_map<string, shared_value> map { make_pair(key, shared_from_this()) };
-        return simple_config_object(origin, map).to_config();
+        return make_shared<simple_config_object>(origin, map)->to_config();
     }
 
     shared_config config_value::at_key(std::string const& key) const {
@@ -0,0 +1,253 @@
+#include <internal/values/packed_list.hpp>
+#include <internal/values/config_boolean.hpp>
+#include <internal/values/config_double.hpp>
+#include <internal/values/config_int.hpp>
+#include <internal/values/config_long.hpp>
+#include <internal/value_hash.hpp>
+
+#include <cmath>
+#include <limits>
+#include <typeinfo>
+
+using namespace std;
+
+namespace hocon {
+
+    namespace {
+        /** Doubles held in a NUMBER list are whole below this magnitude, so they convert exactly. */
+        const double exact_whole_limit = 9007199254740992.0;  // 2^53
+
+        /** Doubles beyond this magnitude don't convert to int64_t, so aren't packed. */
+        const double int64_limit = 9.2e18;
+
+        bool fits_int(int64_t value) {
+            return value >= numeric_limits<int>::min() && value <= numeric_limits<int>::max();
+        }
+
+        /** Whether config_number::new_number would make an int or long, not a double, for value. */
+        bool is_whole(double value) {
+            return static_cast<double>(static_cast<int64_t>(value)) == value;
+        }
+
+        /** Visits a whole number as the int or long that parsing would have made it. */
+        void visit_whole(config_value_visitor& visitor, int64_t value) {
+            if (fits_int(value)) {
+                visitor.int_value(static_cast<int>(value));
+            } else {
+                visitor.long_value(value);
+            }
+        }
+    }
+
+    packed_scalar classify_scalar(shared_value const& value) {
+        // The exact type, since every packable value is one of a few final classes and
+        // this runs for every value of every parsed list and object
+        auto const& type = typeid(*value);
+        if (type == typeid(config_boolean)) {
+            return packed_scalar::BOOLEAN;
+        }
+
+        packed_scalar e;
+        if (type == typeid(config_int)) {
+            e = packed_scalar::INT;
+        } else if (type == typeid(config_long)) {
+            e = packed_scalar::LONG;
+        } else if (type == typeid(config_double)) {
+            e = packed_scalar::DOUBLE;
+        } else {
+            return packed_scalar::UNPACKABLE;
+        }
+
+        auto const& number = static_cast<config_number const&>(*value);
+        if (!number.has_canonical_text() && number.original_text().empty()) {
+            return packed_scalar::UNPACKABLE;
+        }
+        if (e == packed_scalar::LONG && fits_int(number.long_value())) {
+            return packed_scalar::UNPACKABLE;
+        }
+        if (e == packed_scalar::DOUBLE) {
+            double d = number.double_value();
+            if (!(fabs(d) < int64_limit) || is_whole(d)) {
+                return packed_scalar::UNPACKABLE;
+            }
+        }
+        return e;
+    }
+
+    packed_list::packed_list(kind k, size_t size) : _kind(k), _size(size) { }
+
+    shared_ptr<const packed_list> packed_list::pack(vector<shared_value> const& values) {
+        if (values.empty()) {
+            return nullptr;
+        }
+
+        bool booleans = false, numbers = false, longs = false, doubles = false, whole = false, inexact = false;
+        for (auto const& value : values) {
+            switch (classify_scalar(value)) {
+                case packed_scalar::BOOLEAN:
+                    booleans = true;
+                    break;
+                case packed_scalar::INT:
+                    numbers = whole = true;
+                    break;
+                case packed_scalar::LONG:
+                    numbers = whole = longs = true;
+                    if (fabs(static_cast<double>(static_cast<config_number const&>(*value).long_value())) >
+                        exact_whole_limit) {
+                        inexact = true;
+                    }
+                    break;
+                case packed_scalar::DOUBLE:
+                    numbers = doubles = true;
+                    break;
+                case packed_scalar::UNPACKABLE:
+                    return nullptr;
+            }
+        }
+
+        kind list_kind;
+        if (booleans) {
+            if (numbers) {
+                return nullptr;
+            }
+            list_kind = kind::BOOLEAN;
+        } else if (!doubles) {
+            list_kind = longs ? kind::LONG : kind::INT;
+        } else if (!whole) {
+            list_kind = kind::DOUBLE;
+        } else if (!inexact) {
+            list_kind = kind::NUMBER;
+        } else {
+            return nullptr;
+        }
+
+        shared_ptr<packed_list> packed(new packed_list(list_kind, values.size()));
+        if (list_kind == kind::BOOLEAN) {
+            packed->_booleans.reserve(values.size());
+            for (auto const& value : values) {
+                packed->_booleans.push_back(static_cast<config_boolean const&>(*value).bool_value());
+            }
+        } else {
+            bool as_longs = list_kind == kind::INT || list_kind == kind::LONG;
+            if (as_longs) {
+                packed->_longs.reserve(values.size());
+            } else {
+                packed->_doubles.reserve(values.size());
+            }
+            for (size_t i = 0; i < values.size(); ++i) {
+                auto const& number = static_cast<config_number const&>(*values[i]);
+                if (as_longs) {
+                    packed->_longs.push_back(number.long_value());
+                } else {
+                    packed->_doubles.push_back(number.double_value());
+                }
+                if (!number.has_canonical_text()) {
+                    packed->_texts.emplace_back(i, number.original_text());
+                }
+            }
+        }
+
+        for (size_t i = 0; i < values.size(); ++i) {
+            auto const& origin = values[i]->origin();
+            if (packed->_origins.empty() || packed->_origins.back().origin != origin) {
+                packed->_origins.push_back({ i, origin });
+            }
+        }
+        packed->_origins.shrink_to_fit();
+        packed->_texts.shrink_to_fit();
+        return packed;
+    }
+
+    vector<shared_value> packed_list::unpack() const {
+        vector<shared_value> values;
+        values.reserve(_size);
+        auto run = _origins.begin();
+        auto text = _texts.begin();
+        for (size_t i = 0; i < _size; ++i) {
+            if (next(run) != _origins.end() && next(run)->first == i) {
+                ++run;
+            }
+            if (_kind == kind::BOOLEAN) {
+                values.push_back(make_shared<config_boolean>(run->origin, _booleans[i]));
+                continue;
+            }
+
+            bool as_longs = _kind == kind::INT || _kind == kind::LONG;
+            if (text != _texts.end() && text->first == i) {
+                if (as_longs) {
+                    values.push_back(config_number::new_number(run->origin, _longs[i], text->second));
+                } else {
+                    values.push_back(config_number::new_number(run->origin, _doubles[i], text->second));
+                }
+                ++text;
+            } else if (as_longs) {
+                values.push_back(config_number::new_canonical_number(run->origin, _longs[i]));
+            } else {
+                values.push_back(config_number::new_canonical_number(run->origin, _doubles[i]));
+            }
+        }
+        return values;
+    }
+
+    void packed_list::accept(config_value_visitor& visitor) const {
+        visitor.begin_list(_size);
+        for (size_t i = 0; i < _size; ++i) {
+            switch (_kind) {
+                case kind::INT:
+                    visitor.int_value(static_cast<int>(_longs[i]));
+                    break;
+                case kind::LONG:
+                    visit_whole(visitor, _longs[i]);
+                    break;
+                case kind::DOUBLE:
+                    visitor.double_value(_doubles[i]);
+                    break;
+                case kind::NUMBER:
+                    if (is_whole(_doubles[i])) {
+                        visit_whole(visitor, static_cast<int64_t>(_doubles[i]));
+                    } else {
+                        visitor.double_value(_doubles[i]);
+                    }
+                    break;
+                case kind::BOOLEAN:
+                    visitor.bool_value(_booleans[i]);
+                    break;
+            }
+        }
+        visitor.end_list();
+    }
+
+    uint64_t packed_list::hash_elements(uint64_t hash) const {
+        for (size_t i = 0; i < _size; ++i) {
+            uint64_t element = 0;
+            switch (_kind) {
+                case kind::INT:
+                case kind::LONG:
+                    element = value_hash::of_number(_longs[i]);
+                    break;
+                case kind::DOUBLE:
+                    element = value_hash::of_number(_doubles[i]);
+                    break;
+                case kind::NUMBER:
+                    element = is_whole(_doubles[i]) ? value_hash::of_number(static_cast<int64_t>(_doubles[i]))
+                                                    : value_hash::of_number(_doubles[i]);
+                    break;
+                case kind::BOOLEAN:
+                    element = value_hash::of_bool(_booleans[i]);
+                    break;
+            }
+            hash = value_hash::combine(hash, element);
+        }
+        return hash;
+    }
+
+    bool packed_list::same_values(packed_list const& other) const {
+        return _kind == other._kind && _longs == other._longs && _doubles == other._doubles &&
+               _booleans == other._booleans;
+    }
+
+    bool packed_list::same_text(packed_list const& other) const {
+        return same_values(other) && _texts == other._texts;
+    }
+
+}  // namespace hocon
@@ -0,0 +1,121 @@
+#include <internal/values/packed_object.hpp>
+#include <internal/values/packed_list.hpp>
+#include <internal/values/config_boolean.hpp>
+#include <internal/values/config_null.hpp>
+#include <internal/values/config_number.hpp>
+#include <internal/values/config_string.hpp>
+
+#include <algorithm>
+#include <typeinfo>
+
+using namespace std;
+
+namespace hocon {
+
+    namespace {
+        bool is_scalar(shared_value const& value) {
+            auto const& type = typeid(*value);
+            return type == typeid(config_null) || type == typeid(config_string) ||
+                   classify_scalar(value) != packed_scalar::UNPACKABLE;
+        }
+    }
+
+    shared_ptr<const packed_object> packed_object::pack(unordered_map<string, shared_value> const& fields) {
+        if (none_of(fields.begin(), fields.end(),
+                    [](pair<string const, shared_value> const& field) { return is_scalar(field.second); })) {
+            return nullptr;
+        }
+
+        shared_ptr<packed_object> packed(new packed_object());
+        packed->_slots.reserve(fields.size());
+        for (auto const& field : fields) {
+            auto const& value = field.second;
+            slot s;
+            s.key = symbol_table::intern(field.first);
+            s.origin = value->origin();
+
+            auto const& type = typeid(*value);
+            if (type == typeid(config_null)) {
+                s.kind = tag::NULL_VALUE;
+            } else if (type == typeid(config_string)) {
+                auto const& text = static_cast<config_string const&>(*value);
+                s.kind = text.was_quoted() ? tag::QUOTED_STRING : tag::UNQUOTED_STRING;
+                s.index = static_cast<uint32_t>(packed->_strings.size());
+                packed->_strings.push_back(text.transform_to_string());
+            } else {
+                auto scalar = classify_scalar(value);
+                if (scalar == packed_scalar::BOOLEAN) {
+                    s.kind = tag::BOOLEAN;
+                    s.boolean = static_cast<config_boolean const&>(*value).bool_value();
+                } else if (scalar != packed_scalar::UNPACKABLE) {
+                    auto const& number = static_cast<config_number const&>(*value);
+                    if (scalar == packed_scalar::DOUBLE) {
+                        s.kind = tag::DOUBLE;
+                        s.real = number.double_value();
+                    } else {
+                        s.kind = tag::WHOLE;
+                        s.whole = number.long_value();
+                    }
+                    if (!number.has_canonical_text()) {
+                        packed->_texts.emplace_back(packed->_slots.size(), number.original_text());
+                    }
+                } else {
+                    s.kind = tag::VALUE;
+                    s.origin.reset();
+                    s.index = static_cast<uint32_t>(packed->_values.size());
+                    packed->_values.push_back(value);
+                    if (value->get_resolve_status() == resolve_status::UNRESOLVED) {
+                        packed->_resolved = resolve_status::UNRESOLVED;
+                    }
+                }
+            }
+            packed->_slots.push_back(move(s));
+        }
+        packed->_values.shrink_to_fit();
+        packed->_strings.shrink_to_fit();
+        packed->_texts.shrink_to_fit();
+        return packed;
+    }
+
+    persistent_map packed_object::unpack() const {
+        vector<pair<symbol_ref, shared_value>> entries;
+        entries.reserve(_slots.size());
+        auto text = _texts.begin();
+        for (size_t i = 0; i < _slots.size(); ++i) {
+            auto const& s = _slots[i];
+            bool has_text = text != _texts.end() && text->first == i;
+            shared_value value;
+            switch (s.kind) {
+                case tag::VALUE:
+                    value = _values[s.index];
+                    break;
+                case tag::NULL_VALUE:
+                    value = make_shared<config_null>(s.origin);
+                    break;
+                case tag::BOOLEAN:
+                    value = make_shared<config_boolean>(s.origin, s.boolean);
+                    break;
+                case tag::WHOLE:
+                    value = has_text ? config_number::new_number(s.origin, s.whole, text->second)
+                                     : config_number::new_canonical_number(s.origin, s.whole);
+                    break;
+                case tag::DOUBLE:
+                    value = has_text ? config_number::new_number(s.origin, s.real, text->second)
+                                     : config_number::new_canonical_number(s.origin, s.real);
+                    break;
+                case tag::QUOTED_STRING:
+                    value = make_shared<config_string>(s.origin, _strings[s.index], config_string_type::QUOTED);
+                    break;
+                case tag::UNQUOTED_STRING:
+                    value = make_shared<config_string>(s.origin, _strings[s.index], config_string_type::UNQUOTED);
+                    break;
+            }
+            if (has_text) {
+                ++text;
+            }
+            entries.emplace_back(s.key, move(value));
+        }
+        return persistent_map(entries);
+    }
+
+}  // namespace hocon
@@ -5,6 +5,7 @@
 #include <internal/resolve_context.hpp>
 #include <internal/resolve_source.hpp>
 #include <internal/resolve_result.hpp>
+#include <internal/value_hash.hpp>
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <leatherman/locale/locale.hpp>
@@ -31,7 +32,8 @@ namespace hocon {
     };
 
     simple_config_list::simple_config_list(shared_origin origin, std::vector<shared_value> value)
-            : config_list(move(origin)), _value(move(value)), _resolved(resolve_status_from_values(_value)) { }
+            : config_list(move(origin)), _value(make_shared<const vector<shared_value>>(move(value))),
+              _size(_value->size()), _built_on_use(false), _resolved(resolve_status_from_values(*_value)) { }
 
 
     simple_config_list::simple_config_list(shared_origin origin, std::vector<shared_value> value,
@@ -41,9 +43,85 @@ namespace hocon {
         }
     }
 
+    simple_config_list::simple_config_list(shared_origin origin, shared_ptr<const packed_list> packed)
+            : config_list(move(origin)), _packed(move(packed)), _size(_packed->size()), _built_on_use(true),
+              _resolved(resolve_status::RESOLVED) { }
+
+    simple_config_list::simple_config_list(shared_origin origin, shared_ptr<const simple_config_list> head,
+                                           shared_ptr<const simple_config_list> tail)
+            : config_list(move(origin)), _head(move(head)), _tail(move(tail)), _size(_head->size() + _tail->size()),
+              _built_on_use(true), _resolved(_head->get_resolve_status() == resolve_status::RESOLVED &&
+                        _tail->get_resolve_status() == resolve_status::RESOLVED ?
+                        resolve_status::RESOLVED : resolve_status::UNRESOLVED) { }
+
+    simple_config_list::simple_config_list(shared_origin origin, simple_config_list const& other)
+            : config_list(move(origin)), _packed(other.packed()), _head(atomic_load(&other._head)),
+              _tail(atomic_load(&other._tail)), _value(atomic_load(&other._value)), _size(other._size),
+              _built_on_use(!_value), _resolved(other._resolved) {
+        // Share other's elements if it has built them. What they're built from is let go
+        // after they're set, so it's read first, and then _value is sure to be set if
+        // the others aren't.
+        if (_value) {
+            _packed.reset();
+            _head.reset();
+            _tail.reset();
+        }
+    }
+
+    shared_ptr<const simple_config_list> simple_config_list::new_literal(shared_origin origin,
+                                                                         vector<shared_value> values)
+    {
+        if (auto packed = packed_list::pack(values)) {
+            return make_shared<simple_config_list>(move(origin), move(packed));
+        }
+        return make_shared<simple_config_list>(move(origin), move(values));
+    }
+
+    vector<shared_value> const& simple_config_list::elements() const
+    {
+        if (_built_on_use) {
+            call_once(_built, [this]() {
+                if (auto packed = atomic_load(&_packed)) {
+                    atomic_store(&_value, make_shared<const vector<shared_value>>(packed->unpack()));
+                    // The elements hold all the packed values did, so keeping both would hold the list twice
+                    atomic_store(&_packed, shared_ptr<const packed_list>());
+                } else {
+                    atomic_store(&_value, make_shared<const vector<shared_value>>(flatten()));
+                    // Keeping the concatenated lists would keep them alive as long as this one
+                    atomic_store(&_head, shared_ptr<const simple_config_list>());
+                    atomic_store(&_tail, shared_ptr<const simple_config_list>());
+                }
+            });
+        }
+        return *_value;
+    }
+
+    vector<shared_value> simple_config_list::flatten() const
+    {
+        // Repeated += nests concatenations deeply on the left, so walk them with a stack.
+        // A nested concatenation another thread has flattened has let go of its lists,
+        // but then it has its elements.
+        vector<shared_value> values;
+        values.reserve(_size);
+        vector<shared_ptr<const simple_config_list>> pending { _tail, _head };
+        while (!pending.empty()) {
+            auto list = move(pending.back());
+            pending.pop_back();
+            auto head = atomic_load(&list->_head);
+            auto tail = atomic_load(&list->_tail);
+            if (head && tail) {
+                pending.push_back(move(tail));
+                pending.push_back(move(head));
+            } else {
+                values.insert(values.end(), list->begin(), list->end());
+            }
+        }
+        return values;
+    }
+
     shared_value simple_config_list::replace_child(shared_value const& child, shared_value replacement) const
     {
-        auto new_list = replace_child_in_list(_value, child, replacement);
+        auto new_list = replace_child_in_list(elements(), child, replacement);
         if (new_list.empty()) {
             return nullptr;
         } else {
@@ -53,7 +131,7 @@ namespace hocon {
 
     bool simple_config_list::has_descendant(shared_value const& descendant) const
     {
-        return has_descendant_in_list(_value, descendant);
+        return has_descendant_in_list(elements(), descendant);
     }
 
     resolve_result<shared_value>
@@ -81,26 +159,36 @@ namespace hocon {
     std::shared_ptr<const simple_config_list> simple_config_list::concatenate(shared_ptr<const simple_config_list> other) const
     {
         auto combined_origin = simple_config_origin::merge_origins(origin(), other->origin());
-        vector<shared_value> combined;
-        combined.reserve(size() + other->size());
-        combined.insert(combined.end(), begin(), end());
-        combined.insert(combined.end(), other->begin(), other->end());
-        return make_shared<simple_config_list>(combined_origin, move(combined));
+        if (is_empty()) {
+            return make_shared<simple_config_list>(move(combined_origin), *other);
+        }
+        if (other->is_empty()) {
+            return make_shared<simple_config_list>(move(combined_origin), *this);
+        }
+        return make_shared<simple_config_list>(move(combined_origin),
+                                               dynamic_pointer_cast<const simple_config_list>(shared_from_this()),
+                                               move(other));
     }
 
     shared_value simple_config_list::new_copy(shared_origin origin) const
     {
-        // TODO: Copies the list, but the list is immutable so we could share the vector.
-        //       Best to deal with in a rewrite that encapsulates shared_ptr and immutability better.
-        return make_shared<simple_config_list>(move(origin), _value);
+        return make_shared<simple_config_list>(move(origin), *this);
     }
 
     bool simple_config_list::operator==(config_value const& other) const
     {
         return equals<simple_config_list>(other, [&](simple_config_list const& o) {
-            if (size() != o.size()) {
+            if (this == &o) {
+                return true;
+            }
+            if (size() != o.size() || hash_code() != o.hash_code()) {
                 return false;
             }
+            auto mine = packed();
+            auto theirs = o.packed();
+            if (mine && theirs && mine->same_values(*theirs)) {
+                return true;
+            }
 
             if (equal(begin(), end(), o.begin(),
                       [](shared_value const& a, shared_value const& b) { return a == b; })) {
@@ -111,19 +199,31 @@ namespace hocon {
         });
     }
 
+    uint64_t simple_config_list::compute_hash() const
+    {
+        if (auto packed = this->packed()) {
+            return packed->hash_elements(value_hash::LIST);
+        }
+        uint64_t hash = value_hash::LIST;
+        for (auto const& v : elements()) {
+            hash = value_hash::combine(hash, v->hash_code());
+        }
+        return hash;
+    }
+
     void simple_config_list::render(std::string& sb,
                                     int num_indent,
                                     bool at_root,
                                     config_render_options options) const
     {
-        if (_value.empty()) {
+        if (is_empty()) {
             sb.append("[]");
         } else {
             sb.push_back('[');
             if (options.get_formatted()) {
                 sb.push_back('\n');
             }
-            for (auto &v : _value) {
+            for (auto &v : elements()) {
                 if (options.get_origin_comments()) {
                     // Could be done more efficiently with a split_iterator, but those are trickier to use with range-for.
                     vector<string> lines;
@@ -165,12 +265,16 @@ namespace hocon {
     }
 
 
-    unwrapped_value simple_config_list::unwrapped() const {
-        vector<unwrapped_value> values;
-        for (auto it = _value.begin(), endIt = _value.end(); it != endIt; ++it) {
-            values.emplace_back((*it)->unwrapped());
+    void simple_config_list::accept(config_value_visitor& visitor) const {
+        if (auto packed = this->packed()) {
+            packed->accept(visitor);
+            return;
         }
-        return values;
+        visitor.begin_list(size());
+        for (auto const& v : *this) {
+            v->accept(visitor);
+        }
+        visitor.end_list();
     }
 
     std::shared_ptr<const simple_config_list>
@@ -187,13 +291,13 @@ namespace hocon {
     {
         bool init = false;
         vector<shared_value> changed;
-        for (auto it = _value.begin(), endIt = _value.end(); it != endIt; ++it) {
+        for (auto it = begin(), endIt = end(); it != endIt; ++it) {
             auto modified = modifier.modify_child_may_throw({}, *it);
 
             // lazy-create the new list if required
             if (changed.empty() && modified != *it) {
-                changed.reserve(_value.size());
-                changed.insert(changed.end(), _value.begin(), it);
+                changed.reserve(size());
+                changed.insert(changed.end(), begin(), it);
                 init = true;
             }
 
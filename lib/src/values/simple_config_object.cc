@@ -6,8 +6,8 @@
 #include <internal/resolve_source.hpp>
 #include <internal/resolve_result.hpp>
 #include <internal/container.hpp>
+#include <internal/value_hash.hpp>
 #include <algorithm>
-#include <unordered_set>
 #include <boost/algorithm/string.hpp>
 #include <internal/tokens.hpp>
 #include <leatherman/locale/locale.hpp>
@@ -19,47 +19,32 @@ using namespace std;
 
 namespace hocon {
 
+    // Resolves every child; restricted resolves look up their one child instead
     struct simple_config_object::resolve_modifier : public modifier {
         resolve_modifier(resolve_context c, resolve_source s)
-                : context(move(c)), source(move(s)), original_restrict(context.restrict_to_child()) {}
+                : context(move(c)), source(move(s)) {}
 
         shared_value modify_child_may_throw(string const& key, shared_value v) override
         {
-            if (context.is_restricted_to_child()) {
-                if (key == *context.restrict_to_child().first()) {
-                    auto remainder = context.restrict_to_child().remainder();
-
-                    if (!remainder.empty()) {
-                        auto result = context.restrict(remainder).resolve(v, source);
-                        context = result.context.unrestricted().restrict(original_restrict);
-                        return result.value;
-                    } else {
-                        return v;
-                    }
-                } else {
-                    return v;
-                }
-            } else {
-                auto result = context.unrestricted().resolve(v, source);
-                context = result.context.unrestricted().restrict(original_restrict);
-                return result.value;
-            }
+            auto result = context.resolve(v, source);
+            context = result.context.unrestricted();
+            return result.value;
         }
 
         resolve_context context;
         resolve_source source;
-        path original_restrict;
     };
 
     simple_config_object::simple_config_object(shared_origin origin,
-                                               unordered_map <std::string, shared_value> value,
+                                               persistent_map value,
                                                resolve_status status, bool ignores_fallbacks) :
-        config_object(move(origin)), _value(move(value)), _resolved(status), _ignores_fallbacks(ignores_fallbacks)
+        config_object(move(origin)), _value(move(value)), _size(_value.size()), _built_on_use(false),
+        _resolved(status), _ignores_fallbacks(ignores_fallbacks)
     {}
 
     simple_config_object::simple_config_object(shared_origin origin,
-                                               unordered_map <std::string, shared_value> value)
-         : config_object(move(origin)) {
+                                               persistent_map value)
+         : config_object(move(origin)), _size(value.size()), _built_on_use(false) {
         // These are in the body so I can call resolve_from_status
         // then move the value hash in a well-defined order.
         _resolved = resolve_status_from_value(value);
@@ -67,31 +52,66 @@ namespace hocon {
         _ignores_fallbacks = false;
     }
 
+    simple_config_object::simple_config_object(shared_origin origin, shared_ptr<const packed_object> packed)
+         : config_object(move(origin)), _packed(move(packed)), _size(_packed->size()), _built_on_use(true),
+           _resolved(_packed->get_resolve_status()), _ignores_fallbacks(false) { }
+
+    shared_ptr<const simple_config_object> simple_config_object::new_literal(
+            shared_origin origin, unordered_map<string, shared_value> const& fields)
+    {
+        if (auto packed = packed_object::pack(fields)) {
+            return make_shared<simple_config_object>(move(origin), move(packed));
+        }
+        return make_shared<simple_config_object>(move(origin), persistent_map(fields));
+    }
+
+    persistent_map const& simple_config_object::entries() const {
+        if (_built_on_use) {
+            call_once(_built, [this]() {
+                _value = atomic_load(&_packed)->unpack();
+                // The map holds all the packed fields did, so keeping both would hold the object twice
+                atomic_store(&_packed, shared_ptr<const packed_object>());
+            });
+        }
+        return _value;
+    }
+
     shared_value simple_config_object::attempt_peek_with_partial_resolve(std::string const& key) const {
-        auto iter = _value.find(key);
-        if (iter != _value.end()) {
+        auto const& fields = entries();
+        auto iter = fields.find(key);
+        if (iter != fields.end()) {
             return iter->second;
         } else {
             return nullptr;
         }
     }
 
-    unordered_map<string, shared_value> const& simple_config_object::entry_set() const {
-        return _value;
+    shared_value simple_config_object::attempt_peek_with_partial_resolve(symbol const& key) const {
+        auto const& fields = entries();
+        auto iter = fields.find(key);
+        if (iter != fields.end()) {
+            return iter->second;
+        } else {
+            return nullptr;
+        }
+    }
+
+    persistent_map const& simple_config_object::entry_set() const {
+        return entries();
     }
 
     shared_object simple_config_object::with_value(path raw_path, shared_value value) const {
-        string key = *raw_path.first();
+        auto first = raw_path.first();
+        string const& key = *first;
         path next = raw_path.remainder();
 
         if (next.empty()) {
             return with_value(key, value);
         } else {
-            if (_value.find(key) != _value.end()) {
-                shared_value child = _value.at(key);
-                if (dynamic_pointer_cast<const config_object>(child)) {
+            if (shared_value child = entries().get(key)) {
+                if (auto object = dynamic_pointer_cast<const config_object>(child)) {
                     // if we have an object, add to it
-                    return with_value(key, dynamic_pointer_cast<const config_object>(child))->with_value(next, value);
+                    return with_value(key, object->with_value(next, value));
                 }
             }
             // as soon as we have a non-object, replace it entirely
@@ -102,27 +122,24 @@ namespace hocon {
     }
 
     shared_object simple_config_object::without_path(path raw_path) const {
-        string key = *raw_path.first();
+        auto first = raw_path.first();
+        string const& key = *first;
         path next = raw_path.remainder();
-        auto v = _value.find(key);
+        auto const& fields = entries();
+        auto v = fields.find(key);
 
-        auto object = v != _value.end() ? dynamic_pointer_cast<const config_object>((*v).second) : nullptr;
+        auto object = v != fields.end() ? dynamic_pointer_cast<const config_object>((*v).second) : nullptr;
         if (object && !next.empty()) {
             auto value = object->without_path(next);
-            unordered_map<string, shared_value> updated { make_pair(key, value) };
+            auto updated = fields.set(key, value);
             return make_shared<simple_config_object>(origin(),
                                                      updated,
                                                      resolve_status_from_values(value_set(updated)),
                                                      _ignores_fallbacks);
-        } else if (!next.empty() || v == _value.end()) {
+        } else if (!next.empty() || v == fields.end()) {
             return dynamic_pointer_cast<const config_object>(shared_from_this());
         } else {
-            unordered_map<string, shared_value> smaller;
-            for (auto&& old : _value) {
-                if (old.first != key) {
-                    smaller.emplace(old);
-                }
-            }
+            auto smaller = fields.erase(key);
             return make_shared<simple_config_object>(origin(),
                                                      smaller,
                                                      resolve_status_from_values(value_set(smaller)),
@@ -133,7 +150,7 @@ namespace hocon {
     shared_object simple_config_object::with_only_path(path raw_path) const {
         shared_object o = with_only_path_or_null(raw_path);
         if (!o) {
-            return make_shared<simple_config_object>(origin(), unordered_map<string, shared_value> { },
+            return make_shared<simple_config_object>(origin(), persistent_map(),
                                                      resolve_status::RESOLVED, _ignores_fallbacks);
         } else {
             return o;
@@ -141,13 +158,15 @@ namespace hocon {
     }
 
     shared_object simple_config_object::with_only_path_or_null(path raw_path) const {
-        string key = *raw_path.first();
+        auto first = raw_path.first();
+        string const& key = *first;
         path next = raw_path.remainder();
-        auto v = _value.find(key);
+        auto const& fields = entries();
+        auto v = fields.find(key);
 
         shared_object o;
         if (!next.empty()) {
-            auto object = v != _value.end() ? dynamic_pointer_cast<const config_object>((*v).second) : nullptr;
+            auto object = v != fields.end() ? dynamic_pointer_cast<const config_object>((*v).second) : nullptr;
             o = object->with_only_path_or_null(next);
         }
 
@@ -155,7 +174,7 @@ namespace hocon {
             return nullptr;
         } else {
             return make_shared<simple_config_object>(origin(),
-                                                     unordered_map<string, shared_value> { make_pair(key, o) },
+                                                     persistent_map().set(key, o),
                                                      o->get_resolve_status(), _ignores_fallbacks);
         }
     }
@@ -165,42 +184,54 @@ namespace hocon {
             throw config_exception(_("Trying to store null config_value in a config_object"));
         }
 
-        unordered_map<string, shared_value> new_map;
-        if (_value.empty()) {
-            new_map.emplace(key, value);
-        } else {
-            new_map = _value;
-            new_map.emplace(key, value);
-        }
-
-        return make_shared<simple_config_object>(origin(), new_map, _resolved, _ignores_fallbacks);
+        // Only the trie nodes on the path to key are copied; the rest are shared with this object
+        auto const& fields = entries();
+        auto replaced = fields.get(key);
+        auto updated = fields.set(key, value);
+        auto status = updated_resolve_status(_resolved,
+                                             value->get_resolve_status() == resolve_status::UNRESOLVED,
+                                             replaced && replaced->get_resolve_status() == resolve_status::UNRESOLVED,
+                                             updated);
+        return make_shared<simple_config_object>(origin(), move(updated), status, _ignores_fallbacks);
     }
 
     shared_value simple_config_object::new_copy(shared_origin origin) const {
-        return make_shared<simple_config_object>(move(origin), _value, _resolved, _ignores_fallbacks);
+        return make_shared<simple_config_object>(move(origin), entries(), _resolved, _ignores_fallbacks);
     }
 
-    unwrapped_value simple_config_object::unwrapped() const {
-        unordered_map<string, unwrapped_value> contents;
-        for (auto pair : _value) {
-            unwrapped_value v = pair.second->unwrapped();
-            contents[pair.first] = pair.second->unwrapped();
+    void simple_config_object::accept(config_value_visitor& visitor) const {
+        visitor.begin_object(size());
+        for (auto const& entry : entries()) {
+            visitor.key(entry.first);
+            entry.second->accept(visitor);
         }
-        return contents;
+        visitor.end_object();
     }
 
     bool simple_config_object::operator==(config_value const& other) const {
         return equals<simple_config_object>(other, [&](simple_config_object const& o) {
-            if (_value.size() != o._value.size()) { return false; }
+            if (this == &o) { return true; }
+            if (size() != o.size() || hash_code() != o.hash_code()) { return false; }
 
-            bool still_equal = true;
-            for (auto pair : _value) {
-                still_equal = *(o._value.at(pair.first)) == *(_value.at(pair.first));
+            for (auto const& pair : entries()) {
+                auto other_value = o.entries().get(pair.first);
+                if (!other_value || (other_value != pair.second && !(*other_value == *pair.second))) {
+                    return false;
+                }
             }
-            return still_equal;
+            return true;
         });
     }
 
+    uint64_t simple_config_object::compute_hash() const {
+        // Entries are summed, so the hash doesn't depend on the order of the map
+        uint64_t sum = 0;
+        for (auto const& entry : entries()) {
+            sum += value_hash::combine(value_hash::of_string(entry.first), entry.second->hash_code());
+        }
+        return value_hash::combine(value_hash::OBJECT, sum);
+    }
+
     resolve_result<shared_value>
     simple_config_object::resolve_substitutions(resolve_context const& context, resolve_source const& source) const
     {
@@ -210,13 +241,41 @@ namespace hocon {
 
         resolve_source source_with_parent = source.push_parent(dynamic_pointer_cast<const container>(shared_from_this()));
 
+        if (context.is_restricted_to_child()) {
+            // Only the child on the restricted path is resolved, which a lookup finds
+            // without visiting the others; this runs for every substitution looked up
+            auto restriction = context.restrict_to_child();
+            auto remainder = restriction.remainder();
+            auto key = *restriction.first();
+            auto const& fields = entries();
+            auto child = fields.get(key);
+            if (!child || remainder.empty()) {
+                return resolve_result<shared_value>(context, shared_from_this());
+            }
+
+            auto result = context.restrict(remainder).resolve(child, source_with_parent);
+            auto new_context = result.context.unrestricted().restrict(restriction);
+            if (result.value == child) {
+                return resolve_result<shared_value>(new_context, shared_from_this());
+            }
+
+            auto updated = result.value ? fields.set(key, result.value) : fields.erase(key);
+            auto status = updated_resolve_status(_resolved,
+                                                 result.value && result.value->get_resolve_status() == resolve_status::UNRESOLVED,
+                                                 child->get_resolve_status() == resolve_status::UNRESOLVED,
+                                                 updated);
+            return resolve_result<shared_value>(new_context,
+                                                make_shared<simple_config_object>(origin(), move(updated), status,
+                                                                                  _ignores_fallbacks));
+        }
+
         resolve_modifier modifier{context, move(source_with_parent)};
         auto value = modify_may_throw(modifier);
         return resolve_result<shared_value>(modifier.context, value);
     }
 
     shared_object simple_config_object::new_copy(resolve_status const &new_status, shared_origin new_origin) const {
-        return make_shared<simple_config_object>(move(new_origin), _value, move(new_status), ignores_fallbacks());
+        return make_shared<simple_config_object>(move(new_origin), entries(), move(new_status), ignores_fallbacks());
     }
 
     shared_ptr<simple_config_object> simple_config_object::modify(no_exceptions_modifier& modifier) const
@@ -228,7 +287,7 @@ namespace hocon {
     {
         unordered_map<string, shared_value> changes;
 
-        for (const auto& pair : _value) {
+        for (const auto& pair : entries()) {
             auto& k = pair.first;
             auto& v = pair.second;
             auto modified = the_modifier.modify_child_may_throw(k, v);
@@ -241,51 +300,41 @@ namespace hocon {
         if (changes.empty()) {
             return const_pointer_cast<simple_config_object>(dynamic_pointer_cast<const simple_config_object>(shared_from_this()));
         } else {
-            unordered_map<string, shared_value> modified;
-            resolve_status status = resolve_status::RESOLVED;
-
-            for (const auto& pair : _value) {
-                auto& k = pair.first;
-                auto& v = pair.second;
-
-                auto iter = changes.find(k);
-                if (iter != changes.end()) {
-                    auto& new_value = iter->second;
-
-                    if (new_value) {
-                        modified.emplace(k, new_value);
-                        if (new_value->get_resolve_status() == resolve_status::UNRESOLVED) {
-                            status = resolve_status::UNRESOLVED;
-                        }
-                    }
+            auto modified = entries();
+            for (const auto& change : changes) {
+                if (change.second) {
+                    modified = modified.set(change.first, change.second);
                 } else {
-                    modified.emplace(k, v);
-                    if (v->get_resolve_status() == resolve_status::UNRESOLVED) {
-                        status = resolve_status::UNRESOLVED;
-                    }
+                    modified = modified.erase(change.first);
                 }
             }
-            return make_shared<simple_config_object>(origin(), move(modified), status, ignores_fallbacks());
+            return make_shared<simple_config_object>(origin(), modified, resolve_status_from_value(modified),
+                                                     ignores_fallbacks());
         }
     }
 
-    resolve_status simple_config_object::resolve_status_from_value(const unordered_map<string, shared_value>& value) {
-        using pair = unordered_map<string, shared_value>::value_type;
+    resolve_status simple_config_object::resolve_status_from_value(persistent_map const& value) {
+        using pair = persistent_map::value_type;
         return any_of(value.begin(), value.end(), [](const pair& value) {
                  return value.second->get_resolve_status() == resolve_status::UNRESOLVED;
              }) ? resolve_status::UNRESOLVED : resolve_status::RESOLVED;
     }
 
-    shared_value simple_config_object::replace_child(shared_value const &child, shared_value replacement) const {
-        unordered_map<string, shared_value> new_children(_value);
+    resolve_status simple_config_object::updated_resolve_status(resolve_status base_status, bool added_unresolved,
+                                                                bool replaced_unresolved, persistent_map const& updated) {
+        if (added_unresolved) {
+            return resolve_status::UNRESOLVED;
+        } else if (base_status == resolve_status::RESOLVED || !replaced_unresolved) {
+            return base_status;
+        }
+        return resolve_status_from_value(updated);
+    }
 
-        for (auto&& old : new_children) {
+    shared_value simple_config_object::replace_child(shared_value const &child, shared_value replacement) const {
+        auto const& fields = entries();
+        for (auto const& old : fields) {
             if (old.second == child) {
-                if (replacement) {
-                    old.second = replacement;
-                } else {
-                    new_children.erase(old.first);
-                }
+                auto new_children = replacement ? fields.set(old.first, move(replacement)) : fields.erase(old.first);
 
                 auto value_list = value_set(new_children);
                 return make_shared<simple_config_object>(origin(),
@@ -298,7 +347,7 @@ namespace hocon {
     }
 
     bool simple_config_object::has_descendant(shared_value const &descendant) const {
-        auto value_list = value_set(_value);
+        auto value_list = value_set(entries());
         for (auto&& child : value_list) {
             if (child == descendant) {
                 return true;
@@ -317,13 +366,13 @@ namespace hocon {
 
     vector<string> simple_config_object::key_set() const {
         vector<string> keys;
-        for (auto const& kv : _value) {
+        for (auto const& kv : entries()) {
             keys.push_back(kv.first);
         }
         return keys;
     }
 
-    vector<shared_value> simple_config_object::value_set(unordered_map<string, shared_value> m) const {
+    vector<shared_value> simple_config_object::value_set(persistent_map const& m) const {
         vector<shared_value> values;
         for (auto const& kv : m) {
             values.push_back(kv.second);
@@ -339,7 +388,7 @@ namespace hocon {
         if (origin == nullptr) {
             return empty();
         } else {
-            return make_shared<simple_config_object>(move(origin), unordered_map<string, shared_value>());
+            return make_shared<simple_config_object>(move(origin), persistent_map());
         }
     }
 
@@ -351,7 +400,7 @@ namespace hocon {
         if (_ignores_fallbacks) {
             return shared_from_this();
         } else {
-            return make_shared<simple_config_object>(origin(), _value, _resolved, true);
+            return make_shared<simple_config_object>(origin(), entries(), _resolved, true);
         }
     }
 
@@ -361,27 +410,32 @@ namespace hocon {
             throw bug_or_broken_exception(_("should not be reached (merging non-simple_config_object)"));
         }
 
-        bool changed = false;
-        auto new_resolve_status = resolve_status::RESOLVED;
-        auto merged = unordered_map<string, shared_value>();
-        auto all_keys = [&]() {
-            auto our_keys = key_set();
-            auto fallback_keys = fallback->key_set();
-            auto all_keys = unordered_set<string>(our_keys.begin(), our_keys.end());
-            all_keys.insert(fallback_keys.begin(), fallback_keys.end());
-            return all_keys;
-        }();
-
-        for (auto const& key : all_keys) {
-            auto first = _value.find(key);
-            auto second = fallback->_value.find(key);
+        // Start from the larger of the two maps and bind the other one's entries into it,
+        // so merging a few keys into a big object doesn't copy all of its entries.
+        bool ours_is_base = size() >= fallback->size();
+        auto const& base = ours_is_base ? *this : *fallback;
+        auto const& other = ours_is_base ? *fallback : *this;
+
+        auto const& base_fields = base.entries();
+        auto merged = base_fields;
+        // a larger fallback must have keys we lack
+        bool changed = !ours_is_base;
+        bool added_unresolved = false;
+        bool replaced_unresolved = false;
+
+        for (auto const& entry : other.entries()) {
+            auto const& key = entry.first;
+            auto existing = base_fields.find(key);
+            shared_value first = ours_is_base ? (existing == base_fields.end() ? nullptr : existing->second) : entry.second;
+            shared_value second = ours_is_base ? entry.second : (existing == base_fields.end() ? nullptr : existing->second);
+
             auto kept = [&]() {
-                if (first == _value.end()) {
-                    return second->second;
-                } else if (second == fallback->_value.end()) {
-                    return first->second;
+                if (!first) {
+                    return second;
+                } else if (!second) {
+                    return first;
                 } else {
-                    const auto merge = dynamic_pointer_cast<const config_value>(first->second->with_fallback(second->second));
+                    const auto merge = dynamic_pointer_cast<const config_value>(first->with_fallback(second));
                     if (!merge) {
                         throw bug_or_broken_exception(_("Expected with_fallback to return same type of object"));
                     }
@@ -389,24 +443,31 @@ namespace hocon {
                 }
             }();
 
-            merged.insert(make_pair(key, kept));
-
-            if (first == _value.end() || first->second != kept) {
+            if (!first || first != kept) {
                 changed = true;
             }
 
+            if (existing == base_fields.end() || existing->second != kept) {
+                if (existing != base_fields.end() &&
+                    existing->second->get_resolve_status() == resolve_status::UNRESOLVED) {
+                    replaced_unresolved = true;
+                }
+                merged = merged.set(key, kept);
+            }
+
             if (kept->get_resolve_status() == resolve_status::UNRESOLVED) {
-                new_resolve_status = resolve_status::UNRESOLVED;
+                added_unresolved = true;
             }
         }
 
+        auto new_resolve_status = updated_resolve_status(base._resolved, added_unresolved, replaced_unresolved, merged);
         bool new_ignores_fallbacks = fallback->ignores_fallbacks();
 
         if (changed) {
             return make_shared<simple_config_object>(merge_origins({shared_from_this(), fallback}),
                                                      merged, new_resolve_status, new_ignores_fallbacks);
         } else if (new_resolve_status != get_resolve_status() || new_ignores_fallbacks != ignores_fallbacks()) {
-            return make_shared<simple_config_object>(origin(), _value, new_resolve_status, new_ignores_fallbacks);
+            return make_shared<simple_config_object>(origin(), entries(), new_resolve_status, new_ignores_fallbacks);
         } else {
             return shared_from_this();
         }
@@ -450,7 +511,7 @@ namespace hocon {
             sort(keys.begin(), keys.end(), compare);
             for (string const& k : keys) {
                 shared_value v;
-                v = _value.at(k);
+                v = entries().at(k);
 
                 if (options.get_origin_comments()) {
                     // split the string into a vector of keys
@@ -3,15 +3,20 @@
 #include "fixtures.hpp"
 
 #include <boost/algorithm/string/replace.hpp>
+#include <iostream>
 
 #include <hocon/config.hpp>
 #include <hocon/config_list.hpp>
 #include <hocon/config_exception.hpp>
 #include <hocon/config_parse_options.hpp>
 #include <internal/values/simple_config_object.hpp>
+#include <internal/values/simple_config_list.hpp>
 #include <internal/values/config_reference.hpp>
 #include <internal/substitution_expression.hpp>
 #include <internal/parseable.hpp>
+#include <internal/config_token_parser.hpp>
+#include <internal/json_parser.hpp>
+#include <internal/simple_include_context.hpp>
 #include <internal/resolve_context.hpp>
 #include <internal/path_parser.hpp>
 #include "test_utils.hpp"
@@ -625,6 +630,138 @@ TEST_CASE("track comments for multiple fields (pending)", "[!shouldfail]") {
     assert_comments({}, conf8, "a");
 }
 
+TEST_CASE("skip comments and line origins when not tracking origins") {
+    auto options = config_parse_options().set_track_origins(false);
+    auto conf = config::parse_string(R"(
+            # a comment
+            a = 10
+            b {
+                # b.c comment
+                c = [1, 2] # trailing comment
+            }
+            )", options);
+
+    REQUIRE(10 == conf->get_int("a"));
+    REQUIRE(vector<int> { 1, 2 } == conf->get_int_list("b.c"));
+    assert_comments({}, conf, "a");
+    assert_comments({}, conf, "b.c");
+    REQUIRE(-1 == conf->get_value("a")->origin()->line_number());
+    REQUIRE(conf->get_value("a")->origin() == conf->get_value("b.c")->origin());
+
+    try {
+        config::parse_string("a = 1\nb = {", options);
+        FAIL("expected a parse error");
+    } catch (const config_exception& e) {
+        REQUIRE_STRING_CONTAINS(e.what(), "string:");
+    }
+}
+
+static shared_value parse_with(string const& s, config_syntax syntax) {
+    auto parseable = parseable::new_string(s, config_parse_options().set_syntax(syntax));
+    auto options = parseable->options();
+    auto context = make_shared<simple_include_context>(*parseable);
+    auto origin = make_shared<simple_config_origin>("test string");
+    token_iterator tokens(origin, make_shared<input_buffer>(s.data(), s.data() + s.size()), syntax);
+    return config_token_parser::parse(move(tokens), origin, options, context);
+}
+
+static void require_same_origins(shared_value const& a, shared_value const& b) {
+    REQUIRE(a->origin()->line_number() == b->origin()->line_number());
+    REQUIRE(a->origin()->comments() == b->origin()->comments());
+    if (auto obj = dynamic_pointer_cast<const simple_config_object>(a)) {
+        auto other = dynamic_pointer_cast<const simple_config_object>(b);
+        REQUIRE(other);
+        for (auto const& pair : *obj) {
+            CAPTURE(pair.first);
+            require_same_origins(pair.second, other->get(pair.first));
+        }
+    } else if (auto list = dynamic_pointer_cast<const simple_config_list>(a)) {
+        auto other = dynamic_pointer_cast<const simple_config_list>(b);
+        REQUIRE(other);
+        for (size_t i = 0; i < list->size(); ++i) {
+            require_same_origins(list->get(i), other->get(i));
+        }
+    }
+}
+
+TEST_CASE("token parser attaches comments and line numbers") {
+    auto conf = config::parse_string(R"(
+        # leading comment
+
+        # a's comment
+        a = [1] # trailing a
+        a += 2, b = { x = ${a} } {
+          // inside b
+          c : [ 1 # one
+                2, { d = 3 } ] # after list
+        }
+        e.f.g = 4 x y
+        e { h = 5 },
+        )")->resolve();
+
+    REQUIRE(vector<int> { 1, 2 } == conf->get_int_list("a"));
+    REQUIRE(vector<int> { 1, 2 } == conf->get_int_list("b.x"));
+    REQUIRE(3u == conf->get_list("b.c")->size());
+    REQUIRE("4 x y" == conf->get_string("e.f.g"));
+    REQUIRE(5 == conf->get_int("e.h"));
+
+    REQUIRE(8 == conf->get_value("b.c")->origin()->line_number());
+    REQUIRE(11 == conf->get_value("e.f.g")->origin()->line_number());
+    REQUIRE(12 == conf->get_value("e.h")->origin()->line_number());
+    assert_comments({ " inside b", " after list" }, conf, "b.c");
+    assert_comments({}, conf, "e.h");
+}
+
+TEST_CASE("strict JSON parser matches the token parser") {
+    // Returns whether the strict parser handled the text itself
+    auto check = [](string const& text) {
+        CAPTURE(text);
+        auto origin = make_shared<simple_config_origin>("test string");
+        auto fast = json_parser::parse(input_buffer(text.data(), text.data() + text.size()), origin);
+        if (!fast) {
+            return false;
+        }
+        auto general = parse_with(text, config_syntax::JSON);
+        REQUIRE(*general == *fast);
+        REQUIRE(general->render() == fast->render());
+        require_same_origins(general, fast);
+        return true;
+    };
+
+    for (auto const& json : valid_json()) {
+        check(json.test);
+    }
+    for (auto const& invalid : invalid_json()) {
+        CAPTURE(invalid.test);
+        REQUIRE_FALSE(check(invalid.test));
+    }
+
+    REQUIRE(check(R"(
+        {
+          "a" : 1, "b": -2.5e3, "c" : [true, false, null, 0, -0.0, 12345678901234],
+          "d"
+            :
+            { "e.f" : "x\"y\\z\n\u00e9\/", "" : [] },
+          "g" : [
+            {},
+            [ "h" ]
+          ]
+        }
+        )"));
+    REQUIRE(check("[]"));
+    REQUIRE(check("{ \"caf\xc3\xa9\" : \"\xe2\x82\xac \xf0\x9f\x98\x80\" }"));
+    REQUIRE(check("\r\n\t[1]\r\n"));
+
+    // Left to the tokenizer
+    REQUIRE_FALSE(check("{ \"a\" : 1, \"a\" : 2 }"));
+    REQUIRE_FALSE(check("[ \"\"\"a\"\"\" ]"));
+    REQUIRE_FALSE(check("[ 01 ]"));
+    REQUIRE_FALSE(check("[ 99999999999999999999 ]"));
+    REQUIRE_FALSE(check("[ 1, ]"));
+    REQUIRE_FALSE(check("[ truex ]"));
+    REQUIRE_FALSE(check("\xef\xbb\xbf[]"));
+}
+
 TEST_CASE("include file") {
     auto conf = config::parse_string("include file(\"" + fixture_path("test01") + "\")");
 
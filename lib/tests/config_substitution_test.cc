@@ -11,6 +11,7 @@
 #include <internal/values/config_delayed_merge_object.hpp>
 #include <internal/values/config_delayed_merge.hpp>
 #include <leatherman/util/environment.hpp>
+#include <thread>
 #include <unordered_map>
 
 using namespace std;
@@ -369,7 +370,7 @@ TEST_CASE("avoid delayed merge object resolve problem 2") {
 
 }
 
-TEST_CASE("(pending HC-78) avoid delayed merge object resolve problem 3", "[!shouldfail]") {
+TEST_CASE("avoid delayed merge object resolve problem 3") {
     auto problem = parse_object(R"(
   item1.b.c = 100
   defaults {
@@ -418,7 +419,7 @@ TEST_CASE("avoid delayed merge object resolve problem 4") {
     REQUIRE(2 == resolved->get_int("item2.b"));
 }
 
-TEST_CASE("(pending HC-78) avoid delayed merge object resolve problem 5", "[!shouldfail]") {
+TEST_CASE("avoid delayed merge object resolve problem 5") {
     auto problem = parse_object(R"(
   defaults {
     a = ${item1.b} // tricky cycle - we won't see ${defaults}
@@ -891,3 +892,216 @@ TEST_CASE("subst self references (pending)", "[!shouldfail]") {
         REQUIRE("1xyz" == resolved->get_string("a"));
     }
 }
+
+TEST_CASE("resolving on several threads matches resolving on one") {
+    // Enough substitutions that the resolve runs in parallel, depending on each other
+    // in chains, across merges and through self-references
+    string text;
+    for (int i = 0; i < 100; ++i) {
+        auto n = to_string(i);
+        text += "base" + n + " = { x = " + n + ", y = s" + n + " }\n";
+        text += "derived" + n + " = ${base" + n + "} { z = ${chain" + n + "} }\n";
+        text += i == 0 ? "chain0 = c\n" : "chain" + n + " = ${chain" + to_string(i - 1) + "}-" + n + "\n";
+        text += "path" + n + " = [a], path" + n + " = ${path" + n + "} [b]\n";
+        text += "self" + n + " = v, self" + n + " = ${self" + n + "}w\n";
+        text += "nested" + n + " { a = ${base" + n + ".x}, b = ${?missing}, c = ${nested" + n + ".a} }\n";
+    }
+    auto conf = config::parse_string(text);
+    auto parallel = config_resolve_options().set_threads(4);
+
+    auto expected = conf->resolve();
+    auto resolved = conf->resolve(parallel);
+    REQUIRE(*expected == *resolved);
+    REQUIRE("c-1-2" == resolved->get_string("derived2.z"));
+    REQUIRE("vw" == resolved->get_string("self99"));
+    REQUIRE_FALSE(resolved->has_path("nested5.b"));
+
+    SECTION("and fails the same way") {
+        auto message = [](shared_config const& broken, config_resolve_options options) {
+            try {
+                broken->resolve(options);
+            } catch (config_exception& e) {
+                return string(e.what());
+            }
+            return string();
+        };
+
+        auto broken = config::parse_string(text + "broken = ${nothing}\n");
+        REQUIRE_THROWS_AS(broken->resolve(parallel), config_exception);
+        REQUIRE(message(broken, config_resolve_options()) == message(broken, parallel));
+
+        auto cycle = config::parse_string(text + "c1 = ${c2}, c2 = ${c1}\n");
+        REQUIRE_THROWS_AS(cycle->resolve(parallel), config_exception);
+    }
+}
+
+TEST_CASE("incremental resolves match full resolves") {
+    auto source = config::parse_string(R"(
+        defaults { host = localhost, port = 80 }
+        db = ${defaults} { name = main }
+        url = "http://"${db.host}":"${db.port}/${db.name}
+        path = [a], path = ${path} [b]
+        unrelated { a = 1, b = ${unrelated.a} }
+        mirror = ${?override}
+        nested { deep { port = ${defaults.port} } }
+    )");
+    auto previous = source->resolve(config_resolve_options().set_incremental(true));
+    REQUIRE(*source->resolve() == *previous);
+
+    auto check = [&](shared_config const& edited) {
+        auto updated = edited->resolve_incrementally(previous);
+        REQUIRE(*edited->resolve() == *updated);
+        return updated;
+    };
+
+    SECTION("overriding a value resolves what depends on it and shares the rest") {
+        auto updated = check(source->with_value("defaults.host", string_value("db.example")));
+        REQUIRE("http://db.example:80/main" == updated->get_string("url"));
+        REQUIRE(previous->get_value("unrelated") == updated->get_value("unrelated"));
+        REQUIRE(previous->get_value("path") == updated->get_value("path"));
+    }
+
+    SECTION("edits that add, replace and remove substitutions") {
+        auto updated = check(source->with_value("override", subst("unrelated.b")));
+        REQUIRE(1 == updated->get_int("mirror"));
+        updated = check(source->with_value("defaults.port", subst("unrelated.a")));
+        REQUIRE(1 == updated->get_int("nested.deep.port"));
+        updated = check(source->without_path("nested.deep"));
+        REQUIRE_FALSE(updated->has_path("nested.deep"));
+        auto fallback = config::parse_string("extra = ${defaults.host}, override = 5");
+        updated = check(dynamic_pointer_cast<const config>(source->with_fallback(fallback)));
+        REQUIRE(5 == updated->get_int("mirror"));
+    }
+
+    SECTION("a chain of edits builds on each result") {
+        for (int i = 0; i < 20; ++i) {
+            auto edited = (i % 2 ? source->with_value("defaults.port", int_value(i))
+                                 : source->with_value("unrelated.a", int_value(i)));
+            previous = check(edited);
+            source = edited;
+        }
+        REQUIRE(19 == previous->get_int("db.port"));
+        REQUIRE(18 == previous->get_int("unrelated.b"));
+    }
+
+    SECTION("errors are those of a full resolve") {
+        REQUIRE_THROWS_AS(source->with_value("defaults.host", subst("missing"))->resolve_incrementally(previous),
+                          config_exception);
+    }
+
+    SECTION("environment variables that changed are looked up again") {
+        scoped_env_var variable("HOCON_TEST_INCREMENTAL", "first");
+        auto with_env = config::parse_string("a = ${HOCON_TEST_INCREMENTAL}, b = ${a}, c = 1, d = ${c}");
+        auto first = with_env->resolve(config_resolve_options().set_incremental(true));
+        REQUIRE("first" == first->get_string("b"));
+
+        variable.set("second");
+        auto edited = with_env->with_value("c", int_value(2));
+        auto second = edited->resolve_incrementally(first);
+        REQUIRE("second" == second->get_string("a"));
+        REQUIRE("second" == second->get_string("b"));
+        REQUIRE(2 == second->get_int("d"));
+
+        variable.set("third");
+        auto third = edited->resolve_incrementally(second);
+        REQUIRE("third" == third->get_string("b"));
+        REQUIRE(*edited->resolve() == *third);
+        REQUIRE(third->get_value("d") == second->get_value("d"));
+    }
+}
+
+TEST_CASE("lazy resolves resolve only what is read") {
+    string text = R"(
+        defaults { host = localhost, port = 80 }
+        db = ${defaults} { name = main }
+        url = "http://"${db.host}":"${db.port}/${db.name}
+        path = [a], path = ${path} [b]
+        self = v, self = ${self}w
+        mirror = ${?override}
+        list = [${defaults.port}, ${db.name}]
+    )";
+    auto source = config::parse_string(text + "broken { a = ${nothing}, b = 2 }\n");
+    auto lazy = source->resolve(config_resolve_options().set_lazy(true));
+    auto expected = config::parse_string(text)->resolve();
+    vector<string> paths { "defaults", "db", "db.port", "url", "path", "self", "list" };
+
+    SECTION("getters return what a full resolve would") {
+        for (auto const& p : paths) {
+            REQUIRE(*expected->get_value(p) == *lazy->get_value(p));
+        }
+        REQUIRE("http://localhost:80/main" == lazy->get_string("url"));
+        REQUIRE(lazy->has_path("db.name"));
+        REQUIRE_FALSE(lazy->has_path("mirror"));
+        REQUIRE_FALSE(lazy->has_path("db.missing"));
+        REQUIRE_THROWS_AS(lazy->get_int("url"), config_exception);
+        REQUIRE_THROWS_AS(lazy->get_string("url.host"), config_exception);
+    }
+
+    SECTION("unresolvable values are errors only when read") {
+        REQUIRE(2 == lazy->get_int("broken.b"));
+        REQUIRE_THROWS_AS(lazy->get_string("broken.a"), config_exception);
+        REQUIRE_THROWS_AS(lazy->root(), config_exception);
+        REQUIRE("http://localhost:80/main" == lazy->get_string("url"));
+    }
+
+    SECTION("reads may run on several threads") {
+        vector<thread> readers;
+        vector<int> matched(4, 1);
+        for (size_t t = 0; t < matched.size(); ++t) {
+            readers.emplace_back([&, t]() {
+                for (int round = 0; round < 20; ++round) {
+                    for (auto const& p : paths) {
+                        if (!(*expected->get_value(p) == *lazy->get_value(p))) {
+                            matched[t] = 0;
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        REQUIRE(vector<int>(4, 1) == matched);
+    }
+
+    SECTION("whole-config operations resolve the whole config") {
+        auto whole = config::parse_string(text)->resolve(config_resolve_options().set_lazy(true));
+        REQUIRE_FALSE(whole->is_resolved());
+        REQUIRE(*expected == *whole);
+        REQUIRE(whole->is_resolved());
+        REQUIRE(81 == whole->with_value("db.port", int_value(81))->get_int("db.port"));
+        REQUIRE(*expected == *whole->freeze());
+    }
+
+    SECTION("checking the status resolves nothing") {
+        REQUIRE_FALSE(lazy->is_resolved());
+        REQUIRE_THROWS_AS(lazy->has_path("broken.a"), config_exception);
+        REQUIRE_THROWS_AS(lazy->freeze(), config_exception);
+        REQUIRE_THROWS_AS(lazy->deduplicated(), config_exception);
+        REQUIRE_FALSE(lazy->is_resolved());
+    }
+
+    SECTION("resolving again uses the new options") {
+        REQUIRE_THROWS_AS(lazy->resolve(), config_exception);
+        auto partial = lazy->resolve(config_resolve_options().set_allow_unresolved(true));
+        REQUIRE_FALSE(partial->is_resolved());
+        REQUIRE(2 == partial->get_int("broken.b"));
+
+        auto whole = config::parse_string(text)->resolve(config_resolve_options().set_lazy(true));
+        auto previous = whole->resolve(config_resolve_options().set_incremental(true));
+        REQUIRE(*expected == *previous);
+        auto edited = config::parse_string(text)->with_value("defaults.port", int_value(81));
+        REQUIRE(81 == edited->resolve_incrementally(previous)->get_int("db.port"));
+    }
+}
+
+TEST_CASE("a resolve reads the environment once") {
+    string text = "a = ${HOCON_TEST_SNAPSHOT}, b = ${HOCON_TEST_SNAPSHOT}";
+    scoped_env_var snapshot("HOCON_TEST_SNAPSHOT", "before");
+    auto lazy = config::parse_string(text)->resolve(config_resolve_options().set_lazy(true));
+    REQUIRE("before" == lazy->get_string("a"));
+
+    snapshot.set("after");
+    REQUIRE("before" == lazy->get_string("b"));
+    REQUIRE("after" == config::parse_string(text)->resolve()->get_string("b"));
+}
@@ -1,9 +1,18 @@
 #include <catch.hpp>
 
 #include <hocon/config.hpp>
+#include <hocon/config_parse_options.hpp>
+#include <hocon/config_value_factory.hpp>
+#include <internal/perfect_hash.hpp>
+#include <internal/values/config_string.hpp>
+#include <internal/values/simple_config_list.hpp>
+#include <internal/values/simple_config_object.hpp>
 #include "fixtures.hpp"
 #include "test_utils.hpp"
 
+#include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
+
 using namespace std;
 using namespace hocon;
 using namespace hocon::test_utils;
@@ -51,6 +60,244 @@ TEST_CASE("should be able to get bare C++ types from a config", "[config]") {
     };
 }
 
+TEST_CASE("getters accept compiled paths", "[config]") {
+    auto conf = config::parse_file_any_syntax(TEST_FILE_DIR + string("/fixtures/test01.conf"))->resolve();
+
+    SECTION("compiled paths get the same values as path expressions") {
+        auto forty_two = config::compile_path("ints.fortyTwo");
+        REQUIRE("ints.fortyTwo" == forty_two.expression());
+        REQUIRE(path::new_path("ints.fortyTwo") == forty_two.get_path());
+
+        REQUIRE(42 == conf->get_int(forty_two));
+        REQUIRE(42 == conf->get_long(forty_two));
+        REQUIRE(42.1 == conf->get_double(config::compile_path("floats.fortyTwoPointOne")));
+        REQUIRE("abcd" == conf->get_string(config::compile_path("strings.abcd")));
+        REQUIRE(true == conf->get_bool(config::compile_path("booleans.trueAgain")));
+        REQUIRE(conf->get_value(forty_two) == conf->get_value("ints.fortyTwo"));
+        REQUIRE(conf->get_object(config::compile_path("ints")) == conf->get_object("ints"));
+        REQUIRE(42 == conf->get_config(config::compile_path("ints"))->get_int(config::compile_path("fortyTwo")));
+        REQUIRE(1000 == conf->get_duration(config::compile_path("durations.second"), time_unit::MILLISECONDS));
+
+        REQUIRE(vector<int> { 1, 2, 3 } == conf->get_int_list(config::compile_path("arrays.ofInt")));
+        REQUIRE(vector<int64_t> { 1, 2, 3 } == conf->get_long_list(config::compile_path("arrays.ofInt")));
+        REQUIRE(vector<string> { "a", "b", "c" } == conf->get_string_list(config::compile_path("arrays.ofString")));
+        REQUIRE(3 == conf->get_object_list(config::compile_path("arrays.ofObject")).size());
+    }
+
+    SECTION("compiled paths can be used with any config") {
+        auto key = config::compile_path("a.b");
+        REQUIRE(1 == config::parse_string("a.b = 1")->get_int(key));
+        REQUIRE(2 == config::parse_string("a { b = 2 }")->get_int(key));
+    }
+
+    SECTION("has_path and get_is_null take compiled paths") {
+        REQUIRE(conf->has_path(config::compile_path("ints.fortyTwo")));
+        REQUIRE_FALSE(conf->has_path(config::compile_path("ints.fortyThree")));
+        REQUIRE_FALSE(conf->has_path(config::compile_path("nulls.null")));
+        REQUIRE(conf->has_path_or_null(config::compile_path("nulls.null")));
+        REQUIRE(conf->get_is_null(config::compile_path("nulls.null")));
+        REQUIRE_FALSE(conf->get_is_null(config::compile_path("ints.fortyTwo")));
+    }
+
+    SECTION("compiled paths throw the same exceptions as path expressions") {
+        REQUIRE_THROWS_AS(config::compile_path(".."), config_exception);
+        REQUIRE_THROWS_AS(conf->get_int(config::compile_path("badSetting")), config_exception);
+        REQUIRE_THROWS_AS(conf->get_int(config::compile_path("nulls.null")), null_exception);
+        REQUIRE_THROWS_AS(conf->get_string(config::compile_path("ints")), config_exception);
+    }
+}
+
+TEST_CASE("perfect_hash gives each value its own slot", "[config]") {
+    for (size_t count : { 0, 1, 2, 3, 10, 1000, 20000 }) {
+        vector<size_t> hashes;
+        for (size_t i = 0; i < count; ++i) {
+            hashes.push_back(std::hash<string>()("key" + to_string(i)));
+        }
+        perfect_hash table;
+        REQUIRE(table.build(hashes));
+        REQUIRE(count == table.size());
+        vector<bool> used(count, false);
+        for (size_t h : hashes) {
+            size_t slot = table.slot(h);
+            REQUIRE(slot < count);
+            REQUIRE_FALSE(used[slot]);
+            used[slot] = true;
+        }
+    }
+
+    perfect_hash table;
+    REQUIRE_FALSE(table.build({ 1, 2, 1 }));
+    REQUIRE(0 == table.size());
+}
+
+TEST_CASE("frozen configs", "[config]") {
+    auto conf = config::parse_file_any_syntax(TEST_FILE_DIR + string("/fixtures/test01.conf"))->resolve();
+    auto frozen = conf->freeze();
+    REQUIRE_FALSE(conf->is_frozen());
+    REQUIRE(frozen->is_frozen());
+    REQUIRE(frozen->root() == conf->root());
+
+    SECTION("return the same values as the tree") {
+        for (auto const& entry : conf->entry_set()) {
+            REQUIRE(frozen->get_value(entry.first) == entry.second);
+            REQUIRE(frozen->get_value(config::compile_path(entry.first)) == entry.second);
+            REQUIRE(frozen->has_path(entry.first));
+        }
+        REQUIRE(42 == frozen->get_int("ints.fortyTwo"));
+        REQUIRE(42 == frozen->get_int("ints.\"fortyTwo\""));
+        REQUIRE(42 == frozen->get_int("\"ints\".fortyTwo"));
+        REQUIRE("abcd" == frozen->get_string("strings.abcd"));
+        REQUIRE(vector<int> { 1, 2, 3 } == frozen->get_int_list("arrays.ofInt"));
+        REQUIRE(frozen->get_object("ints") == conf->get_object("ints"));
+        REQUIRE(1000 == frozen->get_duration("durations.second", time_unit::MILLISECONDS));
+    }
+
+    SECTION("convert values like the tree") {
+        auto converted = config::parse_string("a { n = \"42\", b = \"yes\", x = null }")->freeze();
+        REQUIRE(42 == converted->get_int("a.n"));
+        REQUIRE(converted->get_bool("a.b"));
+        REQUIRE(converted->get_is_null("a.x"));
+        REQUIRE_FALSE(converted->has_path("a.x"));
+        REQUIRE(converted->has_path_or_null("a.x"));
+    }
+
+    SECTION("throw the same exceptions as the tree") {
+        auto message = [](function<void()> get) -> string {
+            try {
+                get();
+            } catch (const config_exception& e) {
+                return e.what();
+            }
+            return "";
+        };
+        for (auto const& c : { conf, frozen }) {
+            REQUIRE_STRING_CONTAINS(message([&]() { c->get_int("badSetting"); }), "No configuration setting found for key 'badSetting'");
+            REQUIRE_STRING_CONTAINS(message([&]() { c->get_int("ints.fortyTwo.more"); }), "ints.fortyTwo");
+            REQUIRE_STRING_CONTAINS(message([&]() { c->get_string("ints"); }), "ints could not be converted");
+            REQUIRE_THROWS_AS(c->get_int("nulls.null"), null_exception);
+            REQUIRE_FALSE(c->has_path("ints.fortyThree"));
+        }
+    }
+
+    SECTION("configs derived from a frozen config are not frozen") {
+        REQUIRE(frozen->freeze()->is_frozen());
+        REQUIRE_FALSE(frozen->get_config("ints")->is_frozen());
+        REQUIRE_FALSE(frozen->with_value("ints.more", frozen->get_value("ints.fortyTwo"))->is_frozen());
+    }
+
+    SECTION("only resolved configs can be frozen") {
+        REQUIRE_THROWS_AS(config::parse_string("a : b\nc : ${a}")->freeze(), config_exception);
+    }
+}
+
+TEST_CASE("parsed lists of scalars are packed", "[config]") {
+    auto packed_kind = [](shared_config const& c, string const& path) {
+        auto list = dynamic_pointer_cast<const simple_config_list>(c->get_list(path));
+        REQUIRE(list);
+        REQUIRE(list->packed());
+        return list->packed()->element_kind();
+    };
+    auto is_packed = [](shared_config const& c, string const& path) {
+        auto list = dynamic_pointer_cast<const simple_config_list>(c->get_list(path));
+        return list && list->packed();
+    };
+
+    for (auto syntax : { config_syntax::CONF, config_syntax::JSON }) {
+        auto conf = config::parse_string(
+            "{ \"ints\" : [1, 2, 3], \"longs\" : [1, 3000000000], \"doubles\" : [1.5, -0.25],\n"
+            "  \"bools\" : [true, false, true], \"mixed\" : [1, 2.5], \"texts\" : [1e3, 2.50],\n"
+            "  \"strings\" : [1, \"a\"], \"lines\" : [\n 4,\n 5\n] }",
+            config_parse_options().set_syntax(syntax));
+
+        REQUIRE(packed_list::kind::INT == packed_kind(conf, "ints"));
+        REQUIRE(packed_list::kind::LONG == packed_kind(conf, "longs"));
+        REQUIRE(packed_list::kind::DOUBLE == packed_kind(conf, "doubles"));
+        REQUIRE(packed_list::kind::BOOLEAN == packed_kind(conf, "bools"));
+        REQUIRE(packed_list::kind::INT == packed_kind(conf, "lines"));
+        REQUIRE(packed_list::kind::NUMBER == packed_kind(conf, "mixed"));
+        REQUIRE(packed_list::kind::NUMBER == packed_kind(conf, "texts"));
+        REQUIRE_FALSE(is_packed(conf, "strings"));
+
+        REQUIRE((vector<int> { 1, 2, 3 }) == conf->get_int_list("ints"));
+        REQUIRE((vector<int64_t> { 1, 2, 3 }) == conf->get_long_list("ints"));
+        REQUIRE((vector<int64_t> { 1, 3000000000 }) == conf->get_long_list("longs"));
+        REQUIRE((vector<double> { 1.5, -0.25 }) == conf->get_double_list("doubles"));
+        REQUIRE((vector<bool> { true, false, true }) == conf->get_bool_list("bools"));
+        REQUIRE_THROWS_AS(conf->get_int_list("longs"), config_exception);
+        REQUIRE_THROWS_AS(conf->get_double_list("ints"), config_exception);
+        REQUIRE_THROWS_AS(conf->get_bool_list("doubles"), config_exception);
+        REQUIRE_THROWS_AS(conf->get_double_list("mixed"), config_exception);
+        REQUIRE((vector<int64_t> { 1000 }) == config::parse_string("a = [1e3]")->get_long_list("a"));
+
+        // Elements are created on demand, as they were parsed
+        auto longs = conf->get_list("longs");
+        REQUIRE(config_value::type::NUMBER == longs->get(1)->value_type());
+        REQUIRE(boost::get<int>(longs->get(0)->unwrapped()) == 1);
+        REQUIRE(boost::get<int64_t>(longs->get(1)->unwrapped()) == 3000000000);
+        REQUIRE(boost::get<int64_t>(boost::get<vector<unwrapped_value>>(longs->unwrapped())[1]) == 3000000000);
+        REQUIRE("[1.5,-0.25]" == conf->get_list("doubles")->render(config_render_options::concise()));
+        REQUIRE("[true,false,true]" == conf->get_list("bools")->render(config_render_options::concise()));
+        REQUIRE("[1e3,2.50]" == conf->get_list("texts")->render(config_render_options::concise()));
+        REQUIRE(boost::get<int>(conf->get_list("texts")->get(0)->unwrapped()) == 1000);
+        REQUIRE(boost::get<double>(boost::get<vector<unwrapped_value>>(conf->get_list("mixed")->unwrapped())[1]) == 2.5);
+        REQUIRE(4 == conf->get_list("lines")->get(0)->origin()->line_number());
+        REQUIRE(5 == conf->get_list("lines")->get(1)->origin()->line_number());
+        REQUIRE(*conf->get_list("ints") == *config::parse_string("a = [1, 2, 3]")->get_list("a"));
+
+        // Once built, the elements replace the packed values, and copies share them
+        auto bools = dynamic_pointer_cast<const simple_config_list>(conf->get_list("bools"));
+        REQUIRE_FALSE(bools->packed());
+        auto moved = bools->with_origin(fake_origin("moved"));
+        REQUIRE_FALSE(dynamic_pointer_cast<const simple_config_list>(moved)->packed());
+        REQUIRE(bools->get(1) == dynamic_pointer_cast<const config_list>(moved)->get(1));
+        REQUIRE((vector<bool> { true, false, true }) == conf->get_bool_list("bools"));
+    }
+}
+
+TEST_CASE("parsed objects hold their scalar fields packed", "[config]") {
+    for (auto syntax : { config_syntax::CONF, config_syntax::JSON }) {
+        auto text = "{ \"server\" : { \"host\" : \"example.com\", \"port\" : 8080, \"big\" : 3000000000,\n"
+                    "  \"ratio\" : 0.75, \"text\" : 1e3, \"on\" : true, \"none\" : null,\n"
+                    "  \"tags\" : [1, 2], \"inner\" : { \"a\" : 1 } } }";
+        auto conf = config::parse_string(text, config_parse_options().set_syntax(syntax));
+        auto server = dynamic_pointer_cast<const simple_config_object>(conf->get_object("server"));
+        REQUIRE(server);
+        REQUIRE(server->packed());
+        REQUIRE(9u == server->size());
+        REQUIRE_FALSE(server->is_empty());
+
+        // Fields are created once the object is read, as they were parsed
+        REQUIRE("example.com" == conf->get_string("server.host"));
+        REQUIRE_FALSE(server->packed());
+        REQUIRE(dynamic_pointer_cast<const config_string>(conf->get_value("server.host"))->was_quoted());
+        REQUIRE(8080 == conf->get_int("server.port"));
+        REQUIRE(3000000000 == conf->get_long("server.big"));
+        REQUIRE(0.75 == conf->get_double("server.ratio"));
+        REQUIRE(1000 == conf->get_int("server.text"));
+        REQUIRE("1e3" == conf->get_value("server.text")->render(config_render_options::concise()));
+        REQUIRE(conf->get_bool("server.on"));
+        REQUIRE(conf->get_is_null("server.none"));
+        REQUIRE((vector<int> { 1, 2 }) == conf->get_int_list("server.tags"));
+        REQUIRE(1 == conf->get_int("server.inner.a"));
+        REQUIRE(2 == conf->get_value("server.ratio")->origin()->line_number());
+        REQUIRE(conf->get_value("server.port") == conf->get_value("server.port"));
+
+        auto again = config::parse_string(text, config_parse_options().set_syntax(syntax));
+        REQUIRE(*conf->root() == *again->root());
+        REQUIRE(conf->root()->hash_code() == again->root()->hash_code());
+    }
+
+    auto conf = config::parse_string("a { b = plain, c = \"quoted\" }");
+    REQUIRE_FALSE(dynamic_pointer_cast<const config_string>(conf->get_value("a.b"))->was_quoted());
+    REQUIRE(dynamic_pointer_cast<const config_string>(conf->get_value("a.c"))->was_quoted());
+    REQUIRE("{\"a\":{\"b\":\"plain\",\"c\":\"quoted\"}}" == conf->root()->render(config_render_options::concise()));
+
+    // Objects without scalar fields aren't packed
+    auto nested = dynamic_pointer_cast<const simple_config_object>(
+        config::parse_string("a { b { c = 1 } }")->get_object("a"));
+    REQUIRE_FALSE(nested->packed());
+}
+
 TEST_CASE("correct exceptions should be thrown", "[config]") {
     SECTION("missing exception should be thrown when the value is not in the config") {
         bool thrown = false;
@@ -149,3 +396,92 @@ TEST_CASE("should correctly parse durations", "[config]") {
         REQUIRE_THROWS(conf->get_duration("durations.largeDays", time_unit::NANOSECONDS));
     }
 }
+
+TEST_CASE("should parse an empty file", "[config]") {
+    // Small files are read rather than memory mapped
+    auto conf = config::parse_file_any_syntax(TEST_FILE_DIR + string("/fixtures/empty.conf"))->resolve();
+    REQUIRE(conf->root()->is_empty());
+}
+
+TEST_CASE("files are parsed the same whether they are mapped or read", "[config]") {
+    namespace fs = boost::filesystem;
+    struct scratch_file {
+        ~scratch_file() {
+            boost::system::error_code ignored;
+            fs::remove(path, ignored);
+        }
+        // A name that isn't ASCII, which has to be opened by its wide name on Windows
+        string path = (fs::temp_directory_path() / fs::unique_path("hocon-\xc3\xa9t\xc3\xa9-%%%%-%%%%.conf")).string();
+    } file;
+
+    auto write = [&](string const& text) {
+        boost::nowide::ofstream out(file.path.c_str(), ios::binary);
+        out << text;
+    };
+
+    string small = "a = 1\nb = \"caf\xc3\xa9\"\n";
+    write(small);
+    REQUIRE(*config::parse_string(small) == *config::parse_file_any_syntax(file.path));
+
+    // Well past the size where files are mapped
+    string large;
+    for (int i = 0; i < 10000; ++i) {
+        large += "key" + to_string(i) + " = \"value " + to_string(i) + "\"\n";
+    }
+    write(large);
+    auto conf = config::parse_file_any_syntax(file.path);
+    REQUIRE(*config::parse_string(large) == *conf);
+    REQUIRE("value 9999" == conf->get_string("key9999"));
+}
+
+TEST_CASE("configs compare by content and can be deduplicated", "[config]") {
+    string text = "defaults { timeout : 30, hosts : [\"a\", \"b\"] }\n"
+                  "web : ${defaults} { port : 80 }\n"
+                  "db : ${defaults} { port : 5432 }\n"
+                  "cache { timeout : 30, hosts : [\"a\", \"b\"] }";
+    auto conf = config::parse_string(text)->resolve();
+    REQUIRE(*conf == *config::parse_string(text)->resolve());
+    REQUIRE_FALSE(*conf == *conf->with_value("web.port", config_value_factory::from_any_ref(81)));
+
+    auto deduplicated = conf->deduplicated();
+    REQUIRE(*conf == *deduplicated);
+    REQUIRE(deduplicated->get_value("defaults") == deduplicated->get_value("cache"));
+    REQUIRE(deduplicated->get_value("web.hosts") == deduplicated->get_value("db.hosts"));
+    REQUIRE(deduplicated->get_value("web.timeout") == deduplicated->get_value("cache.timeout"));
+    REQUIRE(80 == deduplicated->get_int("web.port"));
+    REQUIRE(5432 == deduplicated->get_int("db.port"));
+
+    REQUIRE_THROWS_AS(config::parse_string(text)->deduplicated(), config_exception);
+
+    SECTION("values written differently stay apart") {
+        string written = "a : 1, b : 1.0, c : 1, o1 { x : 1 }, o2 { x : 1.0 }, "
+                         "l1 : [1, 2], l2 : [1.0, 2], s1 : \"yes\", s2 : yes";
+        auto original = config::parse_string(written)->resolve();
+        auto shared = original->deduplicated();
+        for (auto const& p : { "a", "b", "c", "o1.x", "o2.x", "s1", "s2" }) {
+            REQUIRE(original->get_string(p) == shared->get_string(p));
+        }
+        REQUIRE(original->root()->render() == shared->root()->render());
+        REQUIRE(shared->get_value("a") == shared->get_value("c"));
+        REQUIRE_FALSE(shared->get_value("a") == shared->get_value("b"));
+        REQUIRE_FALSE(shared->get_value("o1") == shared->get_value("o2"));
+        REQUIRE_FALSE(shared->get_value("l1") == shared->get_value("l2"));
+        REQUIRE_FALSE(shared->get_value("s1") == shared->get_value("s2"));
+    }
+}
+
+TEST_CASE("with_value sets nested paths inside existing objects", "[config]") {
+    auto conf = config::parse_string("db { host : localhost, port : 5432 }, name : app");
+    auto updated = conf->with_value("db.host", config_value_factory::from_any_ref(string("db.example")));
+    REQUIRE("db.example" == updated->get_string("db.host"));
+    REQUIRE(5432 == updated->get_int("db.port"));
+    REQUIRE("app" == updated->get_string("name"));
+    REQUIRE_FALSE(updated->has_path("host"));
+
+    auto added = conf->with_value("db.pool.size", config_value_factory::from_any_ref(4));
+    REQUIRE(4 == added->get_int("db.pool.size"));
+    REQUIRE("localhost" == added->get_string("db.host"));
+
+    auto replaced = conf->with_value("name.first", config_value_factory::from_any_ref(1));
+    REQUIRE(1 == replaced->get_int("name.first"));
+}
@@ -1,7 +1,11 @@
 #include <catch.hpp>
 
+#include <hocon/config.hpp>
 #include <internal/values/simple_config_object.hpp>
 #include <internal/values/simple_config_list.hpp>
+#include <internal/config_util.hpp>
+#include <internal/symbol_table.hpp>
+#include <cmath>
 
 #include "test_utils.hpp"
 
@@ -18,6 +22,19 @@ TEST_CASE("simple_config_origin equality", "[config_values]") {
         REQUIRE(org1 == org2);
         REQUIRE(org1 != org3);
     }
+
+    SECTION("origins derived from another keep its description and comments") {
+        auto base = make_shared<simple_config_origin>("file: foo.conf", 1, 1, origin_type::FILE);
+        auto commented = base->with_comments({ "a comment" });
+        auto line = commented->with_line_number(7);
+
+        REQUIRE("file: foo.conf" == line->description());
+        REQUIRE(7 == line->line_number());
+        REQUIRE(vector<string> { "a comment" } == line->comments());
+        REQUIRE(base->comments().empty());
+        REQUIRE(*dynamic_pointer_cast<const simple_config_origin>(line) ==
+                simple_config_origin("file: foo.conf", 7, 7, origin_type::FILE, "", { "a comment" }));
+    }
 }
 
 TEST_CASE("config_number equality", "[config_values]") {
@@ -86,6 +103,67 @@ TEST_CASE("config numbers ints vs longs vs doubles", "[tokenizer]") {
     }
 }
 
+TEST_CASE("config numbers render as they were written", "[config_values]") {
+    for (string text : { "42", "-7", "2.0", "1e3", "007", "123456789012", "3.14", "-0.33", "1.",
+                         ".5", "2.50", "1e10", "3.14159265358979323846", "0.1",
+                         "0.0001", "0.00001", "-0.0", "123456789012345.5", "12345678901234.5", "00.5" }) {
+        double d = 0;
+        REQUIRE(parse_double(text, d));
+        auto num = config_number::new_number(fake_origin(), d, text);
+        REQUIRE(text == num->transform_to_string());
+        REQUIRE(text == num->with_origin(fake_origin("elsewhere"))->transform_to_string());
+    }
+
+    REQUIRE("5" == config_int(fake_origin(), 5, "").transform_to_string());
+    REQUIRE("2.500000" == config_double(fake_origin(), 2.5, "").transform_to_string());
+}
+
+TEST_CASE("parse numbers without exceptions", "[tokenizer]") {
+    SECTION("integers") {
+        int64_t l = 0;
+        REQUIRE(parse_int64("42", l));
+        REQUIRE(42 == l);
+        REQUIRE(parse_int64("-9223372036854775808", l));
+        REQUIRE(numeric_limits<int64_t>::min() == l);
+        REQUIRE(parse_int64("9223372036854775807", l));
+        REQUIRE(numeric_limits<int64_t>::max() == l);
+        REQUIRE_FALSE(parse_int64("9223372036854775808", l));
+        REQUIRE_FALSE(parse_int64("-9223372036854775809", l));
+        REQUIRE_FALSE(parse_int64("", l));
+        REQUIRE_FALSE(parse_int64("-", l));
+        REQUIRE_FALSE(parse_int64("1.0", l));
+        REQUIRE_FALSE(parse_int64("1-2", l));
+    }
+
+    SECTION("doubles") {
+        double d = 0;
+        REQUIRE(parse_double("42.1", d));
+        REQUIRE(42.1 == d);
+        REQUIRE(parse_double("-0.33", d));
+        REQUIRE(-0.33 == d);
+        REQUIRE(parse_double("1e10", d));
+        REQUIRE(1e10 == d);
+        REQUIRE(parse_double(".5", d));
+        REQUIRE(0.5 == d);
+        REQUIRE(parse_double("1.", d));
+        REQUIRE(1.0 == d);
+        // Too many digits or too large an exponent for the exact fast path
+        REQUIRE(parse_double("3.14159265358979323846", d));
+        REQUIRE(3.14159265358979323846 == d);
+        REQUIRE(parse_double("1.7976931348623157e308", d));
+        REQUIRE(1.7976931348623157e308 == d);
+        REQUIRE(parse_double("inf", d));
+        REQUIRE(std::isinf(d));
+        REQUIRE(parse_double("NaN", d));
+        REQUIRE(std::isnan(d));
+        REQUIRE_FALSE(parse_double("1e400", d));
+        REQUIRE_FALSE(parse_double("1e", d));
+        REQUIRE_FALSE(parse_double("1.2.3", d));
+        REQUIRE_FALSE(parse_double(".", d));
+        REQUIRE_FALSE(parse_double("e5", d));
+    }
+}
+
 TEST_CASE("config object unwraps") {
     auto value1 = config_int::new_number(fake_origin(), int64_t(1), "1");
     auto value2 = config_int::new_number(fake_origin(), int64_t(2), "2");
@@ -109,3 +187,270 @@ TEST_CASE("config list unwraps") {
     bool test = expected == list->unwrapped();
     REQUIRE(test);
 };
+
+TEST_CASE("persistent_map matches an unordered_map", "[config_values]") {
+    // Enough keys that hash fragments collide at several trie levels
+    unordered_map<string, shared_value> expected;
+    persistent_map map;
+    vector<persistent_map> versions;
+    vector<size_t> version_sizes;
+
+    for (int i = 0; i < 5000; ++i) {
+        auto key = "key" + to_string(i * 7919 % 6000);
+        auto value = config_int::new_number(fake_origin(), int64_t(i), to_string(i));
+        expected[key] = value;
+        map = map.set(key, value);
+        if (i % 3 == 0) {
+            auto removed = "key" + to_string(i * 31 % 6000);
+            expected.erase(removed);
+            map = map.erase(removed);
+        }
+        if (i % 500 == 0) {
+            versions.push_back(map);
+            version_sizes.push_back(map.size());
+        }
+    }
+
+    REQUIRE(expected.size() == map.size());
+    size_t visited = 0;
+    for (auto const& entry : map) {
+        ++visited;
+        REQUIRE(expected.count(entry.first) == 1);
+        REQUIRE(expected.at(entry.first) == entry.second);
+    }
+    REQUIRE(expected.size() == visited);
+
+    for (auto const& entry : expected) {
+        auto found = map.find(entry.first);
+        REQUIRE(found != map.end());
+        REQUIRE(entry.second == found->second);
+        REQUIRE(entry.second == map.at(entry.first));
+    }
+    REQUIRE(map.find("missing") == map.end());
+    REQUIRE(map.get("missing") == nullptr);
+    REQUIRE_THROWS_AS(map.at("missing"), out_of_range);
+
+    SECTION("finding by symbol matches finding by text") {
+        for (auto const& entry : expected) {
+            auto by_symbol = map.find(*symbol_table::unlisted(entry.first));
+            REQUIRE(by_symbol == map.find(entry.first));
+        }
+        REQUIRE(map.find(*symbol_table::intern(map.begin()->first)) == map.begin());
+        REQUIRE(map.find(*symbol_table::unlisted("missing")) == map.end());
+    }
+
+    SECTION("iterating from a found entry visits the rest of the map") {
+        auto found = map.find(map.begin()->first);
+        REQUIRE(found == map.begin());
+        REQUIRE(map.size() == static_cast<size_t>(distance(found, map.end())));
+    }
+
+    SECTION("earlier versions are unchanged by later updates") {
+        for (size_t i = 0; i < versions.size(); ++i) {
+            REQUIRE(version_sizes[i] == versions[i].size());
+            REQUIRE(version_sizes[i] == static_cast<size_t>(distance(versions[i].begin(), versions[i].end())));
+        }
+    }
+
+    SECTION("erasing every key leaves an empty map") {
+        auto shrinking = map;
+        for (auto const& entry : expected) {
+            shrinking = shrinking.erase(entry.first);
+        }
+        REQUIRE(shrinking.empty());
+        REQUIRE(shrinking.begin() == shrinking.end());
+        REQUIRE(expected.size() == map.size());
+    }
+
+    SECTION("building from an unordered_map gives the same entries") {
+        persistent_map built(expected);
+        REQUIRE(expected.size() == built.size());
+        REQUIRE(expected.size() == static_cast<size_t>(distance(built.begin(), built.end())));
+        for (auto const& entry : expected) {
+            REQUIRE(entry.second == built.get(entry.first));
+        }
+        auto updated = built.set("key1", nullptr).erase("key2");
+        REQUIRE(built.get("key1") == map.get("key1"));
+        REQUIRE(updated.get("key1") == nullptr);
+    }
+
+    SECTION("erasing a missing key or rebinding a key keeps the size") {
+        REQUIRE(map.size() == map.erase("missing").size());
+        auto rebound = map.set(map.begin()->first, nullptr);
+        REQUIRE(map.size() == rebound.size());
+        REQUIRE(rebound.get(map.begin()->first) == nullptr);
+    }
+
+    SECTION("differences between versions are the keys that changed") {
+        auto changed = map.set("key1", config_int::new_number(fake_origin(), int64_t(1), "1"))
+                          .erase(map.begin()->first).set("added", nullptr);
+        unordered_map<string, pair<shared_value, shared_value>> differences;
+        map.for_each_difference(changed, [&](string const& key, shared_value const& mine, shared_value const& theirs) {
+            differences.emplace(key, make_pair(mine, theirs));
+        });
+        REQUIRE(3u == differences.size());
+        REQUIRE(map.get("key1") == differences.at("key1").first);
+        REQUIRE(changed.get("key1") == differences.at("key1").second);
+        REQUIRE(map.begin()->second == differences.at(map.begin()->first).first);
+        REQUIRE(nullptr == differences.at(map.begin()->first).second);
+        REQUIRE(nullptr == differences.at("added").first);
+
+        size_t count = 0;
+        persistent_map(expected).for_each_difference(versions[3], [&](string const&, shared_value const& mine,
+                                                                       shared_value const& theirs) {
+            ++count;
+            REQUIRE(mine != theirs);
+        });
+        REQUIRE(count > 0u);
+        map.for_each_difference(map, [&](string const&, shared_value const&, shared_value const&) { FAIL(); });
+    }
+}
+
+TEST_CASE("config objects share entries between versions", "[config_values]") {
+    shared_object obj = simple_config_object::empty();
+    for (int i = 0; i < 1000; ++i) {
+        obj = obj->with_value("key" + to_string(i), config_int::new_number(fake_origin(), int64_t(i), to_string(i)));
+    }
+    REQUIRE(1000u == obj->size());
+
+    auto child = config_int::new_number(fake_origin(), int64_t(-1), "-1");
+    auto updated = obj->with_value("key5", child);
+    REQUIRE(1000u == updated->size());
+    REQUIRE(child == updated->get("key5"));
+    REQUIRE(child != obj->get("key5"));
+    REQUIRE(obj->get("key6") == updated->get("key6"));
+
+    SECTION("without_path keeps sibling keys") {
+        auto outer = simple_config_object::empty()->with_value("inner", child)->with_value("other", child);
+        auto nested = obj->with_value("outer", outer);
+        auto config = nested->to_config()->without_path("outer.inner");
+        REQUIRE_FALSE(config->has_path("outer.inner"));
+        REQUIRE(config->has_path("outer.other"));
+        REQUIRE(config->has_path("key999"));
+    }
+
+    SECTION("merging keeps keys from both objects") {
+        auto small = simple_config_object::empty()->with_value("key1", child)->with_value("extra", child);
+        auto merged = dynamic_pointer_cast<const config_object>(small->with_fallback(obj));
+        REQUIRE(1001u == merged->size());
+        REQUIRE(child == merged->get("key1"));
+        REQUIRE(obj->get("key2") == merged->get("key2"));
+
+        auto reversed = dynamic_pointer_cast<const config_object>(obj->with_fallback(small));
+        REQUIRE(1001u == reversed->size());
+        REQUIRE(obj->get("key1") == reversed->get("key1"));
+        REQUIRE(child == reversed->get("extra"));
+    }
+}
+
+TEST_CASE("config lists share elements with copies and concatenations", "[config_values]") {
+    vector<shared_value> data;
+    for (int i = 0; i < 3; ++i) {
+        data.push_back(config_int::new_number(fake_origin(), int64_t(i), to_string(i)));
+    }
+    auto list = make_shared<simple_config_list>(fake_origin(), data);
+
+    auto moved = dynamic_pointer_cast<const simple_config_list>(list->with_origin(fake_origin("elsewhere")));
+    REQUIRE(moved != list);
+    REQUIRE("elsewhere" == moved->origin()->description());
+    REQUIRE(&*moved->begin() == &*list->begin());
+
+    shared_ptr<const simple_config_list> joined = list;
+    for (int i = 3; i < 1000; ++i) {
+        vector<shared_value> tail { config_int::new_number(fake_origin(), int64_t(i), to_string(i)) };
+        joined = joined->concatenate(make_shared<simple_config_list>(fake_origin(), tail));
+    }
+    REQUIRE(1000u == joined->size());
+    REQUIRE(data[1] == joined->get(1));
+    int expected = 0;
+    for (auto const& v : *joined) {
+        REQUIRE(expected++ == boost::get<int>(v->unwrapped()));
+    }
+
+    auto empty = make_shared<simple_config_list>(fake_origin(), vector<shared_value>());
+    REQUIRE(&*list->concatenate(empty)->begin() == &*list->begin());
+    REQUIRE(3u == empty->concatenate(list)->size());
+
+    SECTION("a flattened concatenation lets go of the lists it joined") {
+        auto head = make_shared<simple_config_list>(fake_origin(), data);
+        auto tail = make_shared<simple_config_list>(fake_origin(), data);
+        weak_ptr<const simple_config_list> head_alive = head, tail_alive = tail;
+        auto both = head->concatenate(tail);
+        auto copy = dynamic_pointer_cast<const simple_config_list>(both->with_origin(fake_origin("copy")));
+        head.reset();
+        tail.reset();
+
+        REQUIRE(data[2] == both->get(5));
+        REQUIRE_FALSE(head_alive.expired());
+        REQUIRE(data[2] == copy->get(5));
+        REQUIRE(head_alive.expired());
+        REQUIRE(tail_alive.expired());
+
+        auto nested = both->concatenate(copy);
+        REQUIRE(12u == nested->size());
+        REQUIRE(data[1] == nested->get(10));
+    }
+}
+
+TEST_CASE("config values can be visited without unwrapping", "[config_values]") {
+    struct recorder : config_value_visitor {
+        void begin_object(size_t size) override { trace += "{" + to_string(size) + " "; }
+        void key(string const& name) override { trace += name + "="; }
+        void end_object() override { trace += "} "; }
+        void begin_list(size_t size) override { trace += "[" + to_string(size) + " "; }
+        void end_list() override { trace += "] "; }
+        void null_value() override { trace += "null "; }
+        void bool_value(bool value) override { trace += value ? "true " : "false "; }
+        void int_value(int value) override { trace += "i" + to_string(value) + " "; }
+        void long_value(int64_t value) override { trace += "l" + to_string(value) + " "; }
+        void double_value(double value) override { trace += "d" + to_string(value) + " "; }
+        void string_value(string const& value) override { trace += "'" + value + "' "; }
+        string trace;
+    };
+
+    auto conf = config::parse_string("a { b : [1, 3000000000, 2.5, true, null, \"s\", { c : [] }] }\n"
+                                      "packed : [1, 2.0, 0.5]")->resolve();
+    recorder r;
+    conf->get_value("a")->accept(r);
+    REQUIRE("{1 b=[7 i1 l3000000000 d2.500000 true null 's' {1 c=[0 ] } ] } " == r.trace);
+
+    r.trace.clear();
+    conf->get_value("packed")->accept(r);
+    REQUIRE("[3 i1 i2 d0.500000 ] " == r.trace);
+
+    struct int_summer : config_value_visitor {
+        void int_value(int value) override { total += value; }
+        int total = 0;
+    } summer;
+    conf->root()->accept(summer);
+    REQUIRE(4 == summer.total);
+
+    auto unresolved = config::parse_string("a : ${b}, b : 1")->root();
+    REQUIRE_THROWS_AS(unresolved->accept(summer), config_exception);
+}
+
+TEST_CASE("config values hash consistently with equality", "[config_values]") {
+    auto conf = config::parse_string("a : { x : 1, y : [1, 2.5], z : \"s\" }\n"
+                                      "b : { z : \"s\", y : [1, 2.5], x : 1 }\n"
+                                      "c : { x : 1, y : [1, 2.5], z : \"t\" }\n"
+                                      "d : { x : 1, w : [1, 2.5], z : \"s\" }")->resolve();
+    auto a = conf->get_value("a");
+    auto b = conf->get_value("b");
+    REQUIRE(a->hash_code() == b->hash_code());
+    REQUIRE(*a == *b);
+    REQUIRE_FALSE(a->hash_code() == conf->get_value("c")->hash_code());
+    REQUIRE_FALSE(*a == *conf->get_value("c"));
+    REQUIRE_FALSE(*a == *conf->get_value("d"));
+
+    // Packed and unpacked lists, and numbers of different classes, hash alike
+    vector<shared_value> elements { config_number::new_number(fake_origin(), int64_t(1), ""),
+                                    config_number::new_number(fake_origin(), 2.5, "") };
+    auto unpacked = make_shared<simple_config_list>(fake_origin(), elements);
+    REQUIRE(conf->get_list("a.y")->hash_code() == unpacked->hash_code());
+    REQUIRE(*conf->get_list("a.y") == *unpacked);
+    REQUIRE(make_shared<config_long>(fake_origin(), 7, "")->hash_code() ==
+            make_shared<config_int>(fake_origin(), 7, "")->hash_code());
+
+    REQUIRE_FALSE(config_string(fake_origin(), "1", config_string_type::QUOTED).hash_code() ==
+                  config_int(fake_origin(), 1, "").hash_code());
+}
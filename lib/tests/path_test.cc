@@ -1,6 +1,9 @@
 #include <catch.hpp>
 #include <hocon/path.hpp>
 #include <internal/path_parser.hpp>
+#include <internal/symbol_table.hpp>
+#include <internal/values/config_string.hpp>
+#include <internal/values/simple_config_object.hpp>
 #include "test_utils.hpp"
 
 using namespace hocon;
@@ -117,6 +120,32 @@ TEST_CASE("path starts with", "[path]") {
     REQUIRE_FALSE(full.starts_with(test_path({"not_in_full"})));
 }
 
+TEST_CASE("path slices", "[path]") {
+    path full = path::new_path("a.b.c.d");
+    REQUIRE(full.remainder() == test_path({"b", "c", "d"}));
+    REQUIRE(full.parent() == test_path({"a", "b", "c"}));
+    REQUIRE(full.sub_path(2) == test_path({"c", "d"}));
+    REQUIRE(full.sub_path(10) == test_path({"d"}));
+    REQUIRE(full.sub_path(1, 3) == test_path({"b", "c"}));
+    REQUIRE(full.sub_path(1, 1).empty());
+    REQUIRE_THROWS(full.sub_path(1, 4));
+    REQUIRE_THROWS(full.sub_path(2, 1));
+
+    REQUIRE(full.remainder().parent().render() == "b.c");
+    REQUIRE(*full.remainder().parent().last() == "c");
+    REQUIRE(full.remainder().remainder().remainder().length() == 1);
+    REQUIRE(full.remainder().remainder().remainder().remainder().empty());
+    REQUIRE(path().length() == 0);
+
+    SECTION("equal paths hash alike however they were built") {
+        REQUIRE(full.remainder().hash() == path::new_path("b.c.d").hash());
+        REQUIRE(full.sub_path(1, 3).hash() == test_path({"b", "c"}).hash());
+        REQUIRE(full.parent().hash() == path::new_path("c").prepend(path::new_path("a.b")).hash());
+        REQUIRE(full.hash() != path::new_path("a.b.d.c").hash());
+        REQUIRE(path().hash() == path().hash());
+    }
+}
+
 TEST_CASE("invalid paths throw excpetions") {
     REQUIRE_THROWS(path::new_path(""));
     REQUIRE_THROWS(path::new_path(".."));
@@ -127,3 +156,38 @@ TEST_CASE("can detect weird characters", "[path]") {
     REQUIRE(path::has_funky_chars("foo*"));
     REQUIRE_FALSE(path::has_funky_chars("foo"));
 }
+
+TEST_CASE("object keys are interned", "[path]") {
+    auto value = make_shared<config_string>(fake_origin(), "example.com", config_string_type::QUOTED);
+    auto first = simple_config_object::empty()->with_value("host", value);
+    auto second = simple_config_object::empty()->with_value(string("host"), value);
+    REQUIRE(&first->begin()->first == &second->begin()->first);
+
+    auto host = symbol_table::intern("host");
+    REQUIRE(host == symbol_table::intern(string("ho") + "st"));
+    REQUIRE(hash<string>()("host") == host->hash);
+    REQUIRE(&first->begin()->first == &host->text);
+
+    // Path elements aren't looked up in the table, and compare by text
+    auto a = path::new_path("server.host");
+    auto b = test_path({ "server", "host" });
+    REQUIRE(a == b);
+    REQUIRE(a.last().get() != &host->text);
+    REQUIRE(*a.last() == host->text);
+    REQUIRE(a.first().get() != b.first().get());
+    REQUIRE(*a.first() == *b.first());
+    REQUIRE(a.starts_with(path::new_key("server")));
+}
+
+TEST_CASE("symbols are released with the keys that use them", "[path]") {
+    auto size = symbol_table::size();
+    {
+        auto looked_up = path::new_path("never.a.key.anywhere");
+        REQUIRE(size == symbol_table::size());
+
+        auto value = make_shared<config_string>(fake_origin(), "v", config_string_type::QUOTED);
+        auto object = simple_config_object::empty()->with_value("only-in-this-object", value);
+        REQUIRE(size + 1 == symbol_table::size());
+    }
+    REQUIRE(size == symbol_table::size());
+}
@@ -5,6 +5,7 @@
 #include "fixtures.hpp"
 
 #include <boost/algorithm/string/replace.hpp>
+#include <leatherman/util/environment.hpp>
 
 using namespace std;
 
@@ -449,4 +450,16 @@ namespace hocon { namespace test_utils {
     std::string fixture_path(std::string const& fixture_name) {
         return string(TEST_FILE_DIR) + "/fixtures/" + fixture_name;
     }
+
+    scoped_env_var::scoped_env_var(string name_value, string const& value) : name(move(name_value)) {
+        set(value);
+    }
+
+    scoped_env_var::~scoped_env_var() {
+        leatherman::util::environment::clear(name);
+    }
+
+    void scoped_env_var::set(string const& value) const {
+        leatherman::util::environment::set(name, value);
+    }
 }}  // namespace hocon::test_utils
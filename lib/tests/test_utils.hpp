@@ -137,4 +137,16 @@ namespace hocon { namespace test_utils {
     std::vector<parse_test> whitespace_variations(std::vector<parse_test> const& tests, bool valid_in_lift);
 
     std::string fixture_path(std::string const& fixture_name);
+
+    /** Sets an environment variable, clearing it again when the guard goes out of scope. */
+    struct scoped_env_var {
+        scoped_env_var(std::string name, std::string const& value);
+        ~scoped_env_var();
+        void set(std::string const& value) const;
+
+        scoped_env_var(scoped_env_var const&) = delete;
+        scoped_env_var& operator=(scoped_env_var const&) = delete;
+
+        std::string name;
+    };
 }}  // namespace hocon::test_utils
@@ -7,8 +7,7 @@ using namespace std;
 using namespace hocon;
 using namespace hocon::test_utils;
 
-token_list tokenize_as_list(string const& source) {
-    token_iterator iter(fake_origin(), unique_ptr<istringstream>(new istringstream(source)), true);
+token_list drain(token_iterator& iter) {
     // get all the tokens from the string and put them in a vector
     token_list tokens;
     while (iter.has_next()) {
@@ -17,15 +16,28 @@ token_list tokenize_as_list(string const& source) {
     return tokens;
 }
 
+token_list tokenize_as_list(string const& source) {
+    token_iterator iter(fake_origin(), unique_ptr<istringstream>(new istringstream(source)), true);
+    return drain(iter);
+}
+
+token_list tokenize_buffer_as_list(string const& source) {
+    token_iterator iter(fake_origin(), make_shared<input_buffer>(source.data(), source.data() + source.size()), true);
+    return drain(iter);
+}
+
 void tokenizer_test(string const& source, token_list expected) {
-    token_list result = tokenize_as_list(source);
-    for (size_t i = 0; i < expected.size(); i++) {
-        if (!(*expected[i] == *result[i])) {
-            // Debugging info
-            cerr << result[i]->to_string() << " but expected " << expected[i]->to_string() << " -- ";
-            cerr << "i = " + std::to_string(i);
+    // The stream and in-place buffer inputs must produce identical tokens
+    for (auto result : { tokenize_as_list(source), tokenize_buffer_as_list(source) }) {
+        REQUIRE(expected.size() <= result.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            if (!(*expected[i] == *result[i])) {
+                // Debugging info
+                cerr << result[i]->to_string() << " but expected " << expected[i]->to_string() << " -- ";
+                cerr << "i = " + std::to_string(i);
+            }
+            REQUIRE(*expected[i] == *result[i]);
         }
-        REQUIRE(*expected[i] == *result[i]);
     }
 }
 
@@ -305,6 +317,27 @@ TEST_CASE("unquoted strings with special cases", "[tokenizer]") {
         tokenizer_test(source, expected);
     }
 
+    SECTION("long unquoted text, whitespace and comments") {
+        // Longer than a block of the bulk scanners, with stop characters at varying offsets
+        string source = "                    a.long-unquoted/value_with_no_stops_for_a_while/end   "
+                        "tail//comment that runs past a whole scanning block\n"
+                        "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\tkey_that_is_longer_than_sixteen:";
+        token_list expected {
+                tokens::start_token(),
+                whitespace_token("                    "),
+                unquoted_text_token("a.long-unquoted/value_with_no_stops_for_a_while/end"),
+                unquoted_text_token("   "),
+                unquoted_text_token("tail"),
+                double_slash_comment_token("comment that runs past a whole scanning block"),
+                line_token(1),
+                whitespace_token("\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"),
+                unquoted_text_token("key_that_is_longer_than_sixteen"),
+                tokens::colon_token(),
+                tokens::end_token()
+        };
+        tokenizer_test(source, expected);
+    }
+
     SECTION("mix quoted and unquoted") {
         string source = "   foo\"bar\"baz   \n";
         token_list expected {
@@ -381,6 +414,16 @@ TEST_CASE("escape sequence", "[tokenizer]") {
     }
 }
 
+TEST_CASE("quoted strings keep UTF-8 text", "[tokenizer]") {
+    string source = u8"\"caf\u00E9 \u221E\"";
+    token_list expected {
+            tokens::start_token(),
+            string_token(u8"caf\u00E9 \u221E"),
+            tokens::end_token()
+    };
+    tokenizer_test(source, expected);
+}
+
 TEST_CASE("triple quoted strings") {
     SECTION("trivial triple quoted string") {
         string source = "\"\"\"bar\"\"\"";
@@ -648,47 +691,77 @@ void test_for_config_error(string source) {
     }
 }
 
+void test_buffer_for_config_error(string source) {
+    tokenize_buffer_as_list(source);
+}
+
 TEST_CASE("catch syntax erros", "[tokenizer]") {
     SECTION("nothing after backslash") {
         string source = " \"\\\" ";
         REQUIRE_THROWS(test_for_config_error(source));
+        REQUIRE_THROWS(test_buffer_for_config_error(source));
     }
 
     SECTION("\\q is not a valid escape sequence") {
         string source = " \"\\q\" ";
         REQUIRE_THROWS(test_for_config_error(source));
+        REQUIRE_THROWS(test_buffer_for_config_error(source));
     }
 
     SECTION("unicode byte sequence missing bytes") {
         string source = " \"\\u012\" ";
         REQUIRE_THROWS(test_for_config_error(source));
+        REQUIRE_THROWS(test_buffer_for_config_error(source));
 
         source = " \"\\u01\" ";
         REQUIRE_THROWS(test_for_config_error(source));
+        REQUIRE_THROWS(test_buffer_for_config_error(source));
 
         source = " \"\\u1\" ";
         REQUIRE_THROWS(test_for_config_error(source));
+        REQUIRE_THROWS(test_buffer_for_config_error(source));
 
         source = " \"\\u\" ";
         REQUIRE_THROWS(test_for_config_error(source));
+        REQUIRE_THROWS(test_buffer_for_config_error(source));
     }
 
     SECTION("missing closing quotes") {
         string source = "\"";
         REQUIRE_THROWS(test_for_config_error(source));
+        REQUIRE_THROWS(test_buffer_for_config_error(source));
 
         source = "\"abc";
         REQUIRE_THROWS(test_for_config_error(source));
+        REQUIRE_THROWS(test_buffer_for_config_error(source));
     }
 
     SECTION("invalid lone characters") {
         string source = "\"\\\"";
         REQUIRE_THROWS(test_for_config_error(source));
+        REQUIRE_THROWS(test_buffer_for_config_error(source));
 
         source = "$";
         REQUIRE_THROWS(test_for_config_error(source));
+        REQUIRE_THROWS(test_buffer_for_config_error(source));
 
         source = "${";
         REQUIRE_THROWS(test_for_config_error(source));
+        REQUIRE_THROWS(test_buffer_for_config_error(source));
+    }
+}
+
+TEST_CASE("tokenize input spanning several stream reads", "[tokenizer]") {
+    // Long enough that tokens straddle the boundaries between chunks read from the stream
+    string source;
+    for (int i = 0; i < 20000; i++) {
+        source += "key" + std::to_string(i) + " : \"value\" // comment\n";
+    }
+    token_list from_stream = tokenize_as_list(source);
+    token_list from_buffer = tokenize_buffer_as_list(source);
+    REQUIRE(from_stream.size() == from_buffer.size());
+    for (size_t i = 0; i < from_stream.size(); i++) {
+        REQUIRE(*from_stream[i] == *from_buffer[i]);
     }
+    REQUIRE(token_iterator::render(from_stream) == source);
 }